@@ -0,0 +1,114 @@
+/******************************************************************************
+* Copyright (C) 2024 Charlie
+* Failing stand-ins for the RFDC, RF clock and libmetal driver calls
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+// Linked only into the host-simulation build (RFDC_HOST_SIM). The simulated
+// backend never calls the driver; reaching one of these means the hardware
+// backend was selected on a host, and every call fails the way a missing
+// device would.
+
+#include <xrfdc.h>
+#include <xrfclk.h>
+#include <metal/sys.h>
+#include <cstdio>
+
+namespace {
+
+u32 no_driver(const char* name)
+{
+    std::fprintf(stderr, "%s: no RFDC driver in a host-simulation build (use --sim)\n", name);
+    return XRFDC_FAILURE;
+}
+
+} // namespace
+
+extern "C" {
+
+int metal_init(const struct metal_init_params*) { return -1; }
+void metal_finish(void) {}
+
+XRFdc_Config* XRFdc_LookupConfig(u16) { no_driver(__func__); return nullptr; }
+u32 XRFdc_RegisterMetal(XRFdc*, u16, struct metal_device**) { return no_driver(__func__); }
+u32 XRFdc_CfgInitialize(XRFdc*, XRFdc_Config*) { return no_driver(__func__); }
+double XRFdc_GetDriverVersion(void) { return 0.0; }
+void XRFdc_DumpRegs(XRFdc*, u32, int) { no_driver(__func__); }
+
+u32 XRFdc_StartUp(XRFdc*, u32, int) { return no_driver(__func__); }
+u32 XRFdc_Shutdown(XRFdc*, u32, int) { return no_driver(__func__); }
+u32 XRFdc_Reset(XRFdc*, u32, int) { return no_driver(__func__); }
+u32 XRFdc_GetIPStatus(XRFdc*, XRFdc_IPStatus*) { return no_driver(__func__); }
+u32 XRFdc_GetBlockStatus(XRFdc*, u32, u32, u32, XRFdc_BlockStatus*) { return no_driver(__func__); }
+u32 XRFdc_CheckTileEnabled(XRFdc*, u32, u32) { return XRFDC_FAILURE; }
+u32 XRFdc_CheckBlockEnabled(XRFdc*, u32, u32, u32) { return XRFDC_FAILURE; }
+u32 XRFdc_CheckDigitalPathEnabled(XRFdc*, u32, u32, u32) { return XRFDC_FAILURE; }
+u32 XRFdc_IsADCDigitalPathEnabled(XRFdc*, u32, u32) { return 0; }
+u32 XRFdc_IsDACDigitalPathEnabled(XRFdc*, u32, u32) { return 0; }
+u32 XRFdc_IsHighSpeedADC(XRFdc*, int) { return 0; }
+u32 XRFdc_GetDataType(XRFdc*, u32, u32, u32) { return XRFDC_DATA_TYPE_REAL; }
+
+u32 XRFdc_DynamicPLLConfig(XRFdc*, u32, u32, u8, double, double) { return no_driver(__func__); }
+u32 XRFdc_GetPLLConfig(XRFdc*, u32, u32, XRFdc_PLL_Settings*) { return no_driver(__func__); }
+u32 XRFdc_GetPLLLockStatus(XRFdc*, u32, u32, u32*) { return no_driver(__func__); }
+
+u32 XRFdc_SetMixerSettings(XRFdc*, u32, u32, u32, XRFdc_Mixer_Settings*) { return no_driver(__func__); }
+u32 XRFdc_GetMixerSettings(XRFdc*, u32, u32, u32, XRFdc_Mixer_Settings*) { return no_driver(__func__); }
+u32 XRFdc_ResetNCOPhase(XRFdc*, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_UpdateEvent(XRFdc*, u32, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_SetQMCSettings(XRFdc*, u32, u32, u32, XRFdc_QMC_Settings*) { return no_driver(__func__); }
+u32 XRFdc_GetQMCSettings(XRFdc*, u32, u32, u32, XRFdc_QMC_Settings*) { return no_driver(__func__); }
+u32 XRFdc_SetNyquistZone(XRFdc*, u32, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetNyquistZone(XRFdc*, u32, u32, u32, u32*) { return no_driver(__func__); }
+
+u32 XRFdc_SetInterpolationFactor(XRFdc*, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetInterpolationFactor(XRFdc*, u32, u32, u32*) { return no_driver(__func__); }
+u32 XRFdc_SetDecimationFactor(XRFdc*, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetDecimationFactor(XRFdc*, u32, u32, u32*) { return no_driver(__func__); }
+u32 XRFdc_SetDataPathMode(XRFdc*, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetDataPathMode(XRFdc*, u32, u32, u32*) { return no_driver(__func__); }
+u32 XRFdc_SetIMRPassMode(XRFdc*, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetIMRPassMode(XRFdc*, u32, u32, u32*) { return no_driver(__func__); }
+
+u32 XRFdc_SetupFIFO(XRFdc*, u32, int, u8) { return no_driver(__func__); }
+u32 XRFdc_GetFIFOStatus(XRFdc*, u32, u32, u8*) { return no_driver(__func__); }
+u32 XRFdc_SetFabClkOutDiv(XRFdc*, u32, u32, u16) { return no_driver(__func__); }
+u32 XRFdc_GetFabClkOutDiv(XRFdc*, u32, u32, u16*) { return no_driver(__func__); }
+double XRFdc_GetFabClkFreq(XRFdc*, u32, u32) { return 0.0; }
+u32 XRFdc_GetFabRdVldWords(XRFdc*, u32, u32, u32, u32*) { return no_driver(__func__); }
+u32 XRFdc_GetFabWrVldWords(XRFdc*, u32, u32, u32, u32*) { return no_driver(__func__); }
+
+u32 XRFdc_SetThresholdSettings(XRFdc*, u32, u32, XRFdc_Threshold_Settings*) { return no_driver(__func__); }
+u32 XRFdc_GetThresholdSettings(XRFdc*, u32, u32, XRFdc_Threshold_Settings*) { return no_driver(__func__); }
+u32 XRFdc_SetCalibrationMode(XRFdc*, u32, u32, u8) { return no_driver(__func__); }
+u32 XRFdc_GetCalibrationMode(XRFdc*, u32, u32, u8*) { return no_driver(__func__); }
+u32 XRFdc_SetDecoderMode(XRFdc*, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetDecoderMode(XRFdc*, u32, u32, u32*) { return no_driver(__func__); }
+u32 XRFdc_SetInvSincFIR(XRFdc*, u32, u32, u16) { return no_driver(__func__); }
+u32 XRFdc_GetInvSincFIR(XRFdc*, u32, u32, u16*) { return no_driver(__func__); }
+
+u32 XRFdc_IntrEnable(XRFdc*, u32, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_IntrDisable(XRFdc*, u32, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_IntrClr(XRFdc*, u32, u32, u32, u32) { return no_driver(__func__); }
+u32 XRFdc_GetIntrStatus(XRFdc*, u32, u32, u32, u32*) { return no_driver(__func__); }
+
+void XRFdc_MultiConverter_Init(XRFdc_MultiConverter_Sync_Config*, int*, int*, u32) {}
+u32 XRFdc_MultiConverter_Sync(XRFdc*, u32, XRFdc_MultiConverter_Sync_Config*) { return XRFDC_MTS_NOT_SUPPORTED; }
+u32 XRFdc_MTS_Sysref_Config(XRFdc*, XRFdc_MultiConverter_Sync_Config*, XRFdc_MultiConverter_Sync_Config*, u32)
+{
+    return no_driver(__func__);
+}
+
+u32 XRFClk_Init(int) { return no_driver(__func__); }
+void XRFClk_Close(void) {}
+u32 XRFClk_ResetChip(u32) { return no_driver(__func__); }
+u32 XRFClk_WriteReg(u32, u32) { return no_driver(__func__); }
+u32 XRFClk_ReadReg(u32, u32*) { return no_driver(__func__); }
+u32 XRFClk_SetConfigOnOneChipFromConfigId(u32, u32) { return no_driver(__func__); }
+u32 XRFClk_SetConfigOnOneChip(u32, u32*, u32) { return no_driver(__func__); }
+u32 XRFClk_GetConfigFromOneChip(u32, u32*) { return no_driver(__func__); }
+u32 XRFClk_SetConfigOnAllChipsFromConfigId(u32, u32, u32) { return no_driver(__func__); }
+u32 XRFClk_ControlOutputPortLMK(u32, u32) { return no_driver(__func__); }
+u32 XRFClk_ConfigOutputDividerAndMUXOnLMK(u32, u32, u32, u32, u32) { return no_driver(__func__); }
+
+} // extern "C"
@@ -0,0 +1,41 @@
+/******************************************************************************
+* Copyright (C) 2024 Charlie
+* Host-simulation stand-in for libmetal's metal/sys.h
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+#ifndef RFDC_HOST_SIM_METAL_SYS_H
+#define RFDC_HOST_SIM_METAL_SYS_H
+
+struct metal_device;
+
+enum metal_log_level {
+    METAL_LOG_EMERGENCY,
+    METAL_LOG_ALERT,
+    METAL_LOG_CRITICAL,
+    METAL_LOG_ERROR,
+    METAL_LOG_WARNING,
+    METAL_LOG_NOTICE,
+    METAL_LOG_INFO,
+    METAL_LOG_DEBUG,
+};
+
+typedef void (*metal_log_handler)(enum metal_log_level level, const char* format, ...);
+
+struct metal_init_params {
+    metal_log_handler log_handler;
+    enum metal_log_level log_level;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int metal_init(const struct metal_init_params* params);
+void metal_finish(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RFDC_HOST_SIM_METAL_SYS_H
@@ -0,0 +1,53 @@
+/******************************************************************************
+* Copyright (C) 2024 Charlie
+* Host-simulation stand-in for the Xilinx RF clock driver header (xrfclk.h)
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Constants and prototypes only; see xrfdc.h in this directory.
+ */
+#ifndef RFDC_HOST_SIM_XRFCLK_H
+#define RFDC_HOST_SIM_XRFCLK_H
+
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint32_t u32;
+
+#define RFCLK_VERSION "1.0 (host simulation)"
+
+#define RFCLK_LMK 0
+#define RFCLK_LMX2594_1 1
+#define RFCLK_LMX2594_2 2
+#define RFCLK_LMX2594_3 3
+
+#define LMK_FREQ_NUM 3
+#define LMX_ADC_NUM 11
+#define LMX_DAC_NUM 11
+
+#define XST_SUCCESS 0L
+#define XST_FAILURE 1L
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+u32 XRFClk_Init(int GpioId);
+void XRFClk_Close(void);
+u32 XRFClk_ResetChip(u32 ChipId);
+u32 XRFClk_WriteReg(u32 ChipId, u32 Data);
+u32 XRFClk_ReadReg(u32 ChipId, u32* DataVal);
+u32 XRFClk_SetConfigOnOneChipFromConfigId(u32 ChipId, u32 ConfigId);
+u32 XRFClk_SetConfigOnOneChip(u32 ChipId, u32* cfgData, u32 len);
+u32 XRFClk_GetConfigFromOneChip(u32 ChipId, u32* cfgData);
+u32 XRFClk_SetConfigOnAllChipsFromConfigId(u32 ConfigId_LMK, u32 ConfigId_RF1, u32 ConfigId_RF2);
+u32 XRFClk_ControlOutputPortLMK(u32 PortId, u32 State);
+u32 XRFClk_ConfigOutputDividerAndMUXOnLMK(u32 PortId, u32 DCLKoutX_DIV, u32 DCLKoutX_MUX,
+                                          u32 SDCLKoutY_MUX, u32 SYSREF_DIV);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RFDC_HOST_SIM_XRFCLK_H
@@ -0,0 +1,295 @@
+/******************************************************************************
+* Copyright (C) 2024 Charlie
+* Host-simulation stand-in for the Xilinx RFDC driver header (xrfdc.h)
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Only what the application uses: the constants, the settings structs the
+ * wrapper hands around, and the driver prototypes. Struct layouts are not
+ * the driver's. Every function in DriverStubs.cpp fails; a host-sim build
+ * runs on the simulated backend (RFDC forwards to SimRfdc), so none of them
+ * is reached unless the hardware backend is forced.
+ */
+#ifndef RFDC_HOST_SIM_XRFDC_H
+#define RFDC_HOST_SIM_XRFDC_H
+
+#include <stdint.h>
+#include <metal/sys.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define XRFDC_SUCCESS 0U
+#define XRFDC_FAILURE 1U
+
+#define XRFDC_ADC_TILE 0U
+#define XRFDC_DAC_TILE 1U
+#define XRFDC_GEN3 2
+
+#define XRFDC_EXTERNAL_CLK 0x0U
+#define XRFDC_INTERNAL_PLL_CLK 0x1U
+#define XRFDC_PLL_UNLOCKED 0x1U
+#define XRFDC_PLL_LOCKED 0x2U
+
+#define XRFDC_MIXER_MODE_OFF 0x0U
+#define XRFDC_MIXER_MODE_C2C 0x1U
+#define XRFDC_MIXER_MODE_C2R 0x2U
+#define XRFDC_MIXER_MODE_R2C 0x3U
+#define XRFDC_MIXER_MODE_R2R 0x4U
+
+#define XRFDC_MIXER_TYPE_OFF 0x0U
+#define XRFDC_MIXER_TYPE_COARSE 0x1U
+#define XRFDC_MIXER_TYPE_FINE 0x2U
+#define XRFDC_MIXER_TYPE_DISABLED 0x3U
+
+#define XRFDC_COARSE_MIX_OFF 0x0U
+#define XRFDC_COARSE_MIX_SAMPLE_FREQ_BY_TWO 0x2U
+#define XRFDC_COARSE_MIX_SAMPLE_FREQ_BY_FOUR 0x4U
+#define XRFDC_COARSE_MIX_MIN_SAMPLE_FREQ_BY_FOUR 0x8U
+#define XRFDC_COARSE_MIX_BYPASS 0x10U
+
+#define XRFDC_EVNT_SRC_IMMEDIATE 0x00000000U
+#define XRFDC_EVNT_SRC_SLICE 0x00000001U
+#define XRFDC_EVNT_SRC_TILE 0x00000002U
+#define XRFDC_EVNT_SRC_SYSREF 0x00000003U
+#define XRFDC_EVNT_SRC_MARKER 0x00000004U
+#define XRFDC_EVNT_SRC_PL 0x00000005U
+
+#define XRFDC_EVENT_MIXER 0x1U
+#define XRFDC_EVENT_CRSE_DLY 0x2U
+#define XRFDC_EVENT_QMC 0x4U
+
+#define XRFDC_DATA_TYPE_REAL 0x00000000U
+#define XRFDC_DATA_TYPE_IQ 0x00000001U
+
+#define XRFDC_TRSHD_OFF 0x0U
+#define XRFDC_TRSHD_STICKY_OVER 0x00000001U
+#define XRFDC_TRSHD_STICKY_UNDER 0x00000002U
+#define XRFDC_TRSHD_HYSTERISIS 0x00000003U
+
+#define XRFDC_DAC_MODE_7G_NQ1 0U
+#define XRFDC_DAC_MODE_7G_NQ2 1U
+#define XRFDC_DAC_MODE_10G_IMR 2U
+#define XRFDC_DAC_MODE_10G_BYPASS 3U
+
+#define XRFDC_DATAPATH_MODE_DUC_0_FSDIVTWO 1U
+#define XRFDC_DATAPATH_MODE_DUC_0_FSDIVFOUR 2U
+#define XRFDC_DATAPATH_MODE_FSDIVFOUR_FSDIVTWO 3U
+#define XRFDC_DATAPATH_MODE_NODUC_0_FSDIVTWO 4U
+
+#define XRFDC_IXR_FIFOUSRDAT_MASK 0x0000000FU
+#define XRFDC_IXR_FIFOUSRDAT_OF_MASK 0x00000001U
+#define XRFDC_IXR_FIFOUSRDAT_UF_MASK 0x00000002U
+#define XRFDC_DAC_IXR_FIFOUSRDAT_MASK 0x0000000FU
+#define XRFDC_ADC_IXR_DMON_STG_MASK 0x000003F0U
+#define XRFDC_DAC_IXR_INTP_STG_MASK 0x000003F0U
+#define XRFDC_SUBADC_IXR_DCDR_MASK 0x00FF0000U
+#define XRFDC_ADC_OVR_VOLTAGE_MASK 0x04000000U
+#define XRFDC_ADC_OVR_RANGE_MASK 0x08000000U
+
+#define XRFDC_MTS_OK 0U
+#define XRFDC_MTS_NOT_SUPPORTED 1U
+#define XRFDC_MTS_TIMEOUT 2U
+#define XRFDC_MTS_MARKER_RUN 4U
+#define XRFDC_MTS_MARKER_MISM 8U
+#define XRFDC_MTS_DELAY_OVER 16U
+#define XRFDC_MTS_TARGET_LOW 32U
+#define XRFDC_MTS_IP_NOT_READY 64U
+#define XRFDC_MTS_DTC_INVALID 128U
+#define XRFDC_MTS_NOT_ENABLED 512U
+#define XRFDC_MTS_SYSREF_GATE_ERROR 2048U
+#define XRFDC_MTS_SYSREF_FREQ_NDONE 4096U
+#define XRFDC_MTS_BAD_REF_TILE 8192U
+
+typedef struct {
+    u32 DecimationMode;
+} XRFdc_ADCBlock_DigitalDataPath_Config;
+
+typedef struct {
+    u32 NumSlices;
+    XRFdc_ADCBlock_DigitalDataPath_Config ADCBlock_Digital_Config[4];
+} XRFdc_ADCTile_Config;
+
+typedef struct {
+    u32 DeviceId;
+    u64 BaseAddr;
+    u32 IPType;
+    XRFdc_ADCTile_Config ADCTile_Config[4];
+} XRFdc_Config;
+
+typedef struct {
+    XRFdc_Config RFdc_Config;
+    u32 IsReady;
+    u32 ADC4GSPS;
+} XRFdc;
+
+typedef struct {
+    double Freq;
+    double PhaseOffset;
+    u32 EventSource;
+    u32 CoarseMixFreq;
+    u32 MixerMode;
+    u8 FineMixerScale;
+    u8 MixerType;
+} XRFdc_Mixer_Settings;
+
+typedef struct {
+    u32 EnablePhase;
+    u32 EnableGain;
+    double GainCorrectionFactor;
+    double PhaseCorrectionFactor;
+    s32 OffsetCorrectionFactor;
+    u32 EventSource;
+} XRFdc_QMC_Settings;
+
+typedef struct {
+    u32 UpdateThreshold;
+    u32 ThresholdMode[2];
+    u32 ThresholdAvgVal[2];
+    u32 ThresholdUnderVal[2];
+    u32 ThresholdOverVal[2];
+} XRFdc_Threshold_Settings;
+
+typedef struct {
+    u32 Enabled;
+    double RefClkFreq;
+    double SampleRate;
+    u32 RefClkDivider;
+    u32 FeedbackDivider;
+    u32 OutputDivider;
+    u32 FractionalMode;
+    u64 FractionalData;
+    u32 FractWidth;
+} XRFdc_PLL_Settings;
+
+typedef struct {
+    double SamplingFreq;
+    u32 AnalogDataPathStatus;
+    u32 DigitalDataPathStatus;
+    u8 DataPathClocksStatus;
+    u8 IsFIFOFlagsEnabled;
+    u8 IsFIFOFlagsAsserted;
+} XRFdc_BlockStatus;
+
+typedef struct {
+    u32 IsEnabled;
+    u32 TileState;
+    u8 BlockStatusMask;
+    u32 PowerUpState;
+    u32 PLLState;
+} XRFdc_TileStatus;
+
+typedef struct {
+    XRFdc_TileStatus DACTileStatus[4];
+    XRFdc_TileStatus ADCTileStatus[4];
+    u32 State;
+} XRFdc_IPStatus;
+
+typedef struct {
+    u32 Count[4];
+    u32 Loc[4];
+} XRFdc_MTS_Marker;
+
+typedef struct {
+    u32 RefTile;
+    u32 IsPLL;
+    int Target_Latency;
+    int Offset[4];
+    int Latency[4];
+    int Marker_Delay;
+    int SysRef_Enable;
+    u32 Tiles;
+    XRFdc_MTS_Marker Marker;
+} XRFdc_MultiConverter_Sync_Config;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+XRFdc_Config* XRFdc_LookupConfig(u16 DeviceId);
+u32 XRFdc_RegisterMetal(XRFdc* InstancePtr, u16 DeviceId, struct metal_device** DevicePtr);
+u32 XRFdc_CfgInitialize(XRFdc* InstancePtr, XRFdc_Config* ConfigPtr);
+double XRFdc_GetDriverVersion(void);
+void XRFdc_DumpRegs(XRFdc* InstancePtr, u32 Type, int Tile_Id);
+
+u32 XRFdc_StartUp(XRFdc* InstancePtr, u32 Type, int Tile_Id);
+u32 XRFdc_Shutdown(XRFdc* InstancePtr, u32 Type, int Tile_Id);
+u32 XRFdc_Reset(XRFdc* InstancePtr, u32 Type, int Tile_Id);
+u32 XRFdc_GetIPStatus(XRFdc* InstancePtr, XRFdc_IPStatus* IPStatusPtr);
+u32 XRFdc_GetBlockStatus(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+                         XRFdc_BlockStatus* BlockStatusPtr);
+u32 XRFdc_CheckTileEnabled(XRFdc* InstancePtr, u32 Type, u32 Tile_Id);
+u32 XRFdc_CheckBlockEnabled(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id);
+u32 XRFdc_CheckDigitalPathEnabled(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id);
+u32 XRFdc_IsADCDigitalPathEnabled(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id);
+u32 XRFdc_IsDACDigitalPathEnabled(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id);
+u32 XRFdc_IsHighSpeedADC(XRFdc* InstancePtr, int Tile);
+u32 XRFdc_GetDataType(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id);
+
+u32 XRFdc_DynamicPLLConfig(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u8 Source,
+                           double RefClkFreq, double SamplingRate);
+u32 XRFdc_GetPLLConfig(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, XRFdc_PLL_Settings* PLLSettings);
+u32 XRFdc_GetPLLLockStatus(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32* LockStatusPtr);
+
+u32 XRFdc_SetMixerSettings(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+                           XRFdc_Mixer_Settings* MixerSettingsPtr);
+u32 XRFdc_GetMixerSettings(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+                           XRFdc_Mixer_Settings* MixerSettingsPtr);
+u32 XRFdc_ResetNCOPhase(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id);
+u32 XRFdc_UpdateEvent(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 Event);
+u32 XRFdc_SetQMCSettings(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+                         XRFdc_QMC_Settings* QMCSettingsPtr);
+u32 XRFdc_GetQMCSettings(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+                         XRFdc_QMC_Settings* QMCSettingsPtr);
+u32 XRFdc_SetNyquistZone(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 NyquistZone);
+u32 XRFdc_GetNyquistZone(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32* NyquistZonePtr);
+
+u32 XRFdc_SetInterpolationFactor(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32 InterpolationFactor);
+u32 XRFdc_GetInterpolationFactor(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32* InterpolationFactorPtr);
+u32 XRFdc_SetDecimationFactor(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32 DecimationFactor);
+u32 XRFdc_GetDecimationFactor(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32* DecimationFactorPtr);
+u32 XRFdc_SetDataPathMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32 Mode);
+u32 XRFdc_GetDataPathMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32* ModePtr);
+u32 XRFdc_SetIMRPassMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32 Mode);
+u32 XRFdc_GetIMRPassMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32* ModePtr);
+
+u32 XRFdc_SetupFIFO(XRFdc* InstancePtr, u32 Type, int Tile_Id, u8 Enable);
+u32 XRFdc_GetFIFOStatus(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u8* EnablePtr);
+u32 XRFdc_SetFabClkOutDiv(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u16 FabClkDiv);
+u32 XRFdc_GetFabClkOutDiv(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u16* FabClkDivPtr);
+double XRFdc_GetFabClkFreq(XRFdc* InstancePtr, u32 Type, u32 Tile_Id);
+u32 XRFdc_GetFabRdVldWords(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32* GetFabricRate);
+u32 XRFdc_GetFabWrVldWords(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32* GetFabricRate);
+
+u32 XRFdc_SetThresholdSettings(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id,
+                               XRFdc_Threshold_Settings* ThresholdSettingsPtr);
+u32 XRFdc_GetThresholdSettings(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id,
+                               XRFdc_Threshold_Settings* ThresholdSettingsPtr);
+u32 XRFdc_SetCalibrationMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u8 CalibrationMode);
+u32 XRFdc_GetCalibrationMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u8* CalibrationModePtr);
+u32 XRFdc_SetDecoderMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32 DecoderMode);
+u32 XRFdc_GetDecoderMode(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u32* DecoderModePtr);
+u32 XRFdc_SetInvSincFIR(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u16 Mode);
+u32 XRFdc_GetInvSincFIR(XRFdc* InstancePtr, u32 Tile_Id, u32 Block_Id, u16* ModePtr);
+
+u32 XRFdc_IntrEnable(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 IntrMask);
+u32 XRFdc_IntrDisable(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 IntrMask);
+u32 XRFdc_IntrClr(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 IntrMask);
+u32 XRFdc_GetIntrStatus(XRFdc* InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32* IntrStsPtr);
+
+void XRFdc_MultiConverter_Init(XRFdc_MultiConverter_Sync_Config* ConfigPtr, int* PLL_CodesPtr,
+                               int* T1_CodesPtr, u32 RefTile);
+u32 XRFdc_MultiConverter_Sync(XRFdc* InstancePtr, u32 Type, XRFdc_MultiConverter_Sync_Config* ConfigPtr);
+u32 XRFdc_MTS_Sysref_Config(XRFdc* InstancePtr, XRFdc_MultiConverter_Sync_Config* DACSyncConfigPtr,
+                            XRFdc_MultiConverter_Sync_Config* ADCSyncConfigPtr, u32 SysRefEnable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RFDC_HOST_SIM_XRFDC_H
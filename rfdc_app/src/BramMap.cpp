@@ -0,0 +1,130 @@
+#include "BramMap.hpp"
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace bram_map {
+
+constexpr size_t BramMap::NUM_CHANNELS;
+constexpr uint32_t BramMap::INVALID_ADDR;
+
+BramMap::BramMap(int mem_fd, size_t window_size)
+    : mem_fd_(mem_fd)
+    , window_size_(window_size)
+    , page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE)))
+{
+}
+
+BramMap::~BramMap()
+{
+    release();
+}
+
+uint8_t* BramMap::map_lane(uint32_t paddr)
+{
+    const size_t page_off = paddr & (page_size_ - 1);
+
+    void* base = mmap(nullptr, window_size_ + page_off,
+                      PROT_READ | PROT_WRITE, MAP_SHARED,
+                      mem_fd_, paddr - page_off);
+    stats_.mmap_calls++;
+
+    if (base == MAP_FAILED) {
+        std::cerr << "    ✗ Failed to mmap BRAM at 0x" << std::hex << paddr << std::dec << "\n";
+        return nullptr;
+    }
+    return static_cast<uint8_t*>(base) + page_off;
+}
+
+void BramMap::unmap_lane(uint8_t* vaddr, uint32_t paddr)
+{
+    const size_t page_off = paddr & (page_size_ - 1);
+
+    if (munmap(vaddr - page_off, window_size_ + page_off) == -1) {
+        std::cerr << "    ⚠ Warning: unmap of BRAM 0x" << std::hex << paddr << std::dec << " failed\n";
+    }
+    stats_.munmap_calls++;
+}
+
+bool BramMap::map_channel(const rfdc::RFDC::ChannelMap& entry, ChannelWindow& win)
+{
+    win = ChannelWindow();
+    if (entry.addr_I == INVALID_ADDR) {
+        return true;    // Channel not present in this design
+    }
+
+    win.paddr_I = entry.addr_I;
+    win.paddr_Q = entry.addr_Q;
+    win.size = window_size_;
+
+    win.I = map_lane(entry.addr_I);
+    if (!win.I) {
+        return false;
+    }
+
+    if (entry.addr_Q == INVALID_ADDR || entry.addr_Q == entry.addr_I) {
+        win.Q = win.I;
+    } else {
+        win.Q = map_lane(entry.addr_Q);
+        if (!win.Q) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BramMap::unmap_channel(ChannelWindow& win)
+{
+    if (win.has_separate_q()) {
+        unmap_lane(win.Q, win.paddr_Q);
+    }
+    if (win.I) {
+        unmap_lane(win.I, win.paddr_I);
+    }
+    win = ChannelWindow();
+}
+
+bool BramMap::build(const ChannelMaps& adc_map, const ChannelMaps& dac_map)
+{
+    if (mem_fd_ < 0) {
+        std::cerr << "Invalid /dev/mem descriptor for BRAM map\n";
+        return false;
+    }
+
+    release();
+
+    bool ok = true;
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+        ok &= map_channel(adc_map[ch], adc_[ch]);
+        ok &= map_channel(dac_map[ch], dac_[ch]);
+
+        if (adc_[ch].valid()) stats_.adc_channels++;
+        if (dac_[ch].valid()) stats_.dac_channels++;
+    }
+
+    built_ = true;
+    return ok;
+}
+
+void BramMap::release()
+{
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+        unmap_channel(adc_[ch]);
+        unmap_channel(dac_[ch]);
+    }
+    stats_.adc_channels = 0;
+    stats_.dac_channels = 0;
+    built_ = false;
+}
+
+const ChannelWindow* BramMap::window(rfdc::TileType type, uint32_t channel) const
+{
+    if (channel >= NUM_CHANNELS) {
+        return nullptr;
+    }
+
+    const ChannelWindow& win = (type == rfdc::TileType::ADC) ? adc_[channel] : dac_[channel];
+    return win.valid() ? &win : nullptr;
+}
+
+} // namespace bram_map
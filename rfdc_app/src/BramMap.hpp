@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "rfdc_wrapper/RfDc.hpp"
+
+namespace bram_map {
+
+/**
+ * @brief One mapped BRAM channel (I lane and, for IQ ADCs, a separate Q lane)
+ *
+ * For REAL channels and for DACs the Q lane aliases the I lane, exactly like
+ * the addresses reported by RFDC::get_adc_map()/get_dac_map().
+ */
+struct ChannelWindow {
+    uint32_t paddr_I = 0xFFFFFFFF;
+    uint32_t paddr_Q = 0xFFFFFFFF;
+    uint8_t* I = nullptr;
+    uint8_t* Q = nullptr;
+    size_t size = 0;            // Bytes mapped per lane
+
+    bool valid() const { return I != nullptr; }
+    bool has_separate_q() const { return Q != nullptr && Q != I; }
+};
+
+/**
+ * @brief Persistent /dev/mem windows over every ADC/DAC BRAM channel
+ *
+ * Built once after the channel maps are known and kept for the life of the
+ * application, so data transfers only touch already-mapped memory instead of
+ * paying an mmap()/munmap() pair (and the TLB shootdown) per lane per call.
+ */
+class BramMap {
+public:
+    static constexpr size_t NUM_CHANNELS = 16;
+    static constexpr uint32_t INVALID_ADDR = 0xFFFFFFFF;
+
+    using ChannelMaps = std::array<rfdc::RFDC::ChannelMap, NUM_CHANNELS>;
+
+    struct Stats {
+        uint64_t mmap_calls = 0;
+        uint64_t munmap_calls = 0;
+        uint32_t adc_channels = 0;
+        uint32_t dac_channels = 0;
+    };
+
+    /**
+     * @brief Construct an empty mapping table
+     * @param mem_fd Open /dev/mem file descriptor (not owned)
+     * @param window_size Bytes to map per lane
+     */
+    BramMap(int mem_fd, size_t window_size);
+    ~BramMap();
+
+    BramMap(const BramMap&) = delete;
+    BramMap& operator=(const BramMap&) = delete;
+
+    /**
+     * @brief Map every valid channel of both converter types
+     * @param adc_map ADC channel map (RFDC::get_adc_map())
+     * @param dac_map DAC channel map (RFDC::get_dac_map())
+     * @return true if every valid address could be mapped
+     */
+    bool build(const ChannelMaps& adc_map, const ChannelMaps& dac_map);
+
+    /**
+     * @brief Unmap all windows (also done by the destructor)
+     */
+    void release();
+
+    /**
+     * @brief Look up the mapped window of a channel
+     * @param type DAC or ADC
+     * @param channel Channel index (tile * 4 + block)
+     * @return Window, or nullptr if the channel is out of range or unmapped
+     */
+    const ChannelWindow* window(rfdc::TileType type, uint32_t channel) const;
+
+    const ChannelWindow* adc(uint32_t channel) const { return window(rfdc::TileType::ADC, channel); }
+    const ChannelWindow* dac(uint32_t channel) const { return window(rfdc::TileType::DAC, channel); }
+
+    bool is_built() const { return built_; }
+    size_t window_size() const { return window_size_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    int mem_fd_;
+    size_t window_size_;
+    size_t page_size_;
+    bool built_ = false;
+    Stats stats_;
+
+    std::array<ChannelWindow, NUM_CHANNELS> adc_;
+    std::array<ChannelWindow, NUM_CHANNELS> dac_;
+
+    bool map_channel(const rfdc::RFDC::ChannelMap& entry, ChannelWindow& win);
+    void unmap_channel(ChannelWindow& win);
+
+    // Page-aligned mmap of [paddr, paddr + window_size_)
+    uint8_t* map_lane(uint32_t paddr);
+    void unmap_lane(uint8_t* vaddr, uint32_t paddr);
+};
+
+} // namespace bram_map
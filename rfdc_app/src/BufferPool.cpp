@@ -0,0 +1,125 @@
+#include "BufferPool.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace buffer_pool {
+
+constexpr size_t BufferPool::ALIGNMENT;
+
+namespace {
+
+size_t round_up(size_t bytes)
+{
+    return (bytes + BufferPool::ALIGNMENT - 1) & ~(BufferPool::ALIGNMENT - 1);
+}
+
+void* aligned_block(size_t bytes)
+{
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, BufferPool::ALIGNMENT, round_up(bytes ? bytes : 1)) != 0) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+BufferPool::BufferPool(size_t block_bytes, size_t max_cached)
+    : block_bytes_(round_up(block_bytes))
+    , max_cached_(max_cached)
+{
+    free_.reserve(max_cached_);
+}
+
+BufferPool::~BufferPool()
+{
+    for (void* ptr : free_) {
+        std::free(ptr);
+    }
+}
+
+void* BufferPool::allocate(size_t bytes)
+{
+    if (bytes > block_bytes_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.oversize++;
+        return aligned_block(bytes);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.outstanding++;
+        if (!free_.empty()) {
+            void* ptr = free_.back();
+            free_.pop_back();
+            stats_.reuses++;
+            stats_.cached = free_.size();
+            return ptr;
+        }
+        stats_.heap_allocations++;
+    }
+
+    try {
+        return aligned_block(block_bytes_);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.outstanding--;
+        stats_.heap_allocations--;
+        throw;
+    }
+}
+
+void BufferPool::deallocate(void* ptr, size_t bytes) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+    if (bytes > block_bytes_) {
+        std::free(ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.releases++;
+    stats_.outstanding--;
+    if (free_.size() < max_cached_) {
+        free_.push_back(ptr);
+        stats_.cached = free_.size();
+        return;
+    }
+    std::free(ptr);
+}
+
+void BufferPool::reserve(size_t count)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (free_.size() < count && free_.size() < max_cached_) {
+        free_.push_back(aligned_block(block_bytes_));
+        stats_.heap_allocations++;
+    }
+    stats_.cached = free_.size();
+}
+
+BufferPool::Stats BufferPool::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void BufferPool::reset_stats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t outstanding = stats_.outstanding;
+    stats_ = Stats();
+    stats_.outstanding = outstanding;
+    stats_.cached = free_.size();
+}
+
+BufferPool& BufferPool::shared()
+{
+    // Never destroyed: pooled vectors may outlive static destruction order
+    static BufferPool* pool = new BufferPool(32 * 1024);
+    return *pool;
+}
+
+} // namespace buffer_pool
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace buffer_pool {
+
+/**
+ * @brief Recycling pool of 64-byte-aligned sample buffers
+ *
+ * Every buffer up to block_bytes() is served from one fixed block size, so a
+ * block freed by one capture fits the next one and steady-state capture or
+ * waveform loops stop hitting the heap. Larger requests are still served
+ * (aligned, straight from the heap) and counted as oversize.
+ *
+ * Thread-safe; blocks may be released from any thread.
+ */
+class BufferPool {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    struct Stats {
+        uint64_t heap_allocations = 0;  // New pooled blocks taken from the heap
+        uint64_t reuses = 0;            // Requests served from the free list
+        uint64_t releases = 0;          // Blocks handed back
+        uint64_t oversize = 0;          // Requests larger than one block
+        size_t outstanding = 0;         // Pooled blocks currently in use
+        size_t cached = 0;              // Pooled blocks on the free list
+    };
+
+    /**
+     * @brief Construct an empty pool
+     * @param block_bytes Size of every pooled block (rounded up to ALIGNMENT)
+     * @param max_cached Free blocks kept before returning them to the heap
+     */
+    explicit BufferPool(size_t block_bytes, size_t max_cached = 64);
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Get an aligned buffer of at least bytes
+     * @throws std::bad_alloc if the heap is exhausted
+     */
+    void* allocate(size_t bytes);
+
+    /**
+     * @brief Return a buffer obtained from allocate()
+     * @param ptr Buffer
+     * @param bytes Size passed to allocate()
+     */
+    void deallocate(void* ptr, size_t bytes) noexcept;
+
+    /**
+     * @brief Pre-fill the free list so the first captures don't allocate
+     * @param count Number of blocks to have cached
+     */
+    void reserve(size_t count);
+
+    Stats stats() const;
+    void reset_stats();
+    size_t block_bytes() const { return block_bytes_; }
+
+    /**
+     * @brief Process-wide pool used by default-constructed PoolAllocators
+     *
+     * Blocks hold one full BRAM channel window (32 KB), the largest
+     * single-lane capture or DAC waveform.
+     */
+    static BufferPool& shared();
+
+private:
+    const size_t block_bytes_;
+    const size_t max_cached_;
+
+    mutable std::mutex mutex_;
+    std::vector<void*> free_;
+    Stats stats_;
+};
+
+/**
+ * @brief std::allocator replacement that draws from a BufferPool
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept : pool_(&BufferPool::shared()) {}
+    explicit PoolAllocator(BufferPool& pool) noexcept : pool_(&pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        pool_->deallocate(ptr, n * sizeof(T));
+    }
+
+    BufferPool* pool() const noexcept { return pool_; }
+
+private:
+    BufferPool* pool_;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept
+{
+    return a.pool() == b.pool();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept
+{
+    return !(a == b);
+}
+
+// Pooled, 64-byte-aligned int16 sample storage
+using SampleVector = std::vector<int16_t, PoolAllocator<int16_t>>;
+
+} // namespace buffer_pool
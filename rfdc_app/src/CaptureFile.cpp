@@ -0,0 +1,311 @@
+#include "CaptureFile.hpp"
+#include "SampleKernels.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace capture_file {
+
+namespace {
+
+// ===== Sidecar JSON Helpers =====
+
+std::string json_escape(const std::string& s)
+{
+    std::ostringstream out;
+    for (char c : s) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+        }
+    }
+    return out.str();
+}
+
+// Locate "key": and return the raw value (unescaped if it is a string).
+// Only meant for the flat objects written by write_metadata().
+bool json_value(const std::string& json, const std::string& key, std::string& value)
+{
+    const std::string quoted = "\"" + key + "\"";
+    size_t pos = json.find(quoted);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = json.find(':', pos + quoted.size());
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = json.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos) {
+        return false;
+    }
+
+    value.clear();
+    if (json[pos] != '"') {
+        size_t end = json.find_first_of(",}\r\n", pos);
+        value = json.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+            value.pop_back();
+        }
+        return !value.empty();
+    }
+
+    for (size_t n = pos + 1; n < json.size(); ++n) {
+        char c = json[n];
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\' || n + 1 >= json.size()) {
+            value += c;
+            continue;
+        }
+        char e = json[++n];
+        switch (e) {
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'u':
+                if (n + 4 < json.size()) {
+                    value += static_cast<char>(std::strtol(json.substr(n + 1, 4).c_str(), nullptr, 16));
+                    n += 4;
+                }
+                break;
+            default:  value += e; break;
+        }
+    }
+    return false;   // Unterminated string
+}
+
+bool write_all(int fd, const void* buf, size_t bytes)
+{
+    const char* p = static_cast<const char*>(buf);
+    while (bytes > 0) {
+        ssize_t n = ::write(fd, p, bytes);
+        if (n < 0) {
+            return false;
+        }
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+// ===== Writer =====
+
+uint64_t now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+bool write_metadata(const std::string& path, const Metadata& meta)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "    ✗ Failed to open sidecar " << path << "\n";
+        return false;
+    }
+
+    file << std::setprecision(17);
+    file << "{\n"
+         << "  \"version\": 1,\n"
+         << "  \"format\": \"" << json_escape(meta.format) << "\",\n"
+         << "  \"type\": \"" << json_escape(meta.type) << "\",\n"
+         << "  \"tile\": " << meta.tile << ",\n"
+         << "  \"block\": " << meta.block << ",\n"
+         << "  \"q_block\": " << meta.q_block << ",\n"
+         << "  \"num_samples\": " << meta.num_samples << ",\n"
+         << "  \"sample_rate_hz\": " << meta.sample_rate_hz << ",\n"
+         << "  \"mixer_mode\": \"" << json_escape(meta.mixer_mode) << "\",\n"
+         << "  \"nco_freq_mhz\": " << meta.nco_freq_mhz << ",\n"
+         << "  \"timestamp_ns\": " << meta.timestamp_ns << ",\n"
+         << "  \"rfdc_events\": \"" << json_escape(meta.rfdc_events) << "\",\n"
+         << "  \"notes\": \"" << json_escape(meta.notes) << "\"\n"
+         << "}\n";
+
+    return file.good();
+}
+
+bool write(const std::string& data_path,
+           sample::SampleSpan I,
+           sample::SampleSpan Q,
+           const Metadata& meta)
+{
+    const bool iq = !Q.empty();
+    if (iq && Q.size() != I.size()) {
+        std::cerr << "    ✗ I/Q size mismatch for " << data_path << "\n";
+        return false;
+    }
+
+    int fd = ::open(data_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(("open " + data_path).c_str());
+        return false;
+    }
+
+    bool ok = true;
+    if (!iq) {
+        ok = write_all(fd, I.data(), I.size() * sizeof(int16_t));
+    } else {
+        // Interleave through one pooled block at a time
+        buffer_pool::SampleVector chunk(buffer_pool::BufferPool::shared().block_bytes() / sizeof(int16_t));
+        const size_t per_chunk = chunk.size() / 2;
+        for (size_t n = 0; ok && n < I.size(); n += per_chunk) {
+            size_t count = std::min(per_chunk, I.size() - n);
+            kernels::merge_iq(I.data() + n, Q.data() + n, chunk.data(), count);
+            ok = write_all(fd, chunk.data(), count * 2 * sizeof(int16_t));
+        }
+    }
+    ::close(fd);
+
+    if (!ok) {
+        perror(("write " + data_path).c_str());
+        return false;
+    }
+
+    Metadata full = meta;
+    full.format = iq ? "ci16" : "i16";
+    full.num_samples = I.size();
+    return write_metadata(data_path + ".json", full);
+}
+
+bool read_metadata(const std::string& sidecar_path, Metadata& meta)
+{
+    std::ifstream file(sidecar_path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string json = ss.str();
+
+    std::string v;
+    meta = Metadata();
+
+    if (!json_value(json, "format", meta.format) ||
+        (meta.format != "ci16" && meta.format != "i16")) {
+        std::cerr << "    ✗ " << sidecar_path << ": missing or unknown format\n";
+        return false;
+    }
+    if (!json_value(json, "num_samples", v)) {
+        std::cerr << "    ✗ " << sidecar_path << ": missing num_samples\n";
+        return false;
+    }
+    meta.num_samples = std::strtoull(v.c_str(), nullptr, 10);
+
+    if (json_value(json, "type", v))           meta.type = v;
+    if (json_value(json, "tile", v))           meta.tile = std::strtoul(v.c_str(), nullptr, 10);
+    if (json_value(json, "block", v))          meta.block = std::strtoul(v.c_str(), nullptr, 10);
+    if (json_value(json, "q_block", v))        meta.q_block = std::strtol(v.c_str(), nullptr, 10);
+    if (json_value(json, "sample_rate_hz", v)) meta.sample_rate_hz = std::strtod(v.c_str(), nullptr);
+    if (json_value(json, "mixer_mode", v))     meta.mixer_mode = v;
+    if (json_value(json, "nco_freq_mhz", v))   meta.nco_freq_mhz = std::strtod(v.c_str(), nullptr);
+    if (json_value(json, "timestamp_ns", v))   meta.timestamp_ns = std::strtoull(v.c_str(), nullptr, 10);
+    if (json_value(json, "rfdc_events", v))    meta.rfdc_events = v;
+    if (json_value(json, "notes", v))          meta.notes = v;
+
+    return true;
+}
+
+// ===== Reader =====
+
+MappedCapture::~MappedCapture()
+{
+    close();
+}
+
+bool MappedCapture::open(const std::string& data_path)
+{
+    close();
+
+    Metadata meta;
+    if (!read_metadata(data_path + ".json", meta)) {
+        std::cerr << "    ✗ No valid sidecar for " << data_path << "\n";
+        return false;
+    }
+
+    const size_t values = static_cast<size_t>(meta.num_samples) * (meta.is_iq() ? 2 : 1);
+    const size_t bytes = values * sizeof(int16_t);
+    if (bytes == 0) {
+        std::cerr << "    ✗ Empty capture " << data_path << "\n";
+        return false;
+    }
+
+    int fd = ::open(data_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        perror(("open " + data_path).c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != bytes) {
+        std::cerr << "    ✗ " << data_path << ": size does not match sidecar ("
+                  << bytes << " bytes expected)\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        perror(("mmap " + data_path).c_str());
+        return false;
+    }
+
+    meta_ = meta;
+    data_ = static_cast<const int16_t*>(base);
+    values_ = values;
+    map_bytes_ = bytes;
+    return true;
+}
+
+void MappedCapture::close()
+{
+    if (data_) {
+        munmap(const_cast<int16_t*>(data_), map_bytes_);
+    }
+    data_ = nullptr;
+    values_ = 0;
+    map_bytes_ = 0;
+    meta_ = Metadata();
+}
+
+void MappedCapture::copy_lanes(buffer_pool::SampleVector& I, buffer_pool::SampleVector& Q) const
+{
+    const size_t n = num_samples();
+    I.resize(n);
+    Q.clear();
+
+    if (!is_iq()) {
+        std::copy(data_, data_ + n, I.begin());
+        return;
+    }
+
+    Q.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        I[k] = data_[2 * k];
+        Q[k] = data_[2 * k + 1];
+    }
+}
+
+} // namespace capture_file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "SampleSpan.hpp"
+#include "BufferPool.hpp"
+
+namespace capture_file {
+
+/**
+ * @brief Binary capture files: raw samples plus a JSON metadata sidecar
+ *
+ * The data file holds little-endian int16 samples with no header, so it can
+ * be mmap'ed or loaded with numpy.fromfile() directly:
+ *   - "ci16": interleaved I0,Q0,I1,Q1,...
+ *   - "i16":  REAL samples
+ * The sidecar is written next to it as <data file>.json, after the data,
+ * so a present sidecar means a complete capture.
+ */
+
+struct Metadata {
+    std::string format = "i16";     // "ci16" or "i16" (set by write())
+    std::string type = "ADC";       // "ADC" or "DAC"
+    uint32_t tile = 0;
+    uint32_t block = 0;
+    int32_t q_block = -1;           // Block carrying Q if not the same one
+    uint64_t num_samples = 0;       // Samples per lane (set by write())
+    double sample_rate_hz = 0.0;
+    std::string mixer_mode;
+    double nco_freq_mhz = 0.0;
+    uint64_t timestamp_ns = 0;      // Unix time of the capture
+    std::string rfdc_events;        // Converter events during the capture, empty if clean
+    std::string notes;             // Free-form (e.g. the old CSV header)
+
+    bool is_iq() const { return format == "ci16"; }
+};
+
+/**
+ * @brief Current wall-clock time in Unix nanoseconds
+ */
+uint64_t now_ns();
+
+/**
+ * @brief Write a capture and its sidecar
+ * @param data_path Data file path (sidecar goes to data_path + ".json")
+ * @param I I (or REAL) samples
+ * @param Q Q samples, empty for REAL captures; must match I in length
+ * @param meta Metadata; format and num_samples are filled in here
+ * @return true on success
+ */
+bool write(const std::string& data_path,
+           sample::SampleSpan I,
+           sample::SampleSpan Q,
+           const Metadata& meta);
+
+/**
+ * @brief Write a sidecar file on its own (for writers that stream the data)
+ * @param sidecar_path Sidecar path (normally data file + ".json")
+ * @param meta Metadata, format and num_samples already filled in
+ * @return true on success
+ */
+bool write_metadata(const std::string& sidecar_path, const Metadata& meta);
+
+/**
+ * @brief Parse a sidecar file
+ * @return true if the file exists and has the mandatory fields
+ */
+bool read_metadata(const std::string& sidecar_path, Metadata& meta);
+
+/**
+ * @brief Read-only memory-mapped capture
+ */
+class MappedCapture {
+public:
+    MappedCapture() = default;
+    ~MappedCapture();
+
+    MappedCapture(const MappedCapture&) = delete;
+    MappedCapture& operator=(const MappedCapture&) = delete;
+
+    /**
+     * @brief Map a data file and load its sidecar
+     * @param data_path Data file path
+     * @return true if both files are valid and sizes agree
+     */
+    bool open(const std::string& data_path);
+    void close();
+
+    bool is_open() const { return data_ != nullptr; }
+    const Metadata& metadata() const { return meta_; }
+    bool is_iq() const { return meta_.is_iq(); }
+    size_t num_samples() const { return static_cast<size_t>(meta_.num_samples); }
+
+    /**
+     * @brief All stored values in file order (I/Q interleaved for ci16)
+     */
+    sample::SampleSpan raw() const { return sample::SampleSpan(data_, values_); }
+
+    int16_t i(size_t n) const { return is_iq() ? data_[2 * n] : data_[n]; }
+    int16_t q(size_t n) const { return is_iq() ? data_[2 * n + 1] : 0; }
+
+    /**
+     * @brief De-interleave into separate lanes (Q left empty for REAL)
+     */
+    void copy_lanes(buffer_pool::SampleVector& I, buffer_pool::SampleVector& Q) const;
+
+private:
+    Metadata meta_;
+    const int16_t* data_ = nullptr;
+    size_t values_ = 0;
+    size_t map_bytes_ = 0;
+};
+
+} // namespace capture_file
@@ -0,0 +1,443 @@
+#include "CaptureServer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace capture_server {
+
+namespace {
+
+constexpr int POLL_INTERVAL_MS = 200;   // How often blocked threads check for stop()
+
+bool make_address(const std::string& path, sockaddr_un& addr)
+{
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Invalid socket path: " << path << "\n";
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// Read exactly `bytes`; false on EOF, error, or `keep_going` turning false
+bool read_full(int fd, void* data, size_t bytes, const std::atomic<bool>* keep_going = nullptr)
+{
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (bytes > 0) {
+        if (keep_going) {
+            pollfd pfd = {fd, POLLIN, 0};
+            int ret = ::poll(&pfd, 1, POLL_INTERVAL_MS);
+            if (ret < 0 && errno != EINTR) {
+                return false;
+            }
+            if (!keep_going->load()) {
+                return false;
+            }
+            if (ret <= 0) {
+                continue;
+            }
+        }
+        ssize_t n = ::read(fd, p, bytes);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Gathered write of every iovec; MSG_NOSIGNAL so a vanished client is an error, not SIGPIPE
+bool write_all(int fd, iovec* iov, int count)
+{
+    while (count > 0) {
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size_t done = static_cast<size_t>(n);
+        while (count > 0 && done >= iov->iov_len) {
+            done -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + done;
+            iov->iov_len -= done;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ===== Server =====
+
+struct Server::Connection {
+    struct Outgoing {
+        FrameHeader header;
+        Block block;
+        std::string error;
+    };
+
+    int fd = -1;
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Outgoing> queue;
+    bool closing = false;               // Request side is done
+    std::atomic<bool> broken{false};    // Client gone or write failed
+    std::atomic<bool> finished{false};  // Safe to join
+};
+
+Server::Server(const std::string& socket_path, CaptureHandler handler, const Options& options)
+    : path_(socket_path)
+    , handler_(std::move(handler))
+    , options_(options)
+{
+}
+
+Server::~Server()
+{
+    stop();
+}
+
+bool Server::start()
+{
+    if (running_) {
+        return true;
+    }
+
+    sockaddr_un addr;
+    if (!make_address(path_, addr)) {
+        return false;
+    }
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        perror("socket");
+        return false;
+    }
+
+    ::unlink(path_.c_str());    // Stale socket from a previous run
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, static_cast<int>(options_.max_clients)) != 0) {
+        perror(("bind/listen " + path_).c_str());
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    accept_thread_ = std::thread(&Server::accept_loop, this);
+    return true;
+}
+
+void Server::stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    ::unlink(path_.c_str());
+
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto& conn : connections_) {
+            ::shutdown(conn->fd, SHUT_RDWR);
+        }
+    }
+    reap(true);
+}
+
+Stats Server::stats() const
+{
+    Stats s;
+    s.connections = connections_total_.load();
+    s.requests = requests_.load();
+    s.frames = frames_.load();
+    s.errors = errors_.load();
+    s.bytes = bytes_.load();
+    return s;
+}
+
+void Server::accept_loop()
+{
+    while (running_) {
+        reap(false);
+
+        pollfd pfd = {listen_fd_, POLLIN, 0};
+        if (::poll(&pfd, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (connections_.size() >= options_.max_clients) {
+            std::cerr << "    ⚠ Capture server full, refusing client\n";
+            ::close(fd);
+            continue;
+        }
+        connections_.emplace_back(new Connection());
+        Connection& conn = *connections_.back();
+        conn.fd = fd;
+        conn.thread = std::thread(&Server::serve, this, std::ref(conn));
+        connections_total_++;
+    }
+}
+
+void Server::reap(bool all)
+{
+    std::list<std::unique_ptr<Connection>> done;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            if (all || (*it)->finished) {
+                done.splice(done.end(), connections_, it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& conn : done) {
+        if (conn->thread.joinable()) {
+            conn->thread.join();
+        }
+    }
+}
+
+void Server::serve(Connection& conn)
+{
+    // Frames go out on their own thread so the next capture overlaps the send
+    std::thread sender(&Server::send_loop, this, std::ref(conn));
+
+    Request req;
+    while (!conn.broken && read_full(conn.fd, &req, sizeof(req), &running_)) {
+        if (req.magic != REQUEST_MAGIC) {
+            std::cerr << "    ⚠ Capture client sent a malformed request, closing\n";
+            break;
+        }
+        requests_++;
+
+        FrameHeader header;
+        header.request_id = req.id;
+        header.tile = req.tile;
+        header.block = req.block;
+
+        std::string error;
+        if (req.num_samples == 0 || req.num_samples > options_.max_samples) {
+            error = "num_samples must be 1.." + std::to_string(options_.max_samples);
+        } else if (req.repeat == 0 || req.repeat > options_.max_repeat) {
+            error = "repeat must be 1.." + std::to_string(options_.max_repeat);
+        }
+        if (!error.empty()) {
+            header.status = static_cast<uint32_t>(Status::BadRequest);
+            queue_frame(conn, header, Block(), std::move(error));
+            continue;
+        }
+
+        for (uint32_t n = 0; n < req.repeat && running_ && !conn.broken; ++n) {
+            header.index = n;
+            header.status = static_cast<uint32_t>(Status::Ok);
+
+            Block block;
+            try {
+                handler_(req, block);
+            } catch (const std::invalid_argument& e) {
+                header.status = static_cast<uint32_t>(Status::BadRequest);
+                error = e.what();
+            } catch (const std::exception& e) {
+                header.status = static_cast<uint32_t>(Status::CaptureFailed);
+                error = e.what();
+            }
+
+            bool failed = header.status != static_cast<uint32_t>(Status::Ok);
+            if (!queue_frame(conn, header, std::move(block), std::move(error)) || failed) {
+                break;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(conn.mutex);
+        conn.closing = true;
+    }
+    conn.cv.notify_all();
+    sender.join();
+
+    ::close(conn.fd);
+    conn.finished = true;
+}
+
+bool Server::queue_frame(Connection& conn, const FrameHeader& header,
+                         Block&& block, std::string&& error)
+{
+    std::unique_lock<std::mutex> lock(conn.mutex);
+    conn.cv.wait(lock, [&]() {
+        return conn.queue.size() < options_.send_queue_depth || conn.broken;
+    });
+    if (conn.broken) {
+        return false;
+    }
+
+    Connection::Outgoing out;
+    out.header = header;
+    out.block = std::move(block);
+    out.error = std::move(error);
+    conn.queue.push_back(std::move(out));
+    lock.unlock();
+    conn.cv.notify_all();
+    return true;
+}
+
+void Server::send_loop(Connection& conn)
+{
+    for (;;) {
+        Connection::Outgoing out;
+        {
+            std::unique_lock<std::mutex> lock(conn.mutex);
+            conn.cv.wait(lock, [&]() { return !conn.queue.empty() || conn.closing; });
+            if (conn.queue.empty()) {
+                return;
+            }
+            out = std::move(conn.queue.front());
+            conn.queue.pop_front();
+        }
+        conn.cv.notify_all();
+
+        FrameHeader& h = out.header;
+        iovec iov[3];
+        int count = 1;
+        iov[0] = {&h, sizeof(h)};
+
+        if (h.status == static_cast<uint32_t>(Status::Ok)) {
+            const bool iq = !out.block.Q.empty();
+            h.lanes = iq ? 2 : 1;
+            h.num_samples = static_cast<uint32_t>(out.block.I.size());
+            h.timestamp_ns = out.block.timestamp_ns;
+            h.sample_rate_hz = out.block.sample_rate_hz;
+            h.payload_bytes = (out.block.I.size() + out.block.Q.size()) * sizeof(int16_t);
+            iov[count++] = {out.block.I.data(), out.block.I.size() * sizeof(int16_t)};
+            if (iq) {
+                iov[count++] = {out.block.Q.data(), out.block.Q.size() * sizeof(int16_t)};
+            }
+            frames_++;
+        } else {
+            h.payload_bytes = out.error.size();
+            iov[count++] = {&out.error[0], out.error.size()};
+            errors_++;
+        }
+
+        if (!write_all(conn.fd, iov, count)) {
+            conn.broken = true;
+            std::lock_guard<std::mutex> lock(conn.mutex);
+            conn.queue.clear();
+            conn.cv.notify_all();
+            continue;   // Wait for the request side to notice and close
+        }
+        bytes_ += h.payload_bytes;
+    }
+}
+
+// ===== Client =====
+
+Client::~Client()
+{
+    close();
+}
+
+bool Client::connect(const std::string& socket_path)
+{
+    close();
+
+    sockaddr_un addr;
+    if (!make_address(socket_path, addr)) {
+        return false;
+    }
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        perror("socket");
+        return false;
+    }
+    if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        perror(("connect " + socket_path).c_str());
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Client::close()
+{
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+}
+
+bool Client::send(const Request& request)
+{
+    iovec iov = {const_cast<Request*>(&request), sizeof(request)};
+    return fd_ >= 0 && write_all(fd_, &iov, 1);
+}
+
+bool Client::receive(FrameHeader& header,
+                     buffer_pool::SampleVector& I,
+                     buffer_pool::SampleVector& Q,
+                     std::string* error)
+{
+    if (fd_ < 0 || !read_full(fd_, &header, sizeof(header)) || header.magic != FRAME_MAGIC) {
+        return false;
+    }
+
+    if (header.status != static_cast<uint32_t>(Status::Ok)) {
+        std::string msg(header.payload_bytes, '\0');
+        if (!msg.empty() && !read_full(fd_, &msg[0], msg.size())) {
+            return false;
+        }
+        if (error) {
+            *error = std::move(msg);
+        }
+        I.clear();
+        Q.clear();
+        return true;
+    }
+
+    const size_t n = header.num_samples;
+    if (header.lanes < 1 || header.lanes > 2 ||
+        header.payload_bytes != header.lanes * n * sizeof(int16_t)) {
+        return false;
+    }
+    I.resize(n);
+    Q.resize(header.lanes == 2 ? n : 0);
+    return read_full(fd_, I.data(), n * sizeof(int16_t)) &&
+           (Q.empty() || read_full(fd_, Q.data(), n * sizeof(int16_t)));
+}
+
+} // namespace capture_server
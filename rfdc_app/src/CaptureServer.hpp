@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "BufferPool.hpp"
+
+namespace capture_server {
+
+/**
+ * @brief Capture streaming over a Unix domain socket
+ *
+ * Wire format (little-endian, no padding):
+ *   client → server: Request, any number back to back (pipelined)
+ *   server → client: for each request, `repeat` frames in order, each a
+ *                    FrameHeader followed by payload_bytes of payload
+ * An OK frame's payload is num_samples I values, then num_samples Q values
+ * for I/Q captures (planar int16). An error frame carries a UTF-8 message
+ * and ends that request.
+ */
+
+constexpr uint32_t REQUEST_MAGIC = 0x51434652;  // "RFCQ"
+constexpr uint32_t FRAME_MAGIC = 0x46434652;    // "RFCF"
+
+enum class Status : uint32_t {
+    Ok = 0,
+    BadRequest = 1,     // Invalid tile/block/size/repeat
+    CaptureFailed = 2
+};
+
+struct Request {
+    uint32_t magic = REQUEST_MAGIC;
+    uint32_t id = 0;                // Echoed in every frame
+    uint32_t tile = 0;
+    uint32_t block = 0;
+    uint32_t num_samples = 0;       // Per lane
+    uint32_t repeat = 1;            // Back-to-back captures
+};
+
+struct FrameHeader {
+    uint32_t magic = FRAME_MAGIC;
+    uint32_t request_id = 0;
+    uint32_t index = 0;             // 0 .. repeat-1
+    uint32_t status = 0;            // Status
+    uint32_t tile = 0;
+    uint32_t block = 0;
+    uint32_t lanes = 0;             // 1 = REAL, 2 = I/Q, 0 on error
+    uint32_t num_samples = 0;       // Per lane
+    uint64_t timestamp_ns = 0;
+    double sample_rate_hz = 0.0;
+    uint64_t payload_bytes = 0;
+};
+
+static_assert(sizeof(Request) == 24, "Request is part of the wire format");
+static_assert(sizeof(FrameHeader) == 56, "FrameHeader is part of the wire format");
+
+/**
+ * @brief One capture produced by the handler
+ */
+struct Block {
+    buffer_pool::SampleVector I;
+    buffer_pool::SampleVector Q;    // Empty for REAL captures
+    uint64_t timestamp_ns = 0;
+    double sample_rate_hz = 0.0;
+};
+
+/**
+ * @brief Performs one capture; called `repeat` times per request
+ *
+ * Throw std::invalid_argument for a bad request and any other exception
+ * for a failed capture; the message is sent to the client.
+ */
+using CaptureHandler = std::function<void(const Request&, Block&)>;
+
+struct Options {
+    size_t max_clients = 8;
+    uint32_t max_samples = 16 * 1024;   // Per lane
+    uint32_t max_repeat = 1u << 20;
+    size_t send_queue_depth = 4;        // Captured frames waiting per client
+};
+
+struct Stats {
+    uint64_t connections = 0;
+    uint64_t requests = 0;
+    uint64_t frames = 0;
+    uint64_t errors = 0;
+    uint64_t bytes = 0;                 // Payload bytes sent
+};
+
+class Server {
+public:
+    Server(const std::string& socket_path, CaptureHandler handler,
+           const Options& options = Options());
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief Bind the socket and start accepting clients
+     * @return true on success
+     */
+    bool start();
+
+    /**
+     * @brief Disconnect all clients, stop accepting and remove the socket
+     */
+    void stop();
+
+    bool running() const { return running_; }
+    const std::string& socket_path() const { return path_; }
+    Stats stats() const;
+
+private:
+    struct Connection;
+
+    std::string path_;
+    CaptureHandler handler_;
+    Options options_;
+    int listen_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread accept_thread_;
+
+    std::mutex connections_mutex_;
+    std::list<std::unique_ptr<Connection>> connections_;
+
+    std::atomic<uint64_t> connections_total_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> bytes_{0};
+
+    void accept_loop();
+    void reap(bool all);
+    void serve(Connection& conn);
+    void send_loop(Connection& conn);
+    bool queue_frame(Connection& conn, const FrameHeader& header,
+                     Block&& block, std::string&& error);
+};
+
+/**
+ * @brief Blocking client (tests and local tools)
+ */
+class Client {
+public:
+    Client() = default;
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    bool connect(const std::string& socket_path);
+    void close();
+    bool is_open() const { return fd_ >= 0; }
+
+    /**
+     * @brief Send a request without waiting for its frames
+     */
+    bool send(const Request& request);
+
+    /**
+     * @brief Receive the next frame
+     * @param header Frame header
+     * @param I I (or REAL) samples
+     * @param Q Q samples (cleared for REAL frames)
+     * @param error Error message for non-OK frames (optional)
+     * @return false if the connection failed or the stream is malformed
+     */
+    bool receive(FrameHeader& header,
+                 buffer_pool::SampleVector& I,
+                 buffer_pool::SampleVector& Q,
+                 std::string* error = nullptr);
+
+private:
+    int fd_ = -1;
+};
+
+} // namespace capture_server
@@ -0,0 +1,284 @@
+#include "CaptureWriter.hpp"
+#include "SampleKernels.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace capture_writer {
+
+namespace {
+
+constexpr size_t IO_ALIGNMENT = 4096;
+
+size_t staging_size(size_t chunk_bytes)
+{
+    return std::max(IO_ALIGNMENT, chunk_bytes & ~(IO_ALIGNMENT - 1));
+}
+
+/**
+ * Append-only file fed through a page-aligned staging buffer, so every
+ * write() is a full, aligned chunk (as O_DIRECT requires). The last
+ * partial chunk is padded for the write and trimmed with ftruncate().
+ */
+class AlignedFile {
+public:
+    AlignedFile(uint8_t* staging, size_t chunk_bytes)
+        : chunk_(chunk_bytes)
+        , buf_(staging)
+    {
+    }
+
+    ~AlignedFile()
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    bool open(const std::string& path, bool direct)
+    {
+        if (!buf_) {
+            return false;
+        }
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        direct_ = false;
+        if (direct) {
+            fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+            direct_ = fd_ >= 0;
+        }
+        if (fd_ < 0) {
+            // Not requested, or the filesystem (e.g. tmpfs) refuses O_DIRECT
+            fd_ = ::open(path.c_str(), flags, 0644);
+        }
+        if (fd_ < 0) {
+            perror(("open " + path).c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Staging space the caller may fill directly, then commit()
+    uint8_t* space() { return buf_ + fill_; }
+    size_t space_bytes() const { return chunk_ - fill_; }
+
+    bool commit(size_t bytes)
+    {
+        fill_ += bytes;
+        logical_ += bytes;
+        return fill_ < chunk_ || flush_chunk(chunk_);
+    }
+
+    bool append(const void* data, size_t bytes)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        while (bytes > 0) {
+            size_t n = std::min(bytes, space_bytes());
+            std::memcpy(space(), p, n);
+            if (!commit(n)) {
+                return false;
+            }
+            p += n;
+            bytes -= n;
+        }
+        return true;
+    }
+
+    bool close()
+    {
+        bool ok = true;
+        if (fill_ > 0) {
+            size_t padded = (fill_ + IO_ALIGNMENT - 1) & ~(IO_ALIGNMENT - 1);
+            std::memset(buf_ + fill_, 0, padded - fill_);
+            ok = flush_chunk(padded);
+        }
+        if (ok && ftruncate(fd_, static_cast<off_t>(logical_)) != 0) {
+            ok = false;
+        }
+        if (::close(fd_) != 0) {
+            ok = false;
+        }
+        fd_ = -1;
+        return ok;
+    }
+
+    bool direct() const { return direct_; }
+
+private:
+    size_t chunk_;
+    uint8_t* buf_ = nullptr;
+    size_t fill_ = 0;
+    size_t logical_ = 0;
+    int fd_ = -1;
+    bool direct_ = false;
+
+    bool flush_chunk(size_t bytes)
+    {
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t n = ::write(fd_, buf_ + done, bytes - done);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                perror("capture write");
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        fill_ = 0;
+        return true;
+    }
+};
+
+} // namespace
+
+CaptureWriter::CaptureWriter(const Options& options, Sink sink)
+    : options_(options)
+    , sink_(std::move(sink))
+    , queue_(options.queue_depth)
+{
+    // Reused by every record; the writer thread is its only user
+    void* buf = nullptr;
+    if (posix_memalign(&buf, IO_ALIGNMENT, staging_size(options_.write_chunk)) == 0) {
+        staging_ = static_cast<uint8_t*>(buf);
+    }
+    thread_ = std::thread(&CaptureWriter::run, this);
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    flush();
+    stop_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    std::free(staging_);
+}
+
+bool CaptureWriter::submit(Record&& record)
+{
+    submitted_++;
+
+    bool stalled = false;
+    while (!queue_.try_push(std::move(record))) {
+        if (options_.backpressure == Backpressure::Drop) {
+            dropped_++;
+            return false;
+        }
+        if (!stalled) {
+            stalls_++;
+            stalled = true;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    size_t depth = queue_.size();
+    size_t seen = high_water_.load(std::memory_order_relaxed);
+    while (depth > seen && !high_water_.compare_exchange_weak(seen, depth)) {
+    }
+    return true;
+}
+
+void CaptureWriter::flush()
+{
+    for (;;) {
+        uint64_t accepted = submitted_.load() - dropped_.load();
+        if (written_.load() + failed_.load() >= accepted) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+Stats CaptureWriter::stats() const
+{
+    Stats s;
+    s.submitted = submitted_.load();
+    s.written = written_.load();
+    s.dropped = dropped_.load();
+    s.failed = failed_.load();
+    s.stalls = stalls_.load();
+    s.bytes = bytes_.load();
+    s.write_ms = write_ns_.load() / 1e6;
+    s.high_water = high_water_.load();
+    s.direct_io = direct_active_.load();
+    return s;
+}
+
+void CaptureWriter::run()
+{
+    Record record;
+    for (;;) {
+        if (!queue_.try_pop(record)) {
+            if (stop_) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = write_binary(record) && (!sink_ || sink_(record));
+        auto t1 = std::chrono::steady_clock::now();
+
+        write_ns_ += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        if (ok) {
+            bytes_ += (record.I.size() + record.Q.size()) * sizeof(int16_t);
+            written_++;
+        } else {
+            std::cerr << "    ✗ Failed to record " << record.base_name << "\n";
+            failed_++;
+        }
+
+        // Hand the pooled buffers back now rather than at the next pop
+        record = Record();
+    }
+}
+
+bool CaptureWriter::write_binary(const Record& record)
+{
+    const bool iq = !record.Q.empty();
+    if (iq && record.Q.size() != record.I.size()) {
+        return false;
+    }
+
+    const std::string path = record.base_name + (iq ? ".ci16" : ".i16");
+    AlignedFile file(staging_, staging_size(options_.write_chunk));
+    if (!file.open(path, options_.direct_io)) {
+        return false;
+    }
+    direct_active_ = file.direct();
+
+    bool ok = true;
+    if (!iq) {
+        ok = file.append(record.I.data(), record.I.size() * sizeof(int16_t));
+    } else {
+        // Interleave straight into the staging buffer
+        const size_t frame = 2 * sizeof(int16_t);
+        size_t n = 0;
+        while (ok && n < record.I.size()) {
+            size_t count = std::min(file.space_bytes() / frame, record.I.size() - n);
+            kernels::merge_iq(record.I.data() + n, record.Q.data() + n,
+                              reinterpret_cast<int16_t*>(file.space()), count);
+            ok = file.commit(count * frame);
+            n += count;
+        }
+    }
+    ok = file.close() && ok;
+    if (!ok) {
+        return false;
+    }
+
+    capture_file::Metadata meta = record.meta;
+    meta.format = iq ? "ci16" : "i16";
+    meta.num_samples = record.I.size();
+    return capture_file::write_metadata(path + ".json", meta);
+}
+
+} // namespace capture_writer
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BufferPool.hpp"
+#include "CaptureFile.hpp"
+
+namespace capture_writer {
+
+/**
+ * @brief Bounded single-producer/single-consumer ring, lock-free
+ *
+ * One thread may push and one other thread may pop concurrently. Capacity
+ * is rounded up to a power of two.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        slots_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    bool try_push(T&& item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_) {
+            return false;   // Full
+        }
+        slots_[head & mask_] = std::move(item);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;   // Empty
+        }
+        item = std::move(slots_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};   // Producer
+    alignas(64) std::atomic<size_t> tail_{0};   // Consumer
+};
+
+/**
+ * @brief One capture handed to the writer (buffers are moved, not copied)
+ */
+struct Record {
+    std::string base_name;              // Output path without extension
+    buffer_pool::SampleVector I;
+    buffer_pool::SampleVector Q;        // Empty for REAL captures
+    capture_file::Metadata meta;
+};
+
+enum class Backpressure {
+    Block,      // submit() waits for queue space
+    Drop        // submit() drops the record and counts it
+};
+
+struct Options {
+    size_t queue_depth = 64;
+    Backpressure backpressure = Backpressure::Block;
+    bool direct_io = false;             // O_DIRECT (falls back if unsupported)
+    size_t write_chunk = 1024 * 1024;   // Staging size per write() (multiple of 4096)
+};
+
+struct Stats {
+    uint64_t submitted = 0;
+    uint64_t written = 0;
+    uint64_t dropped = 0;
+    uint64_t failed = 0;
+    uint64_t stalls = 0;                // submit() calls that had to wait
+    uint64_t bytes = 0;                 // Sample bytes written
+    double write_ms = 0.0;              // Time spent in the sink
+    size_t high_water = 0;              // Deepest queue seen
+    bool direct_io = false;             // O_DIRECT actually in use
+
+    double mb_per_s() const { return write_ms > 0.0 ? bytes / (write_ms * 1e3) : 0.0; }
+};
+
+// Extra output written after the binary file (e.g. CSV); return false on failure
+using Sink = std::function<bool(const Record&)>;
+
+/**
+ * @brief Background capture-to-disk writer
+ *
+ * The capture loop submits filled buffers and moves on; a dedicated thread
+ * drains the queue to disk. Every record is written in the capture_file
+ * binary format (data + JSON sidecar) through a page-aligned staging buffer
+ * in write_chunk-sized writes, optionally with O_DIRECT; an optional sink
+ * then adds its own output next to it.
+ */
+class CaptureWriter {
+public:
+    /**
+     * @brief Start the writer thread
+     * @param options Queue depth, backpressure policy, I/O mode
+     * @param sink Extra output after the binary file, or nullptr for none
+     */
+    explicit CaptureWriter(const Options& options = Options(), Sink sink = nullptr);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * @brief Queue a capture for writing
+     * @param record Capture; moved from only if accepted
+     * @return false if the record was dropped (Drop policy, queue full)
+     */
+    bool submit(Record&& record);
+
+    /**
+     * @brief Wait until every accepted record has been written
+     */
+    void flush();
+
+    Stats stats() const;
+    const Options& options() const { return options_; }
+
+private:
+    Options options_;
+    Sink sink_;
+    SpscQueue<Record> queue_;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    uint8_t* staging_ = nullptr;        // Page-aligned write_chunk buffer
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> stalls_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> write_ns_{0};
+    std::atomic<size_t> high_water_{0};
+    std::atomic<bool> direct_active_{false};
+
+    void run();
+    bool write_binary(const Record& record);
+};
+
+} // namespace capture_writer
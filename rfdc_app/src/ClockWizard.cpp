@@ -1,10 +1,25 @@
 #include "ClockWizard.hpp"
+#include "LockWait.hpp"
 #include <iostream>
 #include <cmath>
 #include <unistd.h>
 
 namespace clock_wizard {
 
+namespace {
+
+// Same label as RFDC::mmcm_reset: one row per MMCM in the lock statistics
+bool wait_for_lock(const mmio::Block& clk, rfdc::TileType type, uint32_t tile_id)
+{
+    const std::string label = std::string("MMCM ") +
+        (type == rfdc::TileType::DAC ? "DAC " : "ADC ") + std::to_string(tile_id);
+    return lock_wait::wait(label,
+                           [&] { return clk.read(mmio::clk_wiz::STATUS_LOCKED) != 0; },
+                           lock_wait::mmcm_policy()).locked;
+}
+
+} // namespace
+
 ClockWizard::ClockWizard(rfdc::RFDC* rfdc)
     : rfdc_(rfdc)
 {
@@ -19,22 +34,13 @@ void* ClockWizard::get_clk_wiz_base(rfdc::TileType type, uint32_t tile_id) {
     return rfdc_->get_clk_wiz_base(type, tile_id);
 }
 
-void ClockWizard::write_reg(void* base, uint32_t offset, uint32_t value) {
-    // Fix: use reinterpret_cast for pointer arithmetic, then cast to volatile
-    char* byte_ptr = static_cast<char*>(base) + offset;
-    volatile uint32_t* reg = reinterpret_cast<volatile uint32_t*>(byte_ptr);
-    *reg = value;
-}
-
-uint32_t ClockWizard::read_reg(void* base, uint32_t offset) 
-{
-    // Fix: use reinterpret_cast for pointer arithmetic, then cast to volatile
-    char* byte_ptr = static_cast<char*>(base) + offset;
-    volatile uint32_t* reg = reinterpret_cast<volatile uint32_t*>(byte_ptr);
-    return *reg;
+mmio::Block ClockWizard::regs(rfdc::TileType type, uint32_t tile_id) {
+    return mmio::Block(get_clk_wiz_base(type, tile_id),
+                       type == rfdc::TileType::DAC ? "clk_wiz_dac" : "clk_wiz_adc");
 }
 
 bool ClockWizard::program_mmcm(rfdc::TileType type, uint32_t tile_id) {
+    mmio::Operation op("clk_wiz.program_mmcm");
     std::cout << "  Programming MMCM for " 
               << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
               << " Tile " << tile_id << "...\n";
@@ -318,60 +324,62 @@ bool ClockWizard::reprogram_hw(rfdc::TileType type, uint32_t tile_id,
                                uint32_t mult, uint32_t mult_frac, uint32_t div,
                                uint32_t clkout0_div, uint32_t clkout0_frac)
 {
-    void* base = get_clk_wiz_base(type, tile_id);
-    if (!base) {
+    using namespace mmio::clk_wiz;
+    const mmio::Block clk = regs(type, tile_id);
+    if (!clk.valid()) {
         std::cerr << "Invalid clock wizard base address\n";
         return false;
     }
     
     usleep(100);
     
-    // Write CLK_CONFIG0: [31:16]=mult_frac, [15:8]=mult, [7:0]=div
-    uint32_t clk_conf0 = (mult_frac << 16) | (mult << 8) | div;
-    write_reg(base, MMCM_CLK_CONFIG0_REG, clk_conf0);
+    // CLK_CONFIG0: [25:16]=mult_frac, [15:8]=mult, [7:0]=div
+    mmio::Batch config;
+    config.set(clk, CONFIG0_DIVCLK, div)
+          .set(clk, CONFIG0_MULT, mult)
+          .set(clk, CONFIG0_MULT_FRAC, mult_frac)
+          .apply();
     
     usleep(100);
     
-    // Write CLKOUT0: [15:8]=clkout0_frac, [7:0]=clkout0_div
-    uint32_t clkout0 = (clkout0_frac << 8) | clkout0_div;
-    write_reg(base, MMCM_CLKOUT0_REG, clkout0);
-    
-    // Write CLKOUT1: always half of CLKOUT0
-    write_reg(base, MMCM_CLKOUT1_REG, clkout0_div << 1);
+    // CLKOUT0: [17:8]=clkout0_frac, [7:0]=clkout0_div; CLKOUT1 runs at half of it
+    mmio::Batch outputs;
+    outputs.set(clk, CLKOUT0_DIV, clkout0_div)
+           .set(clk, CLKOUT0_FRAC, clkout0_frac)
+           .set(clk, CLKOUT1_DIV, clkout0_div << 1)
+           .apply();
     
     usleep(100);
     
     // Load new configuration
-    write_reg(base, MMCM_LOAD_REG, 0x03);
-    
-    usleep(100);
+    clk.write(LOAD, LOAD_APPLY);
     
-    // Check lock
-    uint32_t status = read_reg(base, MMCM_STATUS_REG);
-    return (status & 0x00000001) != 0;
+    return wait_for_lock(clk, type, tile_id);
 }
 
 bool ClockWizard::reset_hw(rfdc::TileType type, uint32_t tile_id) {
-    void* base = get_clk_wiz_base(type, tile_id);
-    if (!base) {
+    using namespace mmio::clk_wiz;
+    mmio::Operation op("clk_wiz.reset");
+    const mmio::Block clk = regs(type, tile_id);
+    if (!clk.valid()) {
         return false;
     }
     
     // Read current config to preserve settings
-    uint32_t clk_conf0 = read_reg(base, MMCM_CLK_CONFIG0_REG);
-    uint32_t clkout0 = read_reg(base, MMCM_CLKOUT0_REG);
+    uint32_t clk_conf0 = clk.read(CLK_CONFIG0);
+    uint32_t clkout0 = clk.read(CLKOUT0);
     
     // Reset
-    write_reg(base, MMCM_RESET_REG, 0x0A);
+    clk.write(RESET, RESET_KEY);
     usleep(100);
     
     // Restore config
-    write_reg(base, MMCM_CLK_CONFIG0_REG, clk_conf0);
-    write_reg(base, MMCM_CLKOUT0_REG, clkout0);
+    mmio::Batch restore;
+    restore.write(clk, CLK_CONFIG0, clk_conf0)
+           .write(clk, CLKOUT0, clkout0)
+           .apply();
     
-    // Check lock
-    uint32_t status = read_reg(base, MMCM_STATUS_REG);
-    return (status & 0x00000001) != 0;
+    return wait_for_lock(clk, type, tile_id);
 }
 
 bool ClockWizard::reset_mmcm(rfdc::TileType type, uint32_t tile_id) {
@@ -381,29 +389,28 @@ bool ClockWizard::reset_mmcm(rfdc::TileType type, uint32_t tile_id) {
 ClockWizard::MMCMConfig ClockWizard::get_mmcm_config(rfdc::TileType type, uint32_t tile_id) {
     MMCMConfig config = {};
     
-    void* base = get_clk_wiz_base(type, tile_id);
-    if (!base) {
+    using namespace mmio::clk_wiz;
+    const mmio::Block clk = regs(type, tile_id);
+    if (!clk.valid()) {
         return config;
     }
     
     // Read lock status
-    uint32_t status = read_reg(base, MMCM_STATUS_REG);
-    config.locked = (status & 0x00000001) != 0;
+    config.locked = clk.read(STATUS_LOCKED) != 0;
     
     // Read CLK_CONFIG0
-    uint32_t clk_conf0 = read_reg(base, MMCM_CLK_CONFIG0_REG);
-    config.mult_frac = (clk_conf0 >> 16) & 0x03FF;
-    config.mult = (clk_conf0 >> 8) & 0x00FF;
-    config.div = clk_conf0 & 0x00FF;
+    uint32_t clk_conf0 = clk.read(CLK_CONFIG0);
+    config.mult_frac = CONFIG0_MULT_FRAC.decode(clk_conf0);
+    config.mult = CONFIG0_MULT.decode(clk_conf0);
+    config.div = CONFIG0_DIVCLK.decode(clk_conf0);
     
     // Read CLKOUT0
-    uint32_t clkout0 = read_reg(base, MMCM_CLKOUT0_REG);
-    config.clkout0_div = clkout0 & 0x00FF;
-    config.clkout0_frac = (clkout0 >> 8) & 0x03FF;
+    uint32_t clkout0 = clk.read(CLKOUT0);
+    config.clkout0_div = CLKOUT0_DIV.decode(clkout0);
+    config.clkout0_frac = CLKOUT0_FRAC.decode(clkout0);
     
     // Read CLKOUT1
-    uint32_t clkout1 = read_reg(base, MMCM_CLKOUT1_REG);
-    config.clkout1_div = clkout1 & 0x00FF;
+    config.clkout1_div = clk.read(CLKOUT1_DIV);
     
     // Calculate frequencies
     uint32_t idx = (type == rfdc::TileType::DAC) ? (4 + tile_id) : tile_id;
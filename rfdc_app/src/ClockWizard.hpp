@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory>
 #include "rfdc_wrapper/RfDc.hpp"
+#include "Mmio.hpp"
 
 namespace clock_wizard {
 
@@ -28,13 +29,13 @@ public:
         bool locked;            // MMCM lock status
     };
     
-    // MMCM register offsets
-    static constexpr uint32_t MMCM_STATUS_REG = 0x04;
-    static constexpr uint32_t MMCM_CLK_CONFIG0_REG = 0x200;
-    static constexpr uint32_t MMCM_CLKOUT0_REG = 0x208;
-    static constexpr uint32_t MMCM_CLKOUT1_REG = 0x214;
-    static constexpr uint32_t MMCM_LOAD_REG = 0x25C;
-    static constexpr uint32_t MMCM_RESET_REG = 0x00;
+    // MMCM register offsets (fields in mmio::clk_wiz)
+    static constexpr uint32_t MMCM_STATUS_REG = mmio::clk_wiz::STATUS;
+    static constexpr uint32_t MMCM_CLK_CONFIG0_REG = mmio::clk_wiz::CLK_CONFIG0;
+    static constexpr uint32_t MMCM_CLKOUT0_REG = mmio::clk_wiz::CLKOUT0;
+    static constexpr uint32_t MMCM_CLKOUT1_REG = mmio::clk_wiz::CLKOUT1;
+    static constexpr uint32_t MMCM_LOAD_REG = mmio::clk_wiz::LOAD;
+    static constexpr uint32_t MMCM_RESET_REG = mmio::clk_wiz::RESET;
     
     // MMCM specification limits (MHz)
     static constexpr double FPD_MAX = 450.0;
@@ -132,14 +133,9 @@ private:
     void* get_clk_wiz_base(rfdc::TileType type, uint32_t tile_id);
     
     /**
-     * @brief Write to MMCM register
+     * @brief Register block of a tile's clock wizard (invalid if unmapped)
      */
-    void write_reg(void* base, uint32_t offset, uint32_t value);
-    
-    /**
-     * @brief Read from MMCM register
-     */
-    uint32_t read_reg(void* base, uint32_t offset);
+    mmio::Block regs(rfdc::TileType type, uint32_t tile_id);
 };
 
 } // namespace clock_wizard
\ No newline at end of file
@@ -0,0 +1,807 @@
+#include "ConverterConfig.hpp"
+#include "LockWait.hpp"
+#include "StreamFormat.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace converter_config {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double RATE_TOLERANCE_MHZ = 1e-3;
+constexpr double NCO_TOLERANCE_MHZ = 1e-6;      // NCO frequency quantisation
+constexpr double PHASE_TOLERANCE = 1e-3;
+
+// ===== Parsing =====
+
+std::string trim(const std::string& s)
+{
+    size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+std::string lower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+std::vector<std::string> split_key(const std::string& key)
+{
+    std::vector<std::string> parts;
+    std::stringstream ss(key);
+    std::string part;
+    while (std::getline(ss, part, '.')) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+// "*" selects 0..3, a digit selects itself
+bool parse_index(const std::string& s, uint32_t& first, uint32_t& last)
+{
+    if (s == "*") {
+        first = 0;
+        last = 3;
+        return true;
+    }
+    if (s.size() == 1 && s[0] >= '0' && s[0] <= '3') {
+        first = last = static_cast<uint32_t>(s[0] - '0');
+        return true;
+    }
+    return false;
+}
+
+bool parse_bool(const std::string& v, bool& out)
+{
+    if (v == "on" || v == "true" || v == "yes" || v == "1") {
+        out = true;
+        return true;
+    }
+    if (v == "off" || v == "false" || v == "no" || v == "0") {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+bool parse_uint(const std::string& v, uint32_t& out)
+{
+    if (v.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    unsigned long value = std::strtoul(v.c_str(), &end, 0);
+    if (*end != '\0') {
+        return false;
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+bool parse_double(const std::string& v, double& out)
+{
+    if (v.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    double value = std::strtod(v.c_str(), &end);
+    if (*end != '\0') {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+template<typename T>
+struct Named {
+    const char* name;
+    T value;
+};
+
+template<typename T, size_t N>
+bool parse_named(const Named<T> (&table)[N], const std::string& v, T& out)
+{
+    for (const auto& entry : table) {
+        if (v == entry.name) {
+            out = entry.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+const Named<rfdc::MixerMode> MIXER_MODES[] = {
+    { "off", rfdc::MixerMode::Off }, { "c2c", rfdc::MixerMode::C2C },
+    { "c2r", rfdc::MixerMode::C2R }, { "r2c", rfdc::MixerMode::R2C },
+    { "r2r", rfdc::MixerMode::R2R },
+};
+
+const Named<rfdc::MixerType> MIXER_TYPES[] = {
+    { "off", rfdc::MixerType::Off }, { "coarse", rfdc::MixerType::Coarse },
+    { "fine", rfdc::MixerType::Fine }, { "disabled", rfdc::MixerType::Disabled },
+};
+
+const Named<uint32_t> COARSE_FREQS[] = {
+    { "off", XRFDC_COARSE_MIX_OFF },
+    { "fs/2", XRFDC_COARSE_MIX_SAMPLE_FREQ_BY_TWO },
+    { "fs/4", XRFDC_COARSE_MIX_SAMPLE_FREQ_BY_FOUR },
+    { "-fs/4", XRFDC_COARSE_MIX_MIN_SAMPLE_FREQ_BY_FOUR },
+    { "bypass", XRFDC_COARSE_MIX_BYPASS },
+};
+
+const Named<rfdc::EventSource> EVENT_SOURCES[] = {
+    { "immediate", rfdc::EventSource::Immediate }, { "slice", rfdc::EventSource::Slice },
+    { "tile", rfdc::EventSource::Tile }, { "sysref", rfdc::EventSource::SysRef },
+    { "marker", rfdc::EventSource::Marker }, { "pl", rfdc::EventSource::PL },
+};
+
+const Named<rfdc::DataPathMode> DATAPATH_MODES[] = {
+    { "full_nyquist", rfdc::DataPathMode::FullNyquistDucPass },
+    { "imr_low", rfdc::DataPathMode::IMRLowPass },
+    { "imr_high", rfdc::DataPathMode::IMRHighPass },
+    { "duc_pass", rfdc::DataPathMode::DUCPass },
+};
+
+bool set_tile_param(TileConfig& t, const std::string& param, const std::string& value,
+                    std::string& error)
+{
+    if (param == "configure") {
+        if (parse_bool(value, t.configure)) return true;
+    } else if (param == "sample_rate_mhz") {
+        if (parse_double(value, t.sample_rate_mhz) && t.sample_rate_mhz >= 0.0) return true;
+    } else if (param == "fifo") {
+        if (parse_bool(value, t.fifo)) return true;
+    } else {
+        error = "unknown tile setting '" + param + "'";
+        return false;
+    }
+    error = "invalid value '" + value + "' for " + param;
+    return false;
+}
+
+bool set_block_param(BlockConfig& b, rfdc::TileType type, const std::string& param,
+                     const std::string& value, std::string& error)
+{
+    const bool dac = (type == rfdc::TileType::DAC);
+    uint32_t n = 0;
+
+    if (param == "configure") {
+        if (parse_bool(value, b.configure)) return true;
+    } else if (param == "mixer.freq_mhz") {
+        if (parse_double(value, b.mixer.freq_mhz)) return true;
+    } else if (param == "mixer.phase") {
+        if (parse_double(value, b.mixer.phase)) return true;
+    } else if (param == "mixer.mode") {
+        if (parse_named(MIXER_MODES, value, b.mixer.mode)) return true;
+    } else if (param == "mixer.type") {
+        if (parse_named(MIXER_TYPES, value, b.mixer.type)) return true;
+    } else if (param == "mixer.coarse") {
+        if (parse_named(COARSE_FREQS, value, b.mixer.coarse_freq)) return true;
+    } else if (param == "mixer.event") {
+        if (parse_named(EVENT_SOURCES, value, b.mixer.event_source)) return true;
+    } else if (param == "nyquist_zone") {
+        if (parse_uint(value, n) && (n == 1 || n == 2)) {
+            b.nyquist_zone = static_cast<rfdc::NyquistZone>(n);
+            return true;
+        }
+    } else if (param == (dac ? "interpolation" : "decimation")) {
+        if (parse_uint(value, n) && n >= 1) {
+            b.factor = n;
+            return true;
+        }
+    } else if (dac && param == "datapath_mode") {
+        if (parse_named(DATAPATH_MODES, value, b.datapath_mode)) return true;
+        if (parse_uint(value, n) && n >= 1 && n <= 4) {
+            b.datapath_mode = static_cast<rfdc::DataPathMode>(n);
+            return true;
+        }
+    } else if (dac && param == "inverse_sinc") {
+        if (parse_uint(value, n) && n <= 2) {
+            b.inverse_sinc = static_cast<uint16_t>(n);
+            return true;
+        }
+    } else if (!dac && param == "calibration_mode") {
+        if (parse_uint(value, n) && (n == 1 || n == 2)) {
+            b.calibration_mode = static_cast<rfdc::CalibrationMode>(n);
+            return true;
+        }
+    } else {
+        error = std::string("unknown ") + (dac ? "DAC" : "ADC") + " block setting '" + param + "'";
+        return false;
+    }
+    error = "invalid value '" + value + "' for " + param;
+    return false;
+}
+
+bool set_param(Config& config, const std::string& key, const std::string& value,
+               std::string& error)
+{
+    std::vector<std::string> parts = split_key(key);
+
+    if (parts.size() == 2 && parts[0] == "clocks") {
+        uint32_t* field = parts[1] == "lmk"     ? &config.clocks.lmk
+                        : parts[1] == "lmx_adc" ? &config.clocks.lmx_adc
+                        : parts[1] == "lmx_dac" ? &config.clocks.lmx_dac
+                        : nullptr;
+        if (!field) {
+            error = "unknown clock setting '" + parts[1] + "'";
+            return false;
+        }
+        if (!parse_uint(value, *field)) {
+            error = "invalid value '" + value + "' for " + key;
+            return false;
+        }
+        return true;
+    }
+
+    if (parts.size() < 3 || (parts[0] != "dac" && parts[0] != "adc")) {
+        error = "unknown key '" + key + "'";
+        return false;
+    }
+    const rfdc::TileType type = parts[0] == "dac" ? rfdc::TileType::DAC : rfdc::TileType::ADC;
+
+    uint32_t tile_first, tile_last;
+    if (!parse_index(parts[1], tile_first, tile_last)) {
+        error = "invalid tile '" + parts[1] + "'";
+        return false;
+    }
+
+    // <type>.<tile>.<setting> or <type>.<tile>.<block>.<setting...>
+    uint32_t block_first = 0, block_last = 0;
+    const bool block_level = parts.size() > 3 || parse_index(parts[2], block_first, block_last);
+    if (block_level && !parse_index(parts[2], block_first, block_last)) {
+        error = "invalid block '" + parts[2] + "'";
+        return false;
+    }
+    if (block_level && parts.size() < 4) {
+        error = "missing block setting in '" + key + "'";
+        return false;
+    }
+    std::string param;
+    for (size_t i = block_level ? 3 : 2; i < parts.size(); ++i) {
+        param += (param.empty() ? "" : ".") + parts[i];
+    }
+
+    for (uint32_t t = tile_first; t <= tile_last; ++t) {
+        TileConfig& tile = config.tile(type, t);
+        if (!block_level) {
+            if (!set_tile_param(tile, param, value, error)) {
+                return false;
+            }
+            continue;
+        }
+        for (uint32_t b = block_first; b <= block_last; ++b) {
+            if (!set_block_param(tile.blocks[b], type, param, value, error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ===== Applying =====
+
+/**
+ * @brief Adds the scope's wall time to one row of the report
+ */
+class StepScope {
+public:
+    StepScope(Report& report, const char* name)
+        : report_(report), name_(name), start_(Clock::now()) {}
+
+    ~StepScope()
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+        auto it = std::find_if(report_.steps.begin(), report_.steps.end(),
+                               [this](const StepTiming& s) { return s.name == name_; });
+        if (it == report_.steps.end()) {
+            report_.steps.push_back(StepTiming{ name_, 0, std::chrono::nanoseconds(0) });
+            it = report_.steps.end() - 1;
+        }
+        it->count++;
+        it->time += elapsed;
+    }
+
+private:
+    Report& report_;
+    const char* name_;
+    Clock::time_point start_;
+};
+
+const char* type_name(rfdc::TileType type)
+{
+    return type == rfdc::TileType::DAC ? "DAC" : "ADC";
+}
+
+bool same_mixer(const rfdc::MixerSettings& have, const MixerConfig& want)
+{
+    if (have.mode() != want.mode || have.type() != want.type) {
+        return false;
+    }
+    if (want.type == rfdc::MixerType::Coarse) {
+        return have.coarse_mix_freq() == want.coarse_freq;
+    }
+    if (want.type == rfdc::MixerType::Fine) {
+        return std::fabs(have.frequency() - want.freq_mhz) <= NCO_TOLERANCE_MHZ &&
+               std::fabs(have.phase_offset() - want.phase) <= PHASE_TOLERANCE;
+    }
+    return true;
+}
+
+void merge_steps(Report& into, const Report& from)
+{
+    for (const auto& step : from.steps) {
+        auto it = std::find_if(into.steps.begin(), into.steps.end(),
+                               [&](const StepTiming& s) { return s.name == step.name; });
+        if (it == into.steps.end()) {
+            into.steps.push_back(step);
+        } else {
+            it->count += step.count;
+            it->time += step.time;
+        }
+    }
+}
+
+} // namespace
+
+Config defaults()
+{
+    Config config;
+    for (uint32_t tile = 0; tile < 4; ++tile) {
+        TileConfig& dac = config.dac[tile];
+        dac.sample_rate_mhz = 5898.24;
+        for (BlockConfig& b : dac.blocks) {
+            b.datapath_mode = rfdc::DataPathMode::FullNyquistDucPass;
+            b.mixer.mode = rfdc::MixerMode::C2C;
+            b.mixer.type = rfdc::MixerType::Fine;
+            b.factor = 2;
+            b.inverse_sinc = 0;
+        }
+
+        // ADC keeps the PLL rate from the clock presets
+        TileConfig& adc = config.adc[tile];
+        for (BlockConfig& b : adc.blocks) {
+            b.mixer.mode = rfdc::MixerMode::R2C;
+            b.mixer.type = rfdc::MixerType::Fine;
+            b.factor = 1;
+            b.calibration_mode = rfdc::CalibrationMode::Mode1;
+        }
+    }
+    return config;
+}
+
+bool parse(std::istream& in, const std::string& source, Config& config)
+{
+    Config next = config;
+    std::string line;
+    size_t line_no = 0;
+
+    while (std::getline(in, line)) {
+        ++line_no;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.erase(hash);
+        }
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        std::string error;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = "expected 'key = value'";
+        } else if (set_param(next, lower(trim(line.substr(0, eq))),
+                             lower(trim(line.substr(eq + 1))), error)) {
+            continue;
+        }
+        std::cerr << "  ✗ " << source << ":" << line_no << ": " << error << "\n";
+        return false;
+    }
+
+    config = next;
+    return true;
+}
+
+bool load(const std::string& path, Config& config)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "  ✗ Cannot open converter config " << path << "\n";
+        return false;
+    }
+    return parse(file, path, config);
+}
+
+// ===== Applier =====
+
+Applier::Applier(rfdc::RFDC& rfdc, clock_wizard::ClockWizard& clock_wiz, rfdc::RFClock* clock,
+                 worker_pool::WorkerPool* workers)
+    : rfdc_(rfdc)
+    , clock_wiz_(clock_wiz)
+    , clock_(clock)
+    , workers_(workers)
+{
+}
+
+void Applier::assume_clocks(const ClockConfig& clocks)
+{
+    clocks_ = clocks;
+    clocks_known_ = true;
+}
+
+// Per-tile state carried across the phases of one apply
+struct Applier::TileWork {
+    rfdc::TileType type;
+    rfdc::TileId tile;
+    const TileConfig* want;
+    bool restart = false;
+    bool pll_changed = false;
+    Report steps;               // Step timings of the parallel phase
+    TileTimeline timeline;
+};
+
+std::chrono::nanoseconds Applier::elapsed() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+}
+
+void Applier::note(const TileWork& w, const std::string& what, const Options& options)
+{
+    if (!options.verbose) {
+        return;
+    }
+    std::ostringstream line;
+    line << "    • " << type_name(w.type) << " " << w.tile << ": " << what << "\n";
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    std::cout << line.str();
+}
+
+Report Applier::apply(const Config& config, const Options& options)
+{
+    Report report;
+    start_ = Clock::now();
+
+    // Clock chips feed every tile PLL: new presets mean a full restart
+    bool restart_all = false;
+    if (clock_ && (options.force || !clocks_known_ || config.clocks != clocks_)) {
+        if (options.verbose) {
+            std::cout << "    • Clock presets: LMK " << config.clocks.lmk << ", LMX ADC "
+                      << config.clocks.lmx_adc << ", LMX DAC " << config.clocks.lmx_dac << "\n";
+        }
+        {
+            StepScope step(report, "clocks");
+            clock_->set_all_configs(config.clocks.lmk, config.clocks.lmx_adc, config.clocks.lmx_dac);
+        }
+        assume_clocks(config.clocks);
+        report.changes++;
+        restart_all = true;
+    }
+
+    rfdc::IPStatus ip = [&] {
+        StepScope step(report, "read_state");
+        return rfdc_.get_ip_status();
+    }();
+
+    std::vector<TileWork> work;
+    for (rfdc::TileType type : { rfdc::TileType::DAC, rfdc::TileType::ADC }) {
+        for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+            const TileConfig& want = config.tile(type, tile);
+            if (!want.configure || !rfdc_.check_tile_enabled(type, tile)) {
+                continue;
+            }
+            TileWork w;
+            w.type = type;
+            w.tile = tile;
+            w.want = &want;
+            w.restart = options.force || restart_all || !ip.tile_started(type, tile);
+            w.timeline.type = type;
+            w.timeline.tile = tile;
+            work.push_back(w);
+        }
+    }
+
+    // Phase 1: PLL rate and startup, every tile at once. The calls for
+    // different tiles go to separate tile register spaces.
+    auto issue = [&](size_t i) { issue_tile(work[i], options); };
+    if (workers_ && options.parallel && work.size() > 1) {
+        workers_->parallel_for(work.size(), issue);
+    } else {
+        for (size_t i = 0; i < work.size(); ++i) {
+            issue(i);
+        }
+    }
+    for (const auto& w : work) {
+        merge_steps(report, w.steps);
+    }
+
+    // Phase 2: one poll loop over all the PLLs still locking
+    wait_for_locks(work, report);
+
+    // Phase 3: blocks, MMCM and FIFO tile by tile (fast, and the MMCM
+    // programming reports on the console)
+    for (auto& w : work) {
+        configure_tile(w, options, report);
+        w.timeline.configured = elapsed();
+        report.changes += w.timeline.changes;
+        report.timeline.push_back(w.timeline);
+
+        if (options.verbose) {
+            uint32_t changes = w.timeline.changes;
+            std::cout << "  ✓ " << type_name(w.type) << " Tile " << w.tile;
+            if (changes) {
+                std::cout << " configured (" << changes << (changes == 1 ? " change)\n" : " changes)\n");
+            } else {
+                std::cout << " up to date\n";
+            }
+        }
+    }
+
+    report.total = elapsed();
+    return report;
+}
+
+void Applier::issue_tile(TileWork& w, const Options& options)
+{
+    const TileConfig& want = *w.want;
+
+    // PLL rate before startup: the dynamic PLL update restarts the tile itself
+    rfdc::PLLSettings pll = [&] {
+        StepScope step(w.steps, "read_state");
+        return rfdc_.get_pll_config(w.type, w.tile);
+    }();
+    if (want.sample_rate_mhz > 0.0 &&
+        (options.force || std::fabs(pll.sample_rate_mhz() - want.sample_rate_mhz) > RATE_TOLERANCE_MHZ)) {
+        std::ostringstream what;
+        what << "PLL " << pll.sample_rate_mhz() << " → " << want.sample_rate_mhz << " MHz";
+        note(w, what.str(), options);
+        StepScope step(w.steps, "pll");
+        rfdc_.set_pll_config(w.type, w.tile, rfdc::ClockSource::Internal,
+                             pll.ref_clk_freq(), want.sample_rate_mhz);
+        w.pll_changed = true;
+        w.timeline.changes++;
+    }
+
+    if (w.restart) {
+        note(w, "startup", options);
+        StepScope step(w.steps, "startup");
+        rfdc_.startup(w.type, w.tile);
+        w.timeline.changes++;
+    }
+    w.timeline.issued = elapsed();
+}
+
+void Applier::wait_for_locks(std::vector<TileWork>& work, Report& report)
+{
+    std::vector<TileWork*> pending;
+    for (auto& w : work) {
+        if (w.restart || w.pll_changed) {
+            pending.push_back(&w);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    StepScope step(report, "pll_lock");
+    lock_wait::Backoff backoff(lock_wait::pll_policy());
+    // Time to lock is counted from each tile's own issue, not from this loop
+    auto record = [&](TileWork& w, bool locked) {
+        lock_wait::Result result;
+        result.locked = locked;
+        result.time = elapsed() - w.timeline.issued;
+        result.polls = backoff.rounds();
+        lock_wait::record(std::string("PLL ") + type_name(w.type) + " " + std::to_string(w.tile),
+                          result);
+    };
+    do {
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (rfdc_.get_pll_lock_status((*it)->type, (*it)->tile)) {
+                (*it)->timeline.locked = elapsed();
+                record(**it, true);
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (pending.empty()) {
+            return;
+        }
+    } while (backoff.sleep());
+
+    for (TileWork* w : pending) {
+        record(*w, false);
+    }
+    std::ostringstream msg;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        msg << (i ? ", " : "") << type_name(pending[i]->type) << " Tile " << pending[i]->tile;
+    }
+    msg << (pending.size() == 1 ? " PLL failed to lock" : " PLLs failed to lock");
+    throw rfdc::RFDCException(msg.str());
+}
+
+void Applier::configure_tile(TileWork& w, const Options& options, Report& report)
+{
+    const rfdc::TileType type = w.type;
+    const rfdc::TileId tile = w.tile;
+    const TileConfig& want = *w.want;
+    const bool dac = (type == rfdc::TileType::DAC);
+    auto note = [&](const std::string& what) { this->note(w, what, options); };
+
+    // Anything that moves the fabric rate needs the MMCM redone
+    bool rate_changed = w.restart || w.pll_changed;
+
+    for (rfdc::BlockId block = 0; block < 4; ++block) {
+        const BlockConfig& b = want.blocks[block];
+        if (!b.configure || !rfdc_.check_block_enabled(type, tile, block)) {
+            continue;
+        }
+        auto block_note = [&](const std::string& what) {
+            note("block " + std::to_string(block) + " " + what);
+        };
+
+        rfdc::DataPathMode datapath = rfdc::DataPathMode::FullNyquistDucPass;
+        uint32_t factor = 0;
+        uint16_t inverse_sinc = 0;
+        rfdc::CalibrationMode calibration = rfdc::CalibrationMode::Mode1;
+        rfdc::MixerSettings mixer;
+        rfdc::NyquistZone zone = rfdc::NyquistZone::Zone1;
+        {
+            StepScope step(report, "read_state");
+            if (dac) {
+                datapath = rfdc_.get_datapath_mode(tile, block);
+                factor = rfdc_.get_interpolation_factor(tile, block);
+                inverse_sinc = rfdc_.get_inverse_sinc_filter(tile, block);
+            } else {
+                factor = rfdc_.get_decimation_factor(tile, block);
+                calibration = rfdc_.get_calibration_mode(tile, block);
+            }
+            mixer = rfdc_.get_mixer_settings(type, tile, block);
+            zone = rfdc_.get_nyquist_zone(type, tile, block);
+        }
+
+        if (dac && (options.force || datapath != b.datapath_mode)) {
+            block_note("datapath mode " + std::to_string(static_cast<uint32_t>(b.datapath_mode)));
+            StepScope step(report, "datapath");
+            rfdc_.set_datapath_mode(tile, block, b.datapath_mode);
+            rate_changed = true;
+            w.timeline.changes++;
+        }
+
+        if (options.force || factor != b.factor) {
+            block_note(std::string(dac ? "interpolation " : "decimation ") +
+                       std::to_string(factor) + "x → " + std::to_string(b.factor) + "x");
+            StepScope step(report, "factor");
+            if (dac) {
+                rfdc_.set_interpolation_factor(tile, block, b.factor);
+            } else {
+                rfdc_.set_decimation_factor(tile, block, b.factor);
+            }
+            rate_changed = true;
+            w.timeline.changes++;
+        }
+
+        bool mixer_changed = false;
+        if (options.force || !same_mixer(mixer, b.mixer)) {
+            std::ostringstream what;
+            what << "mixer " << rfdc_.to_string(b.mixer.type) << " " << rfdc_.to_string(b.mixer.mode)
+                 << " " << b.mixer.freq_mhz << " MHz";
+            block_note(what.str());
+            StepScope step(report, "mixer");
+            rfdc_.set_mixer_settings(type, tile, block, rfdc::MixerSettings(
+                b.mixer.freq_mhz, b.mixer.phase, b.mixer.event_source, b.mixer.coarse_freq,
+                b.mixer.mode, 0, b.mixer.type));
+            mixer_changed = true;
+            w.timeline.changes++;
+        }
+
+        if (options.force || zone != b.nyquist_zone) {
+            block_note("Nyquist zone " + std::to_string(static_cast<uint32_t>(b.nyquist_zone)));
+            StepScope step(report, "nyquist");
+            rfdc_.set_nyquist_zone(type, tile, block, b.nyquist_zone);
+            w.timeline.changes++;
+        }
+
+        if (dac && (options.force || inverse_sinc != b.inverse_sinc)) {
+            block_note("inverse sinc " + std::to_string(b.inverse_sinc));
+            StepScope step(report, "inverse_sinc");
+            rfdc_.set_inverse_sinc_filter(tile, block, b.inverse_sinc);
+            w.timeline.changes++;
+        }
+
+        if (!dac && (options.force || calibration != b.calibration_mode)) {
+            block_note("calibration mode " + std::to_string(static_cast<uint32_t>(b.calibration_mode)));
+            StepScope step(report, "calibration");
+            rfdc_.set_calibration_mode(tile, block, b.calibration_mode);
+            w.timeline.changes++;
+        }
+
+        // New mixer settings take effect on the mixer event
+        if (mixer_changed) {
+            StepScope step(report, "mixer_event");
+            if (dac) {
+                rfdc_.reset_nco_phase(type, tile, block);
+            }
+            rfdc_.update_event(type, tile, block, XRFDC_EVENT_MIXER);
+        }
+    }
+
+    bool mmcm_locked = false;
+    bool fifo_on = false;
+    {
+        StepScope step(report, "read_state");
+        mmcm_locked = clock_wiz_.get_mmcm_config(type, tile).locked;
+        fifo_on = rfdc_.get_fifo_status(type, tile);
+    }
+
+    if (options.force || rate_changed || !mmcm_locked) {
+        if (fifo_on) {
+            StepScope step(report, "fifo");
+            rfdc_.setup_fifo(type, tile, false);
+            fifo_on = false;
+        }
+        note(mmcm_locked ? "MMCM (fabric rate changed)" : "MMCM (not locked)");
+        StepScope step(report, "mmcm");
+        if (!clock_wiz_.program_mmcm(type, tile)) {
+            std::cerr << "    ✗ MMCM programming failed\n";
+        }
+        w.timeline.changes++;
+    }
+
+    if (options.force || fifo_on != want.fifo) {
+        note(want.fifo ? "FIFO on" : "FIFO off");
+        StepScope step(report, "fifo");
+        rfdc_.setup_fifo(type, tile, want.fifo);
+        w.timeline.changes++;
+    }
+}
+
+void print_report(const Report& report, std::ostream& os)
+{
+    stream_format::Restore restore(os);
+    os << std::fixed;
+    os << "  " << std::left << std::setw(16) << "Step" << std::right
+       << std::setw(7) << "calls" << std::setw(12) << "total ms" << std::setw(12) << "mean us" << "\n";
+    for (const auto& s : report.steps) {
+        double ms = std::chrono::duration<double, std::milli>(s.time).count();
+        os << "  " << std::left << std::setw(16) << s.name << std::right
+           << std::setw(7) << s.count << std::setw(12) << std::setprecision(3) << ms
+           << std::setw(12) << std::setprecision(1) << (s.count ? ms * 1000.0 / s.count : 0.0) << "\n";
+    }
+
+    if (!report.timeline.empty()) {
+        auto ms = [](std::chrono::nanoseconds t) { return std::chrono::duration<double, std::milli>(t).count(); };
+        os << "\n  " << std::left << std::setw(10) << "Tile" << std::right << std::setw(10) << "issued"
+           << std::setw(10) << "locked" << std::setw(12) << "configured" << std::setw(9) << "changes"
+           << "   (ms from start)\n";
+        for (const auto& t : report.timeline) {
+            os << "  " << std::left << std::setw(10)
+               << (std::string(type_name(t.type)) + " " + std::to_string(t.tile)) << std::right
+               << std::setprecision(1) << std::setw(10) << ms(t.issued) << std::setw(10);
+            if (t.locked.count() > 0) {
+                os << ms(t.locked);
+            } else {
+                os << "-";
+            }
+            os << std::setw(12) << ms(t.configured) << std::setw(9) << t.changes << "\n";
+        }
+    }
+    os << "  " << report.changes << " changes in " << std::setprecision(1)
+       << std::chrono::duration<double, std::milli>(report.total).count() << " ms\n";
+}
+
+} // namespace converter_config
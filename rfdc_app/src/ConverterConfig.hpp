@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "rfdc_wrapper/RfDc.hpp"
+#include "rfdc_wrapper/RfClock.hpp"
+#include "ClockWizard.hpp"
+#include "WorkerPool.hpp"
+
+namespace converter_config {
+
+/**
+ * @brief Desired converter setup, per tile and block
+ *
+ * Describes the end state only; Applier works out which driver calls get
+ * there from what the hardware currently holds. defaults() is the I/Q
+ * setup the application has always brought up.
+ *
+ * Files are "key = value" lines, '#' starts a comment, later lines win:
+ *
+ *   clocks.lmk = 0                      # LMK04828 / LMX2594 presets
+ *   clocks.lmx_adc = 0
+ *   clocks.lmx_dac = 0
+ *   dac.*.sample_rate_mhz = 5898.24     # 0 keeps the current PLL rate
+ *   dac.*.fifo = on
+ *   dac.*.*.datapath_mode = full_nyquist
+ *   dac.*.*.interpolation = 2
+ *   dac.*.*.inverse_sinc = 0
+ *   adc.0.*.decimation = 1
+ *   adc.0.2.mixer.freq_mhz = 100.0
+ *   adc.*.*.mixer.mode = r2c            # off c2c c2r r2c r2r
+ *   adc.*.*.mixer.type = fine           # off coarse fine disabled
+ *   adc.*.*.mixer.coarse = bypass       # off fs/2 fs/4 -fs/4 bypass
+ *   adc.*.*.nyquist_zone = 1
+ *   adc.*.*.calibration_mode = 1
+ *   adc.3.configure = off               # leave the tile as it is
+ *
+ * Tile and block indices take '*' for all four.
+ */
+struct MixerConfig {
+    double freq_mhz = 0.0;
+    double phase = 0.0;
+    rfdc::MixerMode mode = rfdc::MixerMode::C2C;
+    rfdc::MixerType type = rfdc::MixerType::Fine;
+    uint32_t coarse_freq = XRFDC_COARSE_MIX_BYPASS;
+    rfdc::EventSource event_source = rfdc::EventSource::Tile;
+};
+
+struct BlockConfig {
+    bool configure = true;                  // false: leave the block untouched
+    MixerConfig mixer;
+    rfdc::NyquistZone nyquist_zone = rfdc::NyquistZone::Zone1;
+    uint32_t factor = 1;                    // Decimation (ADC) or interpolation (DAC)
+    // DAC only
+    rfdc::DataPathMode datapath_mode = rfdc::DataPathMode::FullNyquistDucPass;
+    uint16_t inverse_sinc = 0;
+    // ADC only
+    rfdc::CalibrationMode calibration_mode = rfdc::CalibrationMode::Mode1;
+};
+
+struct TileConfig {
+    bool configure = true;                  // false: leave the tile untouched
+    double sample_rate_mhz = 0.0;           // 0: keep the current PLL rate
+    bool fifo = true;
+    std::array<BlockConfig, 4> blocks;
+};
+
+struct ClockConfig {
+    uint32_t lmk = 0;
+    uint32_t lmx_adc = 0;
+    uint32_t lmx_dac = 0;
+
+    bool operator==(const ClockConfig& o) const {
+        return lmk == o.lmk && lmx_adc == o.lmx_adc && lmx_dac == o.lmx_dac;
+    }
+    bool operator!=(const ClockConfig& o) const { return !(*this == o); }
+};
+
+struct Config {
+    ClockConfig clocks;
+    std::array<TileConfig, 4> dac;
+    std::array<TileConfig, 4> adc;
+
+    TileConfig& tile(rfdc::TileType type, rfdc::TileId tile_id) {
+        return type == rfdc::TileType::DAC ? dac[tile_id] : adc[tile_id];
+    }
+    const TileConfig& tile(rfdc::TileType type, rfdc::TileId tile_id) const {
+        return type == rfdc::TileType::DAC ? dac[tile_id] : adc[tile_id];
+    }
+};
+
+/**
+ * @brief DAC I/Q at 5898.24 MSPS with 2x interpolation, ADC Fine mixer
+ *        Real→I/Q with 1x decimation, 0 MHz NCOs, FIFOs on
+ */
+Config defaults();
+
+/**
+ * @brief Apply a config file on top of `config`
+ * @param path File path
+ * @param config Starting point (normally defaults()); untouched on failure
+ * @return false if the file cannot be read or has an invalid line
+ */
+bool load(const std::string& path, Config& config);
+
+/**
+ * @brief Same as load(), from a stream; `source` names it in errors
+ */
+bool parse(std::istream& in, const std::string& source, Config& config);
+
+/**
+ * @brief Time spent in one kind of step during an apply
+ */
+struct StepTiming {
+    std::string name;
+    uint32_t count = 0;
+    std::chrono::nanoseconds time{0};
+};
+
+/**
+ * @brief When each tile got through the bring-up phases
+ *
+ * Times are from the start of the apply.
+ */
+struct TileTimeline {
+    rfdc::TileType type = rfdc::TileType::DAC;
+    rfdc::TileId tile = 0;
+    std::chrono::nanoseconds issued{0};     // PLL rate / startup calls returned
+    std::chrono::nanoseconds locked{0};     // PLL lock seen; 0 if no wait was needed
+    std::chrono::nanoseconds configured{0}; // Blocks, MMCM and FIFO done
+    uint32_t changes = 0;
+};
+
+struct Report {
+    std::vector<StepTiming> steps;          // In order of first use
+    std::vector<TileTimeline> timeline;     // Configured tiles, in bring-up order
+    uint32_t changes = 0;                   // Driver calls that changed state
+    std::chrono::nanoseconds total{0};
+};
+
+/**
+ * @brief Brings the converters to a Config with as few driver calls as possible
+ *
+ * For each configured tile the current state is read back (PLL rate, tile
+ * state, per block datapath, factor, mixer, Nyquist zone, inverse sinc,
+ * calibration mode, MMCM lock, FIFO) and only the differences are issued,
+ * in dependency order:
+ *
+ *   clocks → PLL rate → startup → PLL lock → datapath → factor → mixer →
+ *   Nyquist → inverse sinc / calibration → NCO reset + mixer event →
+ *   MMCM → FIFO
+ *
+ * Tiles are independent until the per-block step, so the work runs in
+ * three phases: PLL rate and startup are issued for every tile at once (on
+ * the worker pool when one is given), then all PLL locks are awaited in a
+ * single poll loop, then blocks, MMCM and FIFO are set up tile by tile.
+ * Total time is about the slowest lock rather than the sum of all of them.
+ *
+ * A tile that is already started is not restarted; the MMCM is reprogrammed
+ * only when the fabric rate may have changed (restart, PLL, datapath or
+ * factor change) or it has lost lock, with the FIFO held off meanwhile.
+ * Clock chip presets cannot be read back: they are compared against the
+ * presets this Applier last programmed (or was told about), and a change
+ * restarts every tile.
+ */
+class Applier {
+public:
+    struct Options {
+        bool force = false;                 // Issue every call, as a full bring-up
+        bool verbose = true;                // Print each change
+        bool parallel = true;               // Issue PLL/startup on the worker pool
+    };
+
+    /**
+     * @param rfdc Converter wrapper
+     * @param clock_wiz Fabric clock MMCMs
+     * @param clock Clock chips; nullptr leaves them alone
+     * @param workers Pool for the per-tile PLL/startup phase; nullptr runs
+     *        it on the calling thread
+     */
+    Applier(rfdc::RFDC& rfdc, clock_wizard::ClockWizard& clock_wiz, rfdc::RFClock* clock,
+            worker_pool::WorkerPool* workers = nullptr);
+
+    /**
+     * @brief Record clock presets programmed elsewhere (board bring-up)
+     */
+    void assume_clocks(const ClockConfig& clocks);
+
+    /**
+     * @brief Apply `config`
+     * @throws rfdc::RFDCException on driver failure or PLL lock timeout
+     */
+    Report apply(const Config& config, const Options& options);
+    Report apply(const Config& config) { return apply(config, Options()); }
+
+private:
+    rfdc::RFDC& rfdc_;
+    clock_wizard::ClockWizard& clock_wiz_;
+    rfdc::RFClock* clock_;
+    worker_pool::WorkerPool* workers_;
+    bool clocks_known_ = false;
+    ClockConfig clocks_;
+    std::chrono::steady_clock::time_point start_;  // Of the current apply
+    std::mutex output_mutex_;                       // Notes from the parallel phase
+
+    struct TileWork;
+    void issue_tile(TileWork& w, const Options& options);
+    void wait_for_locks(std::vector<TileWork>& work, Report& report);
+    void configure_tile(TileWork& w, const Options& options, Report& report);
+    void note(const TileWork& w, const std::string& what, const Options& options);
+    std::chrono::nanoseconds elapsed() const;
+};
+
+/**
+ * @brief Per-step table (calls, total and mean time), then the tile timeline
+ */
+void print_report(const Report& report, std::ostream& os);
+
+} // namespace converter_config
@@ -0,0 +1,166 @@
+#include "DacPlayback.hpp"
+#include "DeviceCopy.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace dac_playback {
+
+DoubleBuffer::DoubleBuffer(local_mem::LocalMem& lmem, const Config& config)
+    : lmem_(lmem)
+    , config_(config)
+{
+}
+
+DoubleBuffer::~DoubleBuffer()
+{
+    if (running_) {
+        stop();
+    }
+}
+
+bool DoubleBuffer::start(sample::SampleSpan waveform)
+{
+    if (!config_.regs || !config_.memory || config_.samples_per_second <= 0.0) {
+        std::cerr << "  ✗ DAC double buffer: missing registers, memory or sample rate\n";
+        return false;
+    }
+    const size_t n = waveform.size();
+    if (n == 0 || (n % 16) != 0 || 2 * n * sizeof(int16_t) > config_.memory_bytes) {
+        std::cerr << "  ✗ DAC double buffer: " << n << " samples does not fit two halves of "
+                  << config_.memory_bytes << " bytes (multiple of 16 required)\n";
+        return false;
+    }
+
+    stop();
+    half_samples_ = n;
+    write_half(0, waveform);
+    write_half(1, waveform);
+
+    if (!lmem_.set_sample_count(rfdc::TileType::DAC, config_.tile, config_.block,
+                                static_cast<uint32_t>(2 * n), config_.regs)) {
+        return false;
+    }
+    const auto& topo = lmem_.topology(rfdc::TileType::DAC);
+    if (!lmem_.trigger(rfdc::TileType::DAC, config_.regs,
+                       1u << topo.index(config_.tile, config_.block))) {
+        return false;
+    }
+    started_ = Clock::now();
+    running_ = true;
+    last_write_ = std::chrono::nanoseconds(0);
+    return true;
+}
+
+SwapReport DoubleBuffer::swap(sample::SampleSpan waveform)
+{
+    SwapReport report;
+    if (!running_ || waveform.size() != half_samples_) {
+        std::cerr << "  ✗ DAC double buffer: not running or waveform length changed\n";
+        return report;
+    }
+
+    const auto requested = Clock::now();
+    uint64_t now = played(requested);
+    uint32_t current = half_at(now);
+    uint32_t idle = current ^ 1;
+
+    // Not enough of the current half left to finish the write: wait for the
+    // boundary and take the half playback has just left instead
+    const uint64_t write_samples = static_cast<uint64_t>(
+        std::chrono::duration<double>(last_write_).count() * config_.samples_per_second);
+    if (next_start_of(idle, now) - now < write_samples + config_.guard_samples) {
+        std::this_thread::sleep_until(time_of(next_start_of(idle, now) + config_.guard_samples));
+        now = played(Clock::now());
+        current = half_at(now);
+        idle = current ^ 1;
+    }
+
+    // 1) New waveform into the idle half; it goes live at its next start
+    auto t0 = Clock::now();
+    const uint64_t s0 = played(t0);
+    write_half(idle, waveform);
+    auto t1 = Clock::now();
+    report.glitch = read_during(idle, s0, played(t1));
+    report.first_half = idle;
+
+    const uint64_t live = next_start_of(idle, played(t1));
+    report.latency = std::chrono::duration_cast<std::chrono::microseconds>(time_of(live) - requested);
+
+    // 2) Once playback is inside the new half, refill the old one. Any read
+    //    of it after the boundary replays or tears the old waveform (the
+    //    guard before the boundary is still the old half's legitimate play).
+    const uint64_t refill_from = live + config_.guard_samples;
+    std::this_thread::sleep_until(time_of(refill_from));
+    auto t2 = Clock::now();
+    write_half(current, waveform);
+    auto t3 = Clock::now();
+    report.glitch = report.glitch || read_during(current, refill_from, played(t3));
+
+    last_write_ = std::max(t1 - t0, t3 - t2);
+    report.write_time = std::chrono::duration_cast<std::chrono::microseconds>((t1 - t0) + (t3 - t2));
+    report.swapped = true;
+    return report;
+}
+
+void DoubleBuffer::stop()
+{
+    if (config_.regs) {
+        lmem_.trigger(rfdc::TileType::DAC, config_.regs, 0);
+    }
+    running_ = false;
+}
+
+std::chrono::nanoseconds DoubleBuffer::half_period() const
+{
+    if (config_.samples_per_second <= 0.0) {
+        return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::nanoseconds(
+        static_cast<int64_t>(half_samples_ * 1e9 / config_.samples_per_second));
+}
+
+uint64_t DoubleBuffer::played(Clock::time_point t) const
+{
+    if (t <= started_) {
+        return 0;
+    }
+    return static_cast<uint64_t>(
+        std::chrono::duration<double>(t - started_).count() * config_.samples_per_second);
+}
+
+DoubleBuffer::Clock::time_point DoubleBuffer::time_of(uint64_t sample) const
+{
+    return started_ + std::chrono::nanoseconds(
+        static_cast<int64_t>(sample * 1e9 / config_.samples_per_second));
+}
+
+uint32_t DoubleBuffer::half_at(uint64_t sample) const
+{
+    return static_cast<uint32_t>((sample / half_samples_) & 1);
+}
+
+uint64_t DoubleBuffer::next_start_of(uint32_t half, uint64_t from) const
+{
+    const uint64_t period = 2 * half_samples_;
+    uint64_t start = from - (from % period) + half * half_samples_;
+    if (start < from) {
+        start += period;
+    }
+    return start;
+}
+
+bool DoubleBuffer::read_during(uint32_t half, uint64_t first, uint64_t last) const
+{
+    first = first > config_.guard_samples ? first - config_.guard_samples : 0;
+    last += config_.guard_samples;
+    return half_at(first) == half || next_start_of(half, first) <= last;
+}
+
+void DoubleBuffer::write_half(uint32_t half, sample::SampleSpan waveform)
+{
+    const size_t bytes = half_samples_ * sizeof(int16_t);
+    device_copy::to_device(config_.memory + half * bytes, waveform.data(), bytes);
+}
+
+} // namespace dac_playback
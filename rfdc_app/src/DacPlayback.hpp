@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "LocalMem.hpp"
+#include "SampleSpan.hpp"
+
+namespace dac_playback {
+
+/**
+ * @brief Outcome of one waveform hot-swap
+ */
+struct SwapReport {
+    bool swapped = false;
+    bool glitch = false;                    // A write may have overlapped playback
+    std::chrono::microseconds latency{0};   // Request → first boundary into the new waveform
+    std::chrono::microseconds write_time{0};// Both half writes together
+    uint32_t first_half = 0;                // Half that went live first
+};
+
+/**
+ * @brief Cyclic DAC playback from two halves of one channel memory
+ *
+ * The channel's end address is set to two waveform lengths, so the data
+ * mover plays half 0 then half 1 forever. A swap writes the new waveform
+ * into the half that is not being read, lets playback cross the boundary
+ * into it, then rewrites the other half. The output goes from the old
+ * waveform to the new one at a buffer boundary without stopping the mover.
+ *
+ * The data mover has no readable play position, so it is estimated from
+ * the trigger time and the fabric sample rate. A write that may have come
+ * within `guard_samples` of the read position is reported as a glitch.
+ * With BRAM a half lasts microseconds at GSPS fabric rates, so glitch-free
+ * swaps need DDR-backed channel memory (RfDcApp::set_dac_mem_type) and a
+ * fabric rate the host can out-write.
+ */
+class DoubleBuffer {
+public:
+    struct Config {
+        uint32_t tile = 0;
+        uint32_t block = 0;
+        void* regs = nullptr;               // DAC data mover registers
+        uint8_t* memory = nullptr;          // Channel memory (BRAM window or plmem map)
+        size_t memory_bytes = 0;
+        double samples_per_second = 0.0;    // Fabric read rate of the channel
+        uint64_t guard_samples = 256;       // Margin kept from the read position
+    };
+
+    DoubleBuffer(local_mem::LocalMem& lmem, const Config& config);
+    ~DoubleBuffer();
+
+    DoubleBuffer(const DoubleBuffer&) = delete;
+    DoubleBuffer& operator=(const DoubleBuffer&) = delete;
+
+    /**
+     * @brief Load `waveform` into both halves and start cyclic playback
+     *
+     * Every later swap() must use the same length. Length must be a
+     * multiple of 16 samples and at most half the channel memory.
+     * @return false if the waveform does not fit or the trigger failed
+     */
+    bool start(sample::SampleSpan waveform);
+
+    /**
+     * @brief Replace the playing waveform at the next buffer boundary
+     *
+     * Blocks until both halves hold the new waveform (about two half
+     * periods at most).
+     */
+    SwapReport swap(sample::SampleSpan waveform);
+
+    /**
+     * @brief Stop the DAC data mover
+     */
+    void stop();
+
+    bool running() const { return running_; }
+    size_t half_samples() const { return half_samples_; }
+    std::chrono::nanoseconds half_period() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    local_mem::LocalMem& lmem_;
+    Config config_;
+    size_t half_samples_ = 0;
+    bool running_ = false;
+    Clock::time_point started_;
+    std::chrono::nanoseconds last_write_{0};    // Slowest recent half write
+
+    // Samples played since start (unwrapped)
+    uint64_t played(Clock::time_point t) const;
+    Clock::time_point time_of(uint64_t sample) const;
+    uint32_t half_at(uint64_t sample) const;
+    // First sample index >= `from` at which `half` starts playing
+    uint64_t next_start_of(uint32_t half, uint64_t from) const;
+    // True if half `half` is read anywhere in [first, last] (guard included)
+    bool read_during(uint32_t half, uint64_t first, uint64_t last) const;
+    void write_half(uint32_t half, sample::SampleSpan waveform);
+};
+
+} // namespace dac_playback
@@ -0,0 +1,282 @@
+#include "DeviceCopy.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DEVICE_COPY_USE_NEON 1
+#else
+#define DEVICE_COPY_USE_NEON 0
+#endif
+
+namespace device_copy {
+
+namespace {
+
+// ===== Barriers =====
+
+// Make device stores visible before whatever register write follows
+inline void store_barrier()
+{
+#if defined(__aarch64__)
+    __asm__ volatile("dsb st" ::: "memory");
+#else
+    std::atomic_thread_fence(std::memory_order_release);
+#endif
+}
+
+// Keep device loads behind whatever status read preceded them
+inline void load_barrier()
+{
+#if defined(__aarch64__)
+    __asm__ volatile("dsb ld" ::: "memory");
+#else
+    std::atomic_thread_fence(std::memory_order_acquire);
+#endif
+}
+
+// ===== Word Loops =====
+
+template <typename Word>
+inline size_t copy_words(void* dst, const void* src, size_t bytes)
+{
+    volatile Word* d = static_cast<volatile Word*>(dst);
+    const volatile Word* s = static_cast<const volatile Word*>(src);
+    const size_t words = bytes / sizeof(Word);
+
+    for (size_t n = 0; n < words; ++n) {
+        d[n] = s[n];
+    }
+    return words * sizeof(Word);
+}
+
+// 32-bit tail after a wider loop, then a final odd sample
+inline void copy_tail(void* dst, const void* src, size_t done, size_t bytes)
+{
+    done += copy_words<uint32_t>(static_cast<uint8_t*>(dst) + done,
+                                 static_cast<const uint8_t*>(src) + done,
+                                 bytes - done);
+    copy_words<uint16_t>(static_cast<uint8_t*>(dst) + done,
+                         static_cast<const uint8_t*>(src) + done,
+                         bytes - done);
+}
+
+#if DEVICE_COPY_USE_NEON
+inline size_t copy_neon(void* dst, const void* src, size_t bytes)
+{
+    uint32_t* d = static_cast<uint32_t*>(dst);
+    const uint32_t* s = static_cast<const uint32_t*>(src);
+    const size_t blocks = bytes / 64;
+
+    for (size_t n = 0; n < blocks; ++n) {
+        uint32x4_t a = vld1q_u32(s);
+        uint32x4_t b = vld1q_u32(s + 4);
+        uint32x4_t c = vld1q_u32(s + 8);
+        uint32x4_t e = vld1q_u32(s + 12);
+        vst1q_u32(d, a);
+        vst1q_u32(d + 4, b);
+        vst1q_u32(d + 8, c);
+        vst1q_u32(d + 12, e);
+        s += 16;
+        d += 16;
+    }
+    return blocks * 64;
+}
+#endif
+
+void copy_with(void* dst, const void* src, size_t bytes, Strategy strategy)
+{
+    size_t done = 0;
+
+    switch (strategy) {
+        case Strategy::Memcpy:
+            std::memcpy(dst, src, bytes);
+            return;
+        case Strategy::Word32:
+            done = copy_words<uint32_t>(dst, src, bytes);
+            break;
+        case Strategy::Word64:
+            done = copy_words<uint64_t>(dst, src, bytes);
+            break;
+        case Strategy::Neon:
+#if DEVICE_COPY_USE_NEON
+            done = copy_neon(dst, src, bytes);
+            break;
+#endif
+            // fall through (NEON not compiled in)
+        case Strategy::Word128:
+            done = copy_words<unsigned __int128>(dst, src, bytes);
+            break;
+    }
+
+    if (done < bytes) {
+        copy_tail(dst, src, done, bytes);
+    }
+}
+
+Strategy initial_strategy()
+{
+    Strategy strategy = DEVICE_COPY_USE_NEON ? Strategy::Neon : Strategy::Word128;
+
+    const char* env = std::getenv("RFDC_DEVICE_COPY");
+    Strategy requested;
+    if (env && parse_strategy(env, requested) && is_available(requested) &&
+        is_device_safe(requested)) {
+        strategy = requested;
+    }
+    return strategy;
+}
+
+std::atomic<Strategy>& active()
+{
+    static std::atomic<Strategy> strategy(initial_strategy());
+    return strategy;
+}
+
+} // namespace
+
+// ===== Public API =====
+
+void to_device(void* device, const void* host, size_t bytes, Strategy strategy)
+{
+    copy_with(device, host, bytes, strategy);
+    store_barrier();
+}
+
+void from_device(void* host, const void* device, size_t bytes, Strategy strategy)
+{
+    load_barrier();
+    copy_with(host, device, bytes, strategy);
+}
+
+void to_device(void* device, const void* host, size_t bytes)
+{
+    to_device(device, host, bytes, active_strategy());
+}
+
+void from_device(void* host, const void* device, size_t bytes)
+{
+    from_device(host, device, bytes, active_strategy());
+}
+
+void set_strategy(Strategy strategy)
+{
+    const bool usable = is_available(strategy) && is_device_safe(strategy);
+    active().store(usable ? strategy : Strategy::Word128);
+}
+
+Strategy active_strategy()
+{
+    return active().load(std::memory_order_relaxed);
+}
+
+bool is_available(Strategy strategy)
+{
+    return strategy != Strategy::Neon || DEVICE_COPY_USE_NEON;
+}
+
+bool is_device_safe(Strategy strategy)
+{
+    return strategy != Strategy::Memcpy;
+}
+
+const char* to_string(Strategy strategy)
+{
+    switch (strategy) {
+        case Strategy::Memcpy:  return "memcpy";
+        case Strategy::Word32:  return "word32";
+        case Strategy::Word64:  return "word64";
+        case Strategy::Word128: return "word128";
+        case Strategy::Neon:    return "neon";
+    }
+    return "unknown";
+}
+
+bool parse_strategy(const std::string& name, Strategy& strategy)
+{
+    for (Strategy s : { Strategy::Memcpy, Strategy::Word32, Strategy::Word64,
+                        Strategy::Word128, Strategy::Neon }) {
+        if (name == to_string(s)) {
+            strategy = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===== Benchmark =====
+
+std::vector<BenchResult> benchmark(void* device, size_t bytes, int iterations,
+                                   bool include_reference)
+{
+    std::vector<BenchResult> results;
+    if (!device || bytes == 0 || iterations <= 0) {
+        return results;
+    }
+    bytes &= ~static_cast<size_t>(3);
+
+    std::vector<uint32_t> src(bytes / 4);
+    std::vector<uint32_t> dst(bytes / 4);
+    for (size_t n = 0; n < src.size(); ++n) {
+        src[n] = static_cast<uint32_t>(n * 2654435761u);
+    }
+
+    auto mb_per_s = [&](std::chrono::steady_clock::duration d) {
+        double s = std::chrono::duration<double>(d).count();
+        return s > 0.0 ? (static_cast<double>(bytes) * iterations) / (s * 1e6) : 0.0;
+    };
+
+    for (Strategy s : { Strategy::Memcpy, Strategy::Word32, Strategy::Word64,
+                        Strategy::Word128, Strategy::Neon }) {
+        if (!is_available(s) || (!is_device_safe(s) && !include_reference)) {
+            continue;
+        }
+
+        BenchResult r;
+        r.strategy = s;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            to_device(device, src.data(), bytes, s);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            from_device(dst.data(), device, bytes, s);
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        r.write_mb_per_s = mb_per_s(t1 - t0);
+        r.read_mb_per_s = mb_per_s(t2 - t1);
+        r.verified = std::memcmp(src.data(), dst.data(), bytes) == 0;
+        std::memset(dst.data(), 0, bytes);
+
+        results.push_back(r);
+    }
+    return results;
+}
+
+Strategy select_fastest(const std::vector<BenchResult>& results)
+{
+    Strategy best = active_strategy();
+    double best_cost = 0.0;
+
+    for (const auto& r : results) {
+        if (!is_device_safe(r.strategy) || !r.verified ||
+            r.write_mb_per_s <= 0.0 || r.read_mb_per_s <= 0.0) {
+            continue;
+        }
+        // Time per MB moved both ways
+        double cost = 1.0 / r.write_mb_per_s + 1.0 / r.read_mb_per_s;
+        if (best_cost == 0.0 || cost < best_cost) {
+            best_cost = cost;
+            best = r.strategy;
+        }
+    }
+
+    set_strategy(best);
+    return best;
+}
+
+} // namespace device_copy
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace device_copy {
+
+/**
+ * @brief Copy routines for BRAM mapped through /dev/mem (O_SYNC)
+ *
+ * Such mappings are Device memory on AArch64: every access goes to the bus
+ * as issued, and unaligned accesses fault. std::memcpy may use byte or
+ * unaligned accesses for heads/tails, and per-word volatile loops never
+ * burst. These routines only issue naturally aligned accesses of the chosen
+ * width, finish any tail with 32-bit (then one 16-bit) accesses, and fence
+ * the transfer so it is ordered against the trigger/FIFO register writes
+ * around it.
+ *
+ * Device pointers must be 16-byte aligned (every BRAM window is) and sizes
+ * a multiple of 2 bytes (whole samples). Host buffers need 4-byte alignment.
+ */
+
+enum class Strategy {
+    Memcpy,     // std::memcpy (reference; host memory only)
+    Word32,     // volatile 32-bit loop (previous behaviour)
+    Word64,     // aligned 64-bit loads/stores
+    Word128,    // aligned 128-bit (ldp/stp) loads/stores
+    Neon        // NEON ld1/st1 bursts, 64 bytes per iteration (AArch64 only)
+};
+
+/**
+ * @brief Copy host memory into device memory with the active strategy
+ */
+void to_device(void* device, const void* host, size_t bytes);
+
+/**
+ * @brief Copy device memory into host memory with the active strategy
+ */
+void from_device(void* host, const void* device, size_t bytes);
+
+/**
+ * @brief Same, with an explicit strategy (falls back to Word128 if unavailable)
+ */
+void to_device(void* device, const void* host, size_t bytes, Strategy strategy);
+void from_device(void* host, const void* device, size_t bytes, Strategy strategy);
+
+/**
+ * @brief Choose the strategy used by the two-argument copies
+ *
+ * At startup this is the widest available one, or the RFDC_DEVICE_COPY
+ * environment variable if set (word32, word64, word128, neon). Strategies
+ * that are unavailable or not device-safe (memcpy) fall back to the default.
+ */
+void set_strategy(Strategy strategy);
+Strategy active_strategy();
+
+bool is_available(Strategy strategy);
+// False for Memcpy: it may issue byte or unaligned accesses
+bool is_device_safe(Strategy strategy);
+const char* to_string(Strategy strategy);
+bool parse_strategy(const std::string& name, Strategy& strategy);
+
+struct BenchResult {
+    Strategy strategy;
+    double write_mb_per_s;      // host → device
+    double read_mb_per_s;       // device → host
+    bool verified;              // Round trip matched
+};
+
+/**
+ * @brief Measure every available strategy against a mapped buffer
+ * @param device Mapped buffer (BRAM window, or a memfd mapping on the host)
+ * @param bytes Bytes per transfer (multiple of 4, <= buffer size)
+ * @param iterations Transfers per direction per strategy
+ * @param include_reference Also time Memcpy; only for host mappings
+ * @return One result per available strategy
+ */
+std::vector<BenchResult> benchmark(void* device, size_t bytes, int iterations,
+                                   bool include_reference = false);
+
+/**
+ * @brief Make the fastest benchmarked device-safe strategy (by read + write
+ *        time) active; Memcpy results are ignored
+ * @return The chosen strategy
+ */
+Strategy select_fastest(const std::vector<BenchResult>& results);
+
+} // namespace device_copy
@@ -0,0 +1,449 @@
+#include "HwBackend.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace hw_backend {
+
+constexpr uint64_t Simulated::PHYS_SIZE;
+constexpr size_t Simulated::DEVICE_SIZE;
+constexpr uint32_t Simulated::NUM_MEM_CHANNELS;
+
+namespace {
+
+// LocalMem data mover registers (see local_mem::LocalMem)
+constexpr uint32_t LMEM_INFO = 0x00;
+constexpr uint32_t LMEM_TRIGGER = 0x04;
+constexpr uint32_t LMEM_ENABLE = 0x08;
+constexpr uint32_t LMEM0_ENDADDR = 0x10;
+
+// 15 channels of 2 * 0x800000 / 16 / 16 = 64 KB each
+constexpr uint32_t SIM_LMEM_INFO = (15u << 24) | 0x800000;
+
+// Clock wizard registers (see clock_wizard::ClockWizard)
+constexpr uint32_t MMCM_RESET_REG = 0x00;
+constexpr uint32_t MMCM_STATUS_REG = 0x04;
+constexpr uint32_t MMCM_LOAD_REG = 0x25C;
+constexpr uint32_t MMCM_BLOCK_SIZE = 0x1000;
+
+} // namespace
+
+// ===== Hardware =====
+
+Hardware::~Hardware()
+{
+    if (mem_fd_ >= 0) {
+        close(mem_fd_);
+    }
+}
+
+int Hardware::open_mem()
+{
+    int fd = open("/dev/mem", O_RDWR | O_SYNC);
+    if (fd < 0) {
+        perror("open /dev/mem");
+    }
+    return fd;
+}
+
+void* Hardware::map_physical(uint64_t paddr, size_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (mem_fd_ < 0) {
+            mem_fd_ = open_mem();
+        }
+    }
+    if (mem_fd_ < 0) {
+        return MAP_FAILED;
+    }
+    return mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                mem_fd_, static_cast<off_t>(paddr));
+}
+
+void Hardware::unmap_physical(void* vaddr, size_t bytes)
+{
+    if (vaddr && vaddr != MAP_FAILED) {
+        munmap(vaddr, bytes);
+    }
+}
+
+uint32_t Hardware::read32(const void* addr)
+{
+    return *static_cast<const volatile uint32_t*>(addr);
+}
+
+void Hardware::write32(void* addr, uint32_t value)
+{
+    *static_cast<volatile uint32_t*>(addr) = value;
+}
+
+int Hardware::open_device(const std::string& path, int flags)
+{
+    return open(path.c_str(), flags);
+}
+
+bool Hardware::write_attr(const std::string& path, const std::string& value)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << value;
+    file.close();
+    return !file.fail();
+}
+
+bool Hardware::read_attr(const std::string& path, std::string& value)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::getline(file, value);
+    return !file.fail();
+}
+
+// ===== Simulated =====
+
+Simulated::Simulated()
+{
+    mem_fd_ = memfd_create("rfdc_sim_phys", MFD_CLOEXEC);
+    if (mem_fd_ < 0 || ftruncate(mem_fd_, static_cast<off_t>(PHYS_SIZE)) != 0) {
+        if (mem_fd_ >= 0) {
+            close(mem_fd_);
+        }
+        throw std::runtime_error("Simulated backend: cannot create physical memory");
+    }
+
+    void* base = mmap(nullptr, PHYS_SIZE, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_NORESERVE, mem_fd_, 0);
+    if (base == MAP_FAILED) {
+        close(mem_fd_);
+        throw std::runtime_error("Simulated backend: cannot map physical memory");
+    }
+    phys_ = static_cast<uint8_t*>(base);
+
+    for (uint32_t k = 0; k < NUM_MEM_CHANNELS; ++k) {
+        routes_[k].dac_i = static_cast<int>(k);
+    }
+}
+
+Simulated::~Simulated()
+{
+    for (auto& dev : devices_) {
+        close(dev.second);
+    }
+    munmap(phys_, PHYS_SIZE);
+    close(mem_fd_);
+}
+
+int Simulated::open_mem()
+{
+    return dup(mem_fd_);
+}
+
+void* Simulated::map_physical(uint64_t paddr, size_t bytes)
+{
+    if (paddr + bytes > PHYS_SIZE) {
+        return MAP_FAILED;
+    }
+    return phys_ + paddr;
+}
+
+void Simulated::unmap_physical(void*, size_t)
+{
+    // Views into the permanent mapping
+}
+
+uint32_t Simulated::read32(const void* addr)
+{
+    return *static_cast<const volatile uint32_t*>(addr);
+}
+
+void Simulated::write32(void* addr, uint32_t value)
+{
+    uint8_t* p = static_cast<uint8_t*>(addr);
+    if (p < phys_ || p >= phys_ + PHYS_SIZE) {
+        *static_cast<volatile uint32_t*>(addr) = value;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    *static_cast<volatile uint32_t*>(addr) = value;
+    on_write(static_cast<uint64_t>(p - phys_), value);
+}
+
+int Simulated::open_device(const std::string& path, int)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = devices_.find(path);
+    if (it == devices_.end()) {
+        int fd = memfd_create(path.c_str(), MFD_CLOEXEC);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(DEVICE_SIZE)) != 0) {
+            perror(("memfd " + path).c_str());
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+        it = devices_.emplace(path, fd).first;
+    }
+    return dup(it->second);
+}
+
+bool Simulated::write_attr(const std::string& path, const std::string& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    attrs_[path] = value;
+    return true;
+}
+
+bool Simulated::read_attr(const std::string& path, std::string& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = attrs_.find(path);
+    if (it == attrs_.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+void Simulated::add_local_mem(bool adc, uint64_t paddr)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (adc) {
+        adc_lmem_ = paddr;
+        have_adc_ = true;
+    } else {
+        dac_lmem_ = paddr;
+        have_dac_ = true;
+    }
+    set_reg(paddr + LMEM_INFO, SIM_LMEM_INFO);
+}
+
+void Simulated::add_clock_wizard(uint64_t paddr)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clock_wizards_.push_back(paddr);
+    set_reg(paddr + MMCM_STATUS_REG, 0x1);
+}
+
+void Simulated::connect(uint32_t adc_channel, int dac_i, int dac_q)
+{
+    if (adc_channel >= NUM_MEM_CHANNELS) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    routes_[adc_channel].dac_i = dac_i;
+    routes_[adc_channel].dac_q = dac_q;
+}
+
+void Simulated::set_model(const LoopbackModel& model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    model_ = model;
+}
+
+Simulated::LoopbackModel Simulated::model() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return model_;
+}
+
+Simulated::Stats Simulated::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+uint32_t Simulated::reg(uint64_t paddr) const
+{
+    return *reinterpret_cast<const volatile uint32_t*>(phys_ + paddr);
+}
+
+void Simulated::set_reg(uint64_t paddr, uint32_t value)
+{
+    *reinterpret_cast<volatile uint32_t*>(phys_ + paddr) = value;
+}
+
+uint64_t Simulated::channel_base(uint64_t lmem, uint32_t channel) const
+{
+    return lmem + (channel + 1) * channel_bytes(lmem);
+}
+
+size_t Simulated::channel_bytes(uint64_t lmem) const
+{
+    // Same arithmetic as RFDC::build_channel_maps()
+    const uint32_t info = reg(lmem + LMEM_INFO);
+    const uint32_t mem_size = info & 0x00FFFFFF;
+    const uint32_t num_mem = (info >> 24) & 0x7F;
+    return 2 * static_cast<size_t>(mem_size) / (num_mem + 1) / 16;
+}
+
+void Simulated::on_write(uint64_t paddr, uint32_t value)
+{
+    if (have_adc_ && paddr == adc_lmem_ + LMEM_TRIGGER && (value & 0x1)) {
+        run_adc_capture();
+        set_reg(paddr, value & ~0x1u);
+        stats_.adc_triggers++;
+        return;
+    }
+    if (have_dac_ && paddr == dac_lmem_ + LMEM_TRIGGER && (value & 0x1)) {
+        // Playback starts at once; sources are read at ADC trigger time
+        set_reg(paddr, value & ~0x1u);
+        stats_.dac_triggers++;
+        return;
+    }
+
+    for (uint64_t base : clock_wizards_) {
+        if (paddr == base + MMCM_RESET_REG || paddr == base + MMCM_LOAD_REG) {
+            set_reg(base + MMCM_STATUS_REG, 0x1);
+            stats_.mmcm_resets++;
+            return;
+        }
+        if (paddr >= base && paddr < base + MMCM_BLOCK_SIZE) {
+            return;
+        }
+    }
+}
+
+int16_t Simulated::sample(const int16_t* src, uint32_t len, uint64_t index)
+{
+    int32_t value = 0;
+    if (src && len) {
+        const uint64_t delay = model_.delay_samples % len;
+        value = static_cast<int32_t>(src[(index + len - delay) % len] * model_.gain);
+    }
+    if (model_.noise > 0) {
+        noise_state_ = noise_state_ * 1664525u + 1013904223u;
+        value += static_cast<int32_t>((noise_state_ >> 8) % (2 * model_.noise + 1)) - model_.noise;
+    }
+    return static_cast<int16_t>(std::max<int32_t>(-32768, std::min<int32_t>(32767, value)));
+}
+
+void Simulated::run_adc_capture()
+{
+    const uint32_t enable = reg(adc_lmem_ + LMEM_ENABLE);
+    const uint32_t dac_enable = have_dac_ ? reg(dac_lmem_ + LMEM_ENABLE) : 0;
+    const uint32_t adc_capacity = static_cast<uint32_t>(channel_bytes(adc_lmem_) / sizeof(int16_t));
+    const uint32_t dac_capacity = have_dac_ ?
+        static_cast<uint32_t>(channel_bytes(dac_lmem_) / sizeof(int16_t)) : 0;
+
+    // A DAC channel is a source while it is enabled and has samples
+    auto source = [&](int channel, uint32_t& len) -> const int16_t* {
+        len = 0;
+        if (channel < 0 || channel >= static_cast<int>(NUM_MEM_CHANNELS) ||
+            !((dac_enable >> channel) & 0x1)) {
+            return nullptr;
+        }
+        len = std::min(reg(dac_lmem_ + LMEM0_ENDADDR + 4 * channel), dac_capacity);
+        return reinterpret_cast<const int16_t*>(phys_ + channel_base(dac_lmem_, channel));
+    };
+
+    for (uint32_t k = 0; k < NUM_MEM_CHANNELS; ++k) {
+        if (!((enable >> k) & 0x1)) {
+            continue;
+        }
+        const uint32_t n = std::min(reg(adc_lmem_ + LMEM0_ENDADDR + 4 * k), adc_capacity);
+        int16_t* dst = reinterpret_cast<int16_t*>(phys_ + channel_base(adc_lmem_, k));
+
+        uint32_t len_i = 0, len_q = 0;
+        const int16_t* src_i = source(routes_[k].dac_i, len_i);
+        if (routes_[k].dac_q >= 0) {
+            const int16_t* src_q = source(routes_[k].dac_q, len_q);
+            for (uint32_t i = 0; i + 1 < n; i += 2) {
+                dst[i] = sample(src_i, len_i, i / 2);
+                dst[i + 1] = sample(src_q, len_q, i / 2);
+            }
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                dst[i] = sample(src_i, len_i, i);
+            }
+        }
+        stats_.samples_looped += n;
+    }
+}
+
+// ===== Selection =====
+
+namespace {
+
+std::unique_ptr<Backend> make_backend(Kind kind)
+{
+    if (kind == Kind::Simulated) {
+        return std::unique_ptr<Backend>(new Simulated());
+    }
+    return std::unique_ptr<Backend>(new Hardware());
+}
+
+Kind initial_kind()
+{
+#ifdef RFDC_HOST_SIM
+    // No driver behind a host build: hardware only if asked for explicitly
+    Kind kind = Kind::Simulated;
+#else
+    Kind kind = Kind::Hardware;
+#endif
+    const char* env = std::getenv("RFDC_BACKEND");
+    if (env && !parse_kind(env, kind)) {
+        std::cerr << "Unknown RFDC_BACKEND '" << env << "', using "
+                  << (kind == Kind::Simulated ? "the simulator" : "hardware") << "\n";
+    }
+    return kind;
+}
+
+std::unique_ptr<Backend>& slot()
+{
+    static std::unique_ptr<Backend> backend(make_backend(initial_kind()));
+    return backend;
+}
+
+} // namespace
+
+Backend& active()
+{
+    return *slot();
+}
+
+void select(Kind kind)
+{
+    if (slot()->kind() != kind) {
+        slot() = make_backend(kind);
+    }
+}
+
+Simulated* simulator()
+{
+    Backend& backend = active();
+    return backend.simulated() ? static_cast<Simulated*>(&backend) : nullptr;
+}
+
+const char* to_string(Kind kind)
+{
+    return kind == Kind::Simulated ? "sim" : "hw";
+}
+
+bool parse_kind(const std::string& name, Kind& kind)
+{
+    if (name == "hw" || name == "hardware") {
+        kind = Kind::Hardware;
+        return true;
+    }
+    if (name == "sim" || name == "simulated") {
+        kind = Kind::Simulated;
+        return true;
+    }
+    return false;
+}
+
+} // namespace hw_backend
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hw_backend {
+
+/**
+ * @brief Access to the platform underneath the RFDC, LocalMem, ClockWizard,
+ *        Gpio and BRAM code
+ *
+ * Everything that used to open /dev/mem, /dev/plmemN or /sys directly goes
+ * through the active backend instead:
+ *   - physical address space: a descriptor with /dev/mem semantics (mmap
+ *     offset = physical address) and page mappings for register blocks
+ *   - 32-bit register reads/writes on those mappings
+ *   - device nodes (plmem) and sysfs attributes (GPIO, plmem mem_type)
+ *
+ * Hardware is the default. Simulated lets the full pipeline run on a host:
+ * see Simulated below.
+ */
+
+enum class Kind {
+    Hardware,
+    Simulated
+};
+
+class Backend {
+public:
+    virtual ~Backend() = default;
+
+    virtual Kind kind() const = 0;
+    bool simulated() const { return kind() == Kind::Simulated; }
+
+    /**
+     * @brief Open a new descriptor over the physical address space
+     * @return File descriptor (caller closes), or -1
+     */
+    virtual int open_mem() = 0;
+
+    /**
+     * @brief Map a register block
+     * @param paddr Page-aligned physical address
+     * @param bytes Bytes to map
+     * @return Mapping, or MAP_FAILED
+     */
+    virtual void* map_physical(uint64_t paddr, size_t bytes) = 0;
+    virtual void unmap_physical(void* vaddr, size_t bytes) = 0;
+
+    /**
+     * @brief Register access through a map_physical() pointer
+     */
+    virtual uint32_t read32(const void* addr) = 0;
+    virtual void write32(void* addr, uint32_t value) = 0;
+
+    /**
+     * @brief Open a device node (e.g. /dev/plmem0)
+     * @return File descriptor (caller closes), or -1
+     */
+    virtual int open_device(const std::string& path, int flags) = 0;
+
+    /**
+     * @brief Write/read a sysfs attribute
+     * @return true on success
+     */
+    virtual bool write_attr(const std::string& path, const std::string& value) = 0;
+    virtual bool read_attr(const std::string& path, std::string& value) = 0;
+};
+
+/**
+ * @brief /dev/mem, real device nodes and sysfs
+ */
+class Hardware : public Backend {
+public:
+    Hardware() = default;
+    ~Hardware() override;
+
+    Kind kind() const override { return Kind::Hardware; }
+
+    int open_mem() override;
+    void* map_physical(uint64_t paddr, size_t bytes) override;
+    void unmap_physical(void* vaddr, size_t bytes) override;
+
+    uint32_t read32(const void* addr) override;
+    void write32(void* addr, uint32_t value) override;
+
+    int open_device(const std::string& path, int flags) override;
+    bool write_attr(const std::string& path, const std::string& value) override;
+    bool read_attr(const std::string& path, std::string& value) override;
+
+private:
+    std::mutex mutex_;
+    int mem_fd_ = -1;       // Shared by map_physical(), opened on first use
+};
+
+/**
+ * @brief Host-only stand-in for the board
+ *
+ * The 32-bit physical address space is one sparse memfd, so any code that
+ * mmaps open_mem() at a physical address sees the same bytes as the
+ * register accessors, exactly like /dev/mem aliases. On top of that memory:
+ *
+ *   - LocalMem data movers (add_local_mem): LMEM_INFO reports 15 channels of
+ *     64 KB. A TRIGGER write on the ADC mover fills every enabled ADC
+ *     channel from its loopback source and clears the trigger bit; a DAC
+ *     TRIGGER just completes. A DAC channel is a live source while its
+ *     ENABLE bit is set, and plays its ENDADDR samples cyclically.
+ *   - Clock wizards (add_clock_wizard): the MMCM reports lock, and relocks
+ *     on every reset/load.
+ *   - Device nodes: one memfd per path, shared by every open.
+ *   - sysfs: an in-memory attribute store.
+ *
+ * Loopback: ADC memory channel k receives DAC memory channel k (REAL) unless
+ * connect() says otherwise; an I/Q route writes interleaved I,Q pairs the
+ * way a non-high-speed ADC in I/Q mode lays them out. Samples are
+ * source * gain + uniform noise, delayed by delay_samples.
+ */
+class Simulated : public Backend {
+public:
+    static constexpr uint64_t PHYS_SIZE = 1ull << 32;
+    static constexpr size_t DEVICE_SIZE = 256 * 1024 * 1024;
+    static constexpr uint32_t NUM_MEM_CHANNELS = 16;
+
+    struct LoopbackModel {
+        double gain = 0.5;
+        int32_t noise = 8;              // Peak noise, LSBs
+        uint32_t delay_samples = 0;     // Cable + datapath latency
+    };
+
+    struct Stats {
+        uint64_t adc_triggers = 0;
+        uint64_t dac_triggers = 0;
+        uint64_t samples_looped = 0;
+        uint64_t mmcm_resets = 0;
+    };
+
+    Simulated();
+    ~Simulated() override;
+
+    Kind kind() const override { return Kind::Simulated; }
+
+    int open_mem() override;
+    void* map_physical(uint64_t paddr, size_t bytes) override;
+    void unmap_physical(void* vaddr, size_t bytes) override;
+
+    uint32_t read32(const void* addr) override;
+    void write32(void* addr, uint32_t value) override;
+
+    int open_device(const std::string& path, int flags) override;
+    bool write_attr(const std::string& path, const std::string& value) override;
+    bool read_attr(const std::string& path, std::string& value) override;
+
+    /**
+     * @brief Place a LocalMem data mover at a physical address
+     * @param adc true for the ADC sink, false for the DAC source
+     * @param paddr Register block address (channel data follows it)
+     */
+    void add_local_mem(bool adc, uint64_t paddr);
+
+    /**
+     * @brief Place a clock wizard at a physical address
+     */
+    void add_clock_wizard(uint64_t paddr);
+
+    /**
+     * @brief Route DAC memory channels into an ADC memory channel
+     * @param adc_channel ADC memory channel
+     * @param dac_i DAC memory channel for I (or REAL)
+     * @param dac_q DAC memory channel for Q, or -1 for a REAL route
+     */
+    void connect(uint32_t adc_channel, int dac_i, int dac_q = -1);
+
+    void set_model(const LoopbackModel& model);
+    LoopbackModel model() const;
+    Stats stats() const;
+
+    /**
+     * @brief Host pointer to physical memory (tests and diagnostics)
+     */
+    uint8_t* physical(uint64_t paddr) { return phys_ + paddr; }
+
+private:
+    struct Route {
+        int dac_i = -1;
+        int dac_q = -1;
+    };
+
+    mutable std::mutex mutex_;
+    int mem_fd_ = -1;
+    uint8_t* phys_ = nullptr;           // Whole PHYS_SIZE mapping of mem_fd_
+
+    uint64_t adc_lmem_ = 0;
+    uint64_t dac_lmem_ = 0;
+    bool have_adc_ = false;
+    bool have_dac_ = false;
+    std::vector<uint64_t> clock_wizards_;
+    std::array<Route, NUM_MEM_CHANNELS> routes_;
+
+    LoopbackModel model_;
+    Stats stats_;
+    uint32_t noise_state_ = 0x1234567;
+
+    std::map<std::string, int> devices_;
+    std::map<std::string, std::string> attrs_;
+
+    uint32_t reg(uint64_t paddr) const;
+    void set_reg(uint64_t paddr, uint32_t value);
+    uint64_t channel_base(uint64_t lmem, uint32_t channel) const;
+    size_t channel_bytes(uint64_t lmem) const;
+
+    void on_write(uint64_t paddr, uint32_t value);
+    void run_adc_capture();
+    int16_t sample(const int16_t* src, uint32_t len, uint64_t index);
+};
+
+/**
+ * @brief Backend used by every module
+ *
+ * At startup this is Hardware, or the RFDC_BACKEND environment variable if
+ * set (hw, sim).
+ */
+Backend& active();
+
+/**
+ * @brief Replace the active backend; call before any hardware is touched
+ */
+void select(Kind kind);
+
+/**
+ * @brief The active backend if it is Simulated, else nullptr
+ */
+Simulated* simulator();
+
+const char* to_string(Kind kind);
+bool parse_kind(const std::string& name, Kind& kind);
+
+} // namespace hw_backend
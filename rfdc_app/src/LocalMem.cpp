@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cstring>
 #include <unistd.h>
+#include <thread>
 
 namespace local_mem {
 
@@ -10,60 +11,29 @@ LocalMem::LocalMem(rfdc::RFDC* rfdc)
 {
 }
 
-void LocalMem::write_reg32(void* addr, uint32_t value) {
-    volatile uint32_t* reg = static_cast<volatile uint32_t*>(addr);
-    *reg = value;
-}
-
-uint32_t LocalMem::read_reg32(void* addr) {
-    volatile uint32_t* reg = static_cast<volatile uint32_t*>(addr);
-    return *reg;
-}
-
 bool LocalMem::set_sample_count(rfdc::TileType type,
                                 uint32_t tile_id,
                                 uint32_t block_id,
                                 uint32_t num_samples,
-                                void* mem_base_addr,
-                                const void* channel_map)
+                                void* mem_base_addr)
 {
-    if (!mem_base_addr || !channel_map) {
-        std::cerr << "Invalid memory base address or channel map\n";
+    mmio::Operation op("lmem.set_sample_count");
+    if (!mem_base_addr) {
+        std::cerr << "Invalid memory base address\n";
         return false;
     }
     
-    // Cast channel_map to appropriate structure
-    // Assuming channel map has Channel_I member at known offset
-    struct ChannelMapEntry {
-        uint32_t addr_I;
-        uint32_t addr_Q;
-        uint16_t Channel_I;
-        uint16_t Channel_Q;
-    };
-    const ChannelMapEntry* map = static_cast<const ChannelMapEntry*>(channel_map);
-    
-    // Calculate numblockpertile based on type and ADC speed
-    uint32_t numblockpertile = 4;
-    if (type == rfdc::TileType::ADC) {
-        // For high-speed ADC (4GSPS), only 2 blocks per tile
-        numblockpertile = rfdc_->check_high_speed_adc(tile_id) ? 2 : 4;
-    }
-    
-    uint32_t numsamples_channel = num_samples;
-    
-    // For ADC in IQ mode, double the sample count
-    if (type == rfdc::TileType::ADC && !rfdc_->check_high_speed_adc(tile_id)) {
-        auto mixer = rfdc_->get_mixer_settings(type, tile_id, block_id);
-        
-        // Check if in IQ mode (not R2R and not bypassed)
-        bool is_r2r = (mixer.mode() == rfdc::MixerMode::R2R);
-        bool is_bypass = (mixer.type() == rfdc::MixerType::Coarse &&
-                         mixer.frequency() == XRFDC_COARSE_MIX_BYPASS);
-        
-        if (!is_r2r && !is_bypass) {
-            numsamples_channel = num_samples * 2;
-        }
+    const Topology& topo = topology(type);
+    uint32_t channel_index = tile_id < NUM_TILES ? topo.index(tile_id, block_id) : NUM_CHANNELS;
+    if (channel_index >= NUM_CHANNELS || !topo.slots[channel_index].valid) {
+        std::cerr << "No memory channel for " << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
+                  << "[" << tile_id << "][" << block_id << "]\n";
+        return false;
     }
+    const ChannelSlot& slot = topo.slots[channel_index];
+    
+    // ADC in IQ mode (non high-speed) stores interleaved I,Q: twice the words
+    uint32_t numsamples_channel = num_samples * slot.sample_multiplier;
     
     // Validate sample count is multiple of 16
     if ((numsamples_channel % 16) != 0) {
@@ -72,104 +42,233 @@ bool LocalMem::set_sample_count(rfdc::TileType type,
         return false;
     }
     
-    // Calculate register address
-    uint32_t channel_index = (tile_id * numblockpertile) + block_id;
-    uint32_t channel_i = map[channel_index].Channel_I;
-    
-    void* reg_addr = static_cast<char*>(mem_base_addr) + LMEM0_ENDADDR + (channel_i * 4);
-    
     // Write sample count to hardware register
-    write_reg32(reg_addr, numsamples_channel);
+    const mmio::Block lmem = regs(type, mem_base_addr);
+    lmem.write(mmio::lmem::endaddr(slot.mem_i), numsamples_channel);
+    
+    // For high-speed ADC, also set Q channel
+    if (slot.split_q) {
+        lmem.write(mmio::lmem::endaddr(slot.mem_q), numsamples_channel);
+    }
     
     std::cout << "  • Set sample count: " << numsamples_channel 
               << " for " << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
               << "[" << tile_id << "][" << block_id << "]\n";
     
-    // For high-speed ADC, also set Q channel
-    if (type == rfdc::TileType::ADC && rfdc_->check_high_speed_adc(tile_id)) {
-        uint32_t channel_q = map[channel_index].Channel_Q;
-        void* reg_addr_q = static_cast<char*>(mem_base_addr) + LMEM0_ENDADDR + (channel_q * 4);
-        write_reg32(reg_addr_q, numsamples_channel);
-    }
-    
     return true;
 }
 
 bool LocalMem::trigger(rfdc::TileType type,
                       void* mem_base_addr,
-                      uint32_t channel_mask,
-                      const void* channel_map)
+                      uint32_t channel_mask)
 {
-    if (!mem_base_addr || !channel_map) {
-        std::cerr << "Invalid memory base address or channel map\n";
+    mmio::Operation op("lmem.trigger");
+    if (!mem_base_addr) {
+        std::cerr << "Invalid memory base address\n";
         return false;
     }
     
-    struct ChannelMapEntry {
-        uint32_t addr_I;
-        uint32_t addr_Q;
-        uint16_t Channel_I;
-        uint16_t Channel_Q;
-    };
-    const ChannelMapEntry* map = static_cast<const ChannelMapEntry*>(channel_map);
+    // Resolve the enable mask before touching the hardware so the register
+    // writes below go out back to back
+    uint32_t mem_ids = 0;
+    if (channel_mask != 0) {
+        const Topology& topo = topology(type);
+        for (uint32_t i = 0; i < NUM_CHANNELS; i++) {
+            if ((channel_mask >> i) & 0x1) {
+                mem_ids |= topo.slots[i].enable_bits;
+            }
+        }
+    }
     
     // Disable all channels first
-    write_reg32(static_cast<char*>(mem_base_addr) + LMEM_ENABLE_TILE, 0);
-    write_reg32(static_cast<char*>(mem_base_addr) + LMEM_ENABLE, 0);
+    const mmio::Block lmem = regs(type, mem_base_addr);
+    mmio::Batch batch;
+    batch.write(lmem, mmio::lmem::ENABLE_TILE, 0)
+         .write(lmem, mmio::lmem::ENABLE, 0);
     
     if (channel_mask == 0) {
         // Reset/stop mode - just return after disabling
+        batch.apply();
         std::cout << "  • Reset " << (type == rfdc::TileType::DAC ? "DAC" : "ADC") << " trigger\n";
         return true;
     }
     
-    // Build memory enable mask
-    uint32_t mem_ids = 0;
-    uint32_t tile_id = 0;
-    uint32_t blocks_in_tile = 0;
-    uint32_t num_blocks = 4;
-    
-    for (uint32_t i = 0; i < 16; i++) {
-        // Determine tile boundaries
-        if (type == rfdc::TileType::ADC) {
-            num_blocks = rfdc_->check_high_speed_adc(tile_id) ? 2 : 4;
-        }
-        
-        if (blocks_in_tile == num_blocks) {
-            tile_id++;
-            blocks_in_tile = 0;
-        }
-        
-        // Check if this channel is in the mask
-        if ((channel_mask >> i) & 0x1) {
-            // Enable I channel
-            mem_ids |= (0x01 << map[i].Channel_I);
+    // Enable selected memory channels, issue the trigger, enable all tiles
+    batch.write(lmem, mmio::lmem::ENABLE, mem_ids)
+         .set(lmem, mmio::lmem::TRIGGER_START, 1)
+         .write(lmem, mmio::lmem::ENABLE_TILE, mmio::lmem::ALL_TILES)
+         .apply();
+    
+    std::cout << "  • Memory enable mask: 0x" << std::hex << mem_ids << std::dec << "\n";
+    std::cout << "  • Triggered data mover\n";
+    
+    return true;
+}
+
+const LocalMem::Topology& LocalMem::topology(rfdc::TileType type)
+{
+    Topology& topo = (type == rfdc::TileType::DAC) ? dac_topology_ : adc_topology_;
+    if (!topo.built || topo.generation != rfdc_->config_generation()) {
+        build_topology(type, topo);
+    }
+    return topo;
+}
+
+void LocalMem::refresh_topology()
+{
+    build_topology(rfdc::TileType::ADC, adc_topology_);
+    build_topology(rfdc::TileType::DAC, dac_topology_);
+}
+
+void LocalMem::build_topology(rfdc::TileType type, Topology& topo)
+{
+    const auto& map = (type == rfdc::TileType::DAC) ? rfdc_->get_dac_map()
+                                                    : rfdc_->get_adc_map();
+    const uint32_t invalid = 0xFFFFFFFF;
+    
+    topo = Topology();
+    topo.generation = rfdc_->config_generation();
+    
+    for (uint32_t tile = 0; tile < NUM_TILES; tile++) {
+        // For high-speed ADC (4GSPS), only 2 blocks per tile
+        bool high_speed = (type == rfdc::TileType::ADC) && rfdc_->check_high_speed_adc(tile);
+        topo.high_speed[tile] = high_speed;
+        topo.blocks_per_tile[tile] = high_speed ? 2 : 4;
+    }
+    
+    for (uint32_t tile = 0; tile < NUM_TILES; tile++) {
+        for (uint32_t block = 0; block < topo.blocks_per_tile[tile]; block++) {
+            uint32_t idx = topo.index(tile, block);
+            if (idx >= NUM_CHANNELS || map[idx].Channel_I == invalid) {
+                continue;
+            }
+            
+            ChannelSlot& slot = topo.slots[idx];
+            slot.valid = true;
+            slot.tile = tile;
+            slot.block = block;
+            slot.mem_i = map[idx].Channel_I;
+            slot.mem_q = map[idx].Channel_Q != invalid ? map[idx].Channel_Q : slot.mem_i;
+            slot.split_q = topo.high_speed[tile] && slot.mem_q != slot.mem_i;
+            slot.enable_bits = (0x01u << slot.mem_i);
+            if (slot.split_q) {
+                slot.enable_bits |= (0x01u << slot.mem_q);
+            }
             
-            // For high-speed ADC, also enable Q channel
-            if (type == rfdc::TileType::ADC && rfdc_->check_high_speed_adc(tile_id)) {
-                mem_ids |= (0x01 << map[i].Channel_Q);
+            // Check if in IQ mode (not R2R and not bypassed)
+            if (type == rfdc::TileType::ADC && !topo.high_speed[tile]) {
+                auto mixer = rfdc_->get_mixer_settings(type, tile, block);
+                bool is_r2r = (mixer.mode() == rfdc::MixerMode::R2R);
+                bool is_bypass = (mixer.type() == rfdc::MixerType::Coarse &&
+                                 mixer.frequency() == XRFDC_COARSE_MIX_BYPASS);
+                if (!is_r2r && !is_bypass) {
+                    slot.sample_multiplier = 2;
+                }
             }
         }
-        
-        blocks_in_tile++;
     }
     
-    // Enable selected memory channels
-    write_reg32(static_cast<char*>(mem_base_addr) + LMEM_ENABLE, mem_ids);
+    topo.built = true;
+}
+
+bool LocalMem::trigger_loopback(void* dac_base, uint32_t dac_mask,
+                                void* adc_base, uint32_t adc_mask,
+                                LoopbackTiming* timing,
+                                const std::function<void()>& after_fire)
+{
+    mmio::Operation op("lmem.trigger_loopback");
+    if (!dac_base || !adc_base || dac_mask == 0 || adc_mask == 0) {
+        std::cerr << "Invalid loopback trigger arguments\n";
+        return false;
+    }
     
-    std::cout << "  • Memory enable mask: 0x" << std::hex << mem_ids << std::dec << "\n";
+    uint32_t dac_ids = 0;
+    uint32_t adc_ids = 0;
+    const Topology& dac = topology(rfdc::TileType::DAC);
+    const Topology& adc = topology(rfdc::TileType::ADC);
+    for (uint32_t i = 0; i < NUM_CHANNELS; i++) {
+        if ((dac_mask >> i) & 0x1) {
+            dac_ids |= dac.slots[i].enable_bits;
+        }
+        if ((adc_mask >> i) & 0x1) {
+            adc_ids |= adc.slots[i].enable_bits;
+        }
+    }
+    if (dac_ids == 0 || adc_ids == 0) {
+        std::cerr << "Loopback trigger: no mapped DAC or ADC channel in the masks\n";
+        return false;
+    }
     
-    // Issue the trigger
-    write_reg32(static_cast<char*>(mem_base_addr) + LMEM_TRIGGER, 0x1);
+    const mmio::Block dac_regs = regs(rfdc::TileType::DAC, dac_base);
+    const mmio::Block adc_regs = regs(rfdc::TileType::ADC, adc_base);
     
-    // Enable all tiles
-    write_reg32(static_cast<char*>(mem_base_addr) + LMEM_ENABLE_TILE, 0xF);
+    // Arm: stop both movers, then select their channels
+    mmio::Batch arm;
+    arm.write(dac_regs, mmio::lmem::ENABLE_TILE, 0)
+       .write(adc_regs, mmio::lmem::ENABLE_TILE, 0)
+       .write(dac_regs, mmio::lmem::ENABLE, 0)
+       .write(adc_regs, mmio::lmem::ENABLE, 0)
+       .write(dac_regs, mmio::lmem::ENABLE, dac_ids)
+       .write(adc_regs, mmio::lmem::ENABLE, adc_ids);
     
-    std::cout << "  • Triggered data mover\n";
+    // Fire: DAC first so the ADC window opens on a playing waveform
+    mmio::Batch fire;
+    fire.set(dac_regs, mmio::lmem::TRIGGER_START, 1)
+        .set(adc_regs, mmio::lmem::TRIGGER_START, 1)
+        .write(dac_regs, mmio::lmem::ENABLE_TILE, mmio::lmem::ALL_TILES)
+        .write(adc_regs, mmio::lmem::ENABLE_TILE, mmio::lmem::ALL_TILES);
+    
+    auto t_arm = std::chrono::steady_clock::now();
+    arm.apply();
+    auto t_dac = std::chrono::steady_clock::now();
+    fire.apply();
+    if (after_fire) {
+        after_fire();
+    }
+    auto t_adc = std::chrono::steady_clock::now();
+    
+    if (timing) {
+        timing->dac_fired = t_dac;
+        timing->adc_fired = t_adc;
+        timing->arm = t_dac - t_arm;
+        timing->skew = t_adc - t_dac;
+    }
+    
+    std::cout << "  • Loopback trigger: DAC mask 0x" << std::hex << dac_ids
+              << ", ADC mask 0x" << adc_ids << std::dec << ", skew "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(t_adc - t_dac).count()
+              << " ns\n";
     
     return true;
 }
 
+bool LocalMem::wait_trigger_done(void* mem_base_addr, std::chrono::microseconds timeout)
+{
+    mmio::Operation op("lmem.wait_done");
+    if (!mem_base_addr) {
+        return false;
+    }
+    
+    const mmio::Block lmem(mem_base_addr, "lmem");
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    
+    // Short captures finish within a few register reads; spin briefly
+    // before backing off to sleeps so long ones don't burn a core.
+    for (int spins = 0; ; ++spins) {
+        if (lmem.read(mmio::lmem::TRIGGER_START) == 0) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        if (spins < 256) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
 LocalMem::MemInfo LocalMem::get_mem_info(rfdc::TileType type, void* mem_base_addr)
 {
     MemInfo info = {};
@@ -179,15 +278,11 @@ LocalMem::MemInfo LocalMem::get_mem_info(rfdc::TileType type, void* mem_base_add
     }
     
     // Read memory info register
-    uint32_t data = read_reg32(static_cast<char*>(mem_base_addr) + LMEM_INFO);
-    
-    // Parse bit fields
-    constexpr uint32_t MEM_SIZE_MASK = 0x00FFFFFF;
-    constexpr uint32_t MEM_NUM_MASK = 0x7F;
-    constexpr uint32_t MEM_NUM_SHIFT = 24;
+    const mmio::Block lmem = regs(type, mem_base_addr);
+    uint32_t data = lmem.read(mmio::lmem::INFO);
     
-    info.num_mem = (data >> MEM_NUM_SHIFT) & MEM_NUM_MASK;
-    info.mem_size = (data & MEM_SIZE_MASK) / (info.num_mem + 1) / 16;
+    info.num_mem = mmio::lmem::INFO_NUM_MEM.decode(data);
+    info.mem_size = mmio::lmem::INFO_MEM_SIZE.decode(data) / (info.num_mem + 1) / 16;
     
     // Get fabric words from RFDC
     uint32_t fab_words = 0;
@@ -201,7 +296,7 @@ LocalMem::MemInfo LocalMem::get_mem_info(rfdc::TileType type, void* mem_base_add
     info.num_words = fab_words;
     
     // Read enable register
-    data = read_reg32(static_cast<char*>(mem_base_addr) + LMEM_ENABLE);
+    data = lmem.read(mmio::lmem::ENABLE);
     info.mem_enable = data;
     info.mem_clksel = 0;
     
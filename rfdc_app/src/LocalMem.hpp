@@ -2,7 +2,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <chrono>
+#include <array>
+#include <functional>
 #include "rfdc_wrapper/RfDc.hpp"
+#include "Mmio.hpp"
 
 namespace local_mem {
 
@@ -14,12 +18,12 @@ namespace local_mem {
  */
 class LocalMem {
 public:
-    // Register offsets (from RFTool local_mem.h)
-    static constexpr uint32_t LMEM_INFO = 0x00;
-    static constexpr uint32_t LMEM_TRIGGER = 0x04;
-    static constexpr uint32_t LMEM_ENABLE = 0x08;
-    static constexpr uint32_t LMEM_ENABLE_TILE = 0x0C;
-    static constexpr uint32_t LMEM0_ENDADDR = 0x10;
+    // Register offsets (from RFTool local_mem.h; fields in mmio::lmem)
+    static constexpr uint32_t LMEM_INFO = mmio::lmem::INFO;
+    static constexpr uint32_t LMEM_TRIGGER = mmio::lmem::TRIGGER;
+    static constexpr uint32_t LMEM_ENABLE = mmio::lmem::ENABLE;
+    static constexpr uint32_t LMEM_ENABLE_TILE = mmio::lmem::ENABLE_TILE;
+    static constexpr uint32_t LMEM0_ENDADDR = mmio::lmem::ENDADDR0;
     
     // Memory type
     enum class MemType {
@@ -36,6 +40,42 @@ public:
         int mem_clksel;
     };
     
+    static constexpr uint32_t NUM_CHANNELS = 16;
+    static constexpr uint32_t NUM_TILES = 4;
+    
+    /**
+     * @brief One converter block as seen by the data mover
+     */
+    struct ChannelSlot {
+        bool valid = false;
+        uint32_t tile = 0;
+        uint32_t block = 0;
+        uint32_t mem_i = 0;              // Memory channel holding I (or REAL)
+        uint32_t mem_q = 0;              // Memory channel holding Q (== mem_i unless split)
+        bool split_q = false;            // High-speed ADC in I/Q: Q has its own channel
+        uint32_t sample_multiplier = 1;  // Words per sample (2: interleaved I,Q)
+        uint32_t enable_bits = 0;        // LMEM_ENABLE bits for this block
+    };
+    
+    /**
+     * @brief Channel/tile layout of one data mover
+     *
+     * Built from the RFDC channel maps and mixer setup, so the trigger and
+     * sample-count paths never go back to the driver.
+     */
+    struct Topology {
+        uint64_t generation = 0;         // RFDC::config_generation() it was built from
+        bool built = false;
+        std::array<uint32_t, NUM_TILES> blocks_per_tile{};
+        std::array<bool, NUM_TILES> high_speed{};
+        std::array<ChannelSlot, NUM_CHANNELS> slots{};
+        
+        // Slot index used by the channel masks: tile * blocks_per_tile + block
+        uint32_t index(uint32_t tile_id, uint32_t block_id) const {
+            return tile_id * blocks_per_tile[tile_id] + block_id;
+        }
+    };
+    
     /**
      * @brief Construct LocalMem controller
      * @param rfdc Pointer to RFDC instance (for mixer/PLL queries)
@@ -49,28 +89,64 @@ public:
      * @param block_id Block ID
      * @param num_samples Number of samples to transfer
      * @param mem_base_addr Base address of memory region
-     * @param channel_map Pointer to channel map array
      * @return true on success
      */
     bool set_sample_count(rfdc::TileType type, 
                          uint32_t tile_id,
                          uint32_t block_id,
                          uint32_t num_samples,
-                         void* mem_base_addr,
-                         const void* channel_map);
+                         void* mem_base_addr);
     
     /**
      * @brief Trigger data transfer for specified channels
      * @param type DAC or ADC
      * @param mem_base_addr Base address of memory region
-     * @param channel_mask Bitmask of channels to trigger
-     * @param channel_map Pointer to channel map array
+     * @param channel_mask Bitmask of channels to trigger (Topology::index)
      * @return true on success
      */
     bool trigger(rfdc::TileType type,
                 void* mem_base_addr,
-                uint32_t channel_mask,
-                const void* channel_map);
+                uint32_t channel_mask);
+    
+    /**
+     * @brief Software-side timing of a combined DAC+ADC trigger
+     */
+    struct LoopbackTiming {
+        std::chrono::steady_clock::time_point dac_fired;    // Before the DAC tile enable
+        std::chrono::steady_clock::time_point adc_fired;    // After the ADC tile enable and after_fire
+        std::chrono::nanoseconds arm{0};    // Disable + channel enables, both movers
+        std::chrono::nanoseconds skew{0};   // DAC fire → ADC fire (upper bound)
+    };
+    
+    /**
+     * @brief Arm the DAC and ADC data movers and fire them back to back
+     *
+     * Both movers are disabled and given their channel enables first; the
+     * two triggers and tile enables then go out with nothing in between,
+     * so DAC→ADC alignment only depends on bus latency. Nothing is logged
+     * until both have fired.
+     *
+     * @param dac_base DAC data mover registers
+     * @param dac_mask DAC channels to play (Topology::index bits)
+     * @param adc_base ADC data mover registers
+     * @param adc_mask ADC channels to capture (Topology::index bits)
+     * @param timing Optional: filled with the measured timing
+     * @param after_fire Optional: the rest of the start sequence (e.g. plmem
+     *        triggers), run right after both movers fire and timed with them
+     * @return true on success
+     */
+    bool trigger_loopback(void* dac_base, uint32_t dac_mask,
+                          void* adc_base, uint32_t adc_mask,
+                          LoopbackTiming* timing = nullptr,
+                          const std::function<void()>& after_fire = nullptr);
+    
+    /**
+     * @brief Poll the data mover until the trigger bit self-clears
+     * @param mem_base_addr Base address of memory region
+     * @param timeout Maximum time to wait
+     * @return true if the transfer finished before the timeout
+     */
+    bool wait_trigger_done(void* mem_base_addr, std::chrono::microseconds timeout);
     
     /**
      * @brief Get memory information from hardware
@@ -80,14 +156,28 @@ public:
      */
     MemInfo get_mem_info(rfdc::TileType type, void* mem_base_addr);
     
+    /**
+     * @brief Layout for DAC or ADC, rebuilt first if the RFDC configuration
+     *        changed since it was last built
+     */
+    const Topology& topology(rfdc::TileType type);
+    
+    /**
+     * @brief Rebuild both tables now (e.g. after configuring tiles, so the
+     *        first trigger does not pay for it)
+     */
+    void refresh_topology();
+    
 private:
     rfdc::RFDC* rfdc_;
+    Topology adc_topology_;
+    Topology dac_topology_;
     
-    // Helper to write 32-bit value to memory-mapped register
-    void write_reg32(void* addr, uint32_t value);
+    void build_topology(rfdc::TileType type, Topology& topo);
     
-    // Helper to read 32-bit value from memory-mapped register
-    uint32_t read_reg32(void* addr);
+    static mmio::Block regs(rfdc::TileType type, void* mem_base_addr) {
+        return mmio::Block(mem_base_addr, type == rfdc::TileType::DAC ? "lmem_dac" : "lmem_adc");
+    }
 };
 
 } // namespace local_mem
\ No newline at end of file
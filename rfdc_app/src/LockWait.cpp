@@ -0,0 +1,109 @@
+#include "LockWait.hpp"
+#include "StreamFormat.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace lock_wait {
+
+namespace {
+
+std::mutex stats_mutex;
+std::map<std::string, Stats> stats_by_label;
+
+double to_us(std::chrono::nanoseconds t)
+{
+    return std::chrono::duration<double, std::micro>(t).count();
+}
+
+} // namespace
+
+// ===== Backoff =====
+
+Backoff::Backoff(const Policy& policy)
+    : policy_(policy)
+    , start_(Clock::now())
+    , interval_(policy.first_poll)
+{
+}
+
+bool Backoff::sleep()
+{
+    const auto deadline = start_ + policy_.deadline;
+    const auto now = Clock::now();
+    if (now >= deadline) {
+        return false;
+    }
+    // Never sleep past the deadline: the caller gets one last round there
+    std::this_thread::sleep_for(std::min<Clock::duration>(interval_, deadline - now));
+    interval_ = std::min(interval_ * policy_.backoff, policy_.max_poll);
+    rounds_++;
+    return true;
+}
+
+std::chrono::nanoseconds Backoff::elapsed() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+}
+
+// ===== Statistics =====
+
+void record(const std::string& label, const Result& result)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    Stats& s = stats_by_label[label];
+    s.label = label;
+    s.waits++;
+    s.polls += result.polls;
+    s.last = result.time;
+    if (!result.locked) {
+        s.timeouts++;
+        return;
+    }
+    const bool first = (s.waits - s.timeouts == 1);
+    s.min = first ? result.time : std::min(s.min, result.time);
+    s.max = first ? result.time : std::max(s.max, result.time);
+    s.total += result.time;
+}
+
+std::vector<Stats> stats()
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    std::vector<Stats> out;
+    out.reserve(stats_by_label.size());
+    for (const auto& kv : stats_by_label) {
+        out.push_back(kv.second);
+    }
+    return out;
+}
+
+void reset_stats()
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats_by_label.clear();
+}
+
+void print_stats(std::ostream& os)
+{
+    auto all = stats();
+    if (all.empty()) {
+        os << "  (no lock waits recorded)\n";
+        return;
+    }
+    stream_format::Restore restore(os);
+    os << "  " << std::left << std::setw(14) << "Lock" << std::right
+       << std::setw(7) << "waits" << std::setw(10) << "timeouts" << std::setw(7) << "polls"
+       << std::setw(11) << "min us" << std::setw(11) << "mean us" << std::setw(11) << "max us"
+       << std::setw(11) << "last us" << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (const auto& s : all) {
+        os << "  " << std::left << std::setw(14) << s.label << std::right
+           << std::setw(7) << s.waits << std::setw(10) << s.timeouts << std::setw(7) << s.polls
+           << std::setw(11) << to_us(s.min) << std::setw(11) << to_us(s.mean())
+           << std::setw(11) << to_us(s.max) << std::setw(11) << to_us(s.last) << "\n";
+    }
+}
+
+} // namespace lock_wait
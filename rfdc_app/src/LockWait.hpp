@@ -0,0 +1,140 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lock_wait {
+
+/**
+ * @brief How to poll a lock bit
+ *
+ * The first poll comes after `first_poll`; each later interval is
+ * `backoff` times the previous one, capped at `max_poll`. A fast lock is
+ * seen within microseconds while a slow one costs a handful of reads.
+ */
+struct Policy {
+    std::chrono::microseconds first_poll{20};
+    std::chrono::microseconds max_poll{10000};
+    uint32_t backoff = 2;
+    std::chrono::microseconds deadline{1000000};
+};
+
+/**
+ * @brief Converter tile PLL: locks in a few ms, 1 s before giving up
+ */
+inline Policy pll_policy()
+{
+    Policy p;
+    p.first_poll = std::chrono::microseconds(100);
+    p.max_poll = std::chrono::microseconds(10000);
+    p.deadline = std::chrono::microseconds(1000000);
+    return p;
+}
+
+/**
+ * @brief Fabric clock MMCM: locks in tens of us, 100 ms before giving up
+ */
+inline Policy mmcm_policy()
+{
+    Policy p;
+    p.first_poll = std::chrono::microseconds(10);
+    p.max_poll = std::chrono::microseconds(1000);
+    p.deadline = std::chrono::microseconds(100000);
+    return p;
+}
+
+/**
+ * @brief Outcome of one wait
+ */
+struct Result {
+    bool locked = false;
+    std::chrono::nanoseconds time{0};   // Start of the wait → lock seen (or deadline)
+    uint32_t polls = 0;                 // Lock bit reads
+};
+
+/**
+ * @brief Poll schedule for callers that check several lock bits in one loop
+ *
+ * Call sleep() between rounds of checks; it returns false once the
+ * deadline has passed, after the caller's last round.
+ */
+class Backoff {
+public:
+    explicit Backoff(const Policy& policy);
+
+    bool sleep();
+    std::chrono::nanoseconds elapsed() const;
+    uint32_t rounds() const { return rounds_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Policy policy_;
+    Clock::time_point start_;
+    std::chrono::microseconds interval_;
+    uint32_t rounds_ = 1;
+};
+
+/**
+ * @brief Add one wait to the statistics under `label` (e.g. "PLL DAC 0")
+ */
+void record(const std::string& label, const Result& result);
+
+/**
+ * @brief Poll `is_locked` until it returns true or the deadline passes
+ *
+ * The first check is immediate. The result is recorded under `label`.
+ */
+template <typename Predicate>
+Result wait(const std::string& label, Predicate is_locked, const Policy& policy)
+{
+    Backoff backoff(policy);
+    Result result;
+    do {
+        if (is_locked()) {
+            result.locked = true;
+            break;
+        }
+    } while (backoff.sleep());
+    result.time = backoff.elapsed();
+    result.polls = backoff.rounds();
+    record(label, result);
+    return result;
+}
+
+/**
+ * @brief Lock times seen for one label since start or reset_stats()
+ *
+ * min/max/mean cover the waits that locked; timeouts are counted apart.
+ */
+struct Stats {
+    std::string label;
+    uint32_t waits = 0;
+    uint32_t timeouts = 0;
+    uint64_t polls = 0;
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds max{0};
+    std::chrono::nanoseconds total{0};  // Of the waits that locked
+    std::chrono::nanoseconds last{0};
+
+    std::chrono::nanoseconds mean() const {
+        const uint32_t locked = waits - timeouts;
+        return locked ? total / locked : std::chrono::nanoseconds(0);
+    }
+};
+
+/**
+ * @brief All labels, sorted
+ */
+std::vector<Stats> stats();
+void reset_stats();
+
+/**
+ * @brief One row per label: waits, timeouts, polls, min/mean/max/last in us
+ */
+void print_stats(std::ostream& os);
+
+} // namespace lock_wait
@@ -0,0 +1,332 @@
+#include "Mmio.hpp"
+#include "HwBackend.hpp"
+#include "StreamFormat.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace mmio {
+
+namespace {
+
+thread_local const Operation* current_op = nullptr;
+
+bool trace_from_env()
+{
+    const char* env = std::getenv("RFDC_MMIO_TRACE");
+    return env && std::strcmp(env, "1") == 0;
+}
+
+std::atomic<bool> trace_on{trace_from_env()};
+
+struct OpCounters {
+    uint64_t calls = 0;
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t redundant = 0;
+    std::chrono::nanoseconds time{0};
+};
+
+class Recorder {
+public:
+    void record(const char* block, const void* addr, uint32_t offset,
+                uint32_t value, bool write)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        record_locked(block, addr, offset, value, write);
+    }
+
+    void record_locked(const char* block, const void* addr, uint32_t offset,
+                       uint32_t value, bool write)
+    {
+        Access a;
+        a.time_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch_).count());
+        a.block = block;
+        a.offset = offset;
+        a.value = value;
+        a.write = write;
+        a.operation = current_operation();
+
+        OpCounters& op = ops_[a.operation];
+        if (write) {
+            auto it = last_written_.find(addr);
+            a.redundant = (it != last_written_.end() && it->second == value);
+            last_written_[addr] = value;
+            op.writes++;
+            op.redundant += a.redundant ? 1 : 0;
+        } else {
+            op.reads++;
+        }
+
+        if (accesses_.size() < capacity_) {
+            accesses_.push_back(a);
+        } else {
+            dropped_++;
+        }
+    }
+
+    void end_operation(const char* name, std::chrono::nanoseconds elapsed)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        OpCounters& op = ops_[name];
+        op.calls++;
+        op.time += elapsed;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accesses_.clear();
+        ops_.clear();
+        last_written_.clear();
+        dropped_ = 0;
+        epoch_ = std::chrono::steady_clock::now();
+    }
+
+    void set_capacity(size_t accesses)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = accesses;
+    }
+
+    std::vector<Access> snapshot()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return accesses_;
+    }
+
+    std::vector<trace::OperationStats> summary()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<trace::OperationStats> out;
+        for (const auto& kv : ops_) {
+            trace::OperationStats s;
+            s.name = kv.first[0] ? kv.first : "(none)";
+            s.calls = kv.second.calls;
+            s.reads = kv.second.reads;
+            s.writes = kv.second.writes;
+            s.redundant = kv.second.redundant;
+            s.time = kv.second.time;
+            out.push_back(std::move(s));
+        }
+        return out;
+    }
+
+    uint64_t dropped()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    std::mutex& mutex() { return mutex_; }
+
+private:
+    // Operation names are string literals: keyed by content so the same
+    // name from different translation units lands in one row
+    struct NameLess {
+        bool operator()(const char* a, const char* b) const { return std::strcmp(a, b) < 0; }
+    };
+
+    std::mutex mutex_;
+    std::vector<Access> accesses_;
+    std::map<const char*, OpCounters, NameLess> ops_;
+    std::unordered_map<const void*, uint32_t> last_written_;
+    size_t capacity_ = 65536;
+    uint64_t dropped_ = 0;
+    std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+};
+
+Recorder& recorder()
+{
+    static Recorder instance;
+    return instance;
+}
+
+} // namespace
+
+// ===== Block =====
+
+uint32_t Block::read(uint32_t offset) const
+{
+    const uint8_t* addr = base_ + offset;
+    uint32_t value = hw_backend::active().read32(addr);
+    if (trace_on.load(std::memory_order_relaxed)) {
+        recorder().record(name_, addr, offset, value, false);
+    }
+    return value;
+}
+
+void Block::write(uint32_t offset, uint32_t value) const
+{
+    uint8_t* addr = base_ + offset;
+    hw_backend::active().write32(addr, value);
+    if (trace_on.load(std::memory_order_relaxed)) {
+        recorder().record(name_, addr, offset, value, true);
+    }
+}
+
+void Block::modify(const Field& field, uint32_t value) const
+{
+    uint32_t reg = read(field.offset);
+    write(field.offset, (reg & ~field.mask()) | field.encode(value));
+}
+
+// ===== Batch =====
+
+Batch& Batch::write(const Block& block, uint32_t offset, uint32_t value)
+{
+    if (count_ == CAPACITY) {
+        apply();
+    }
+    writes_[count_++] = Write{ &block, offset, value };
+    return *this;
+}
+
+Batch& Batch::set(const Block& block, const Field& field, uint32_t value)
+{
+    if (count_ > 0 && writes_[count_ - 1].block == &block &&
+        writes_[count_ - 1].offset == field.offset) {
+        Write& w = writes_[count_ - 1];
+        w.value = (w.value & ~field.mask()) | field.encode(value);
+        return *this;
+    }
+    return write(block, field.offset, field.encode(value));
+}
+
+void Batch::apply()
+{
+    hw_backend::Backend& backend = hw_backend::active();
+    if (!trace_on.load(std::memory_order_relaxed)) {
+        for (size_t i = 0; i < count_; ++i) {
+            backend.write32(static_cast<uint8_t*>(writes_[i].block->base()) + writes_[i].offset,
+                            writes_[i].value);
+        }
+    } else {
+        Recorder& rec = recorder();
+        std::lock_guard<std::mutex> lock(rec.mutex());
+        for (size_t i = 0; i < count_; ++i) {
+            uint8_t* addr = static_cast<uint8_t*>(writes_[i].block->base()) + writes_[i].offset;
+            backend.write32(addr, writes_[i].value);
+            rec.record_locked(writes_[i].block->name(), addr, writes_[i].offset,
+                              writes_[i].value, true);
+        }
+    }
+    count_ = 0;
+}
+
+// ===== Operation =====
+
+Operation::Operation(const char* name)
+    : name_(name)
+    , parent_(current_op)
+    , timed_(trace_on.load(std::memory_order_relaxed))
+{
+    if (timed_) {
+        start_ = std::chrono::steady_clock::now();
+    }
+    current_op = this;
+}
+
+Operation::~Operation()
+{
+    current_op = parent_;
+    if (timed_) {
+        recorder().end_operation(name_, std::chrono::steady_clock::now() - start_);
+    }
+}
+
+const char* current_operation()
+{
+    return current_op ? current_op->name_ : "";
+}
+
+// ===== Trace =====
+
+namespace trace {
+
+void enable(bool on)
+{
+    if (on && !trace_on.load()) {
+        recorder().clear();
+    }
+    trace_on.store(on);
+}
+
+bool enabled()
+{
+    return trace_on.load(std::memory_order_relaxed);
+}
+
+void clear()
+{
+    recorder().clear();
+}
+
+void set_capacity(size_t accesses)
+{
+    recorder().set_capacity(accesses);
+}
+
+std::vector<Access> snapshot()
+{
+    return recorder().snapshot();
+}
+
+std::vector<OperationStats> summary()
+{
+    return recorder().summary();
+}
+
+uint64_t dropped()
+{
+    return recorder().dropped();
+}
+
+void print_summary(std::ostream& os)
+{
+    stream_format::Restore restore(os);
+    auto stats = summary();
+    os << "  " << std::left << std::setw(26) << "Operation" << std::right
+       << std::setw(7) << "calls" << std::setw(8) << "reads" << std::setw(8) << "writes"
+       << std::setw(11) << "redundant" << std::setw(12) << "us/call" << "\n";
+    for (const auto& s : stats) {
+        double us = s.calls ? std::chrono::duration<double, std::micro>(s.time).count() / s.calls : 0.0;
+        os << "  " << std::left << std::setw(26) << s.name << std::right
+           << std::setw(7) << s.calls << std::setw(8) << s.reads << std::setw(8) << s.writes
+           << std::setw(11) << s.redundant << std::setw(12) << std::fixed
+           << std::setprecision(2) << us << "\n";
+    }
+    os.unsetf(std::ios::fixed);
+
+    auto accesses = snapshot();
+    size_t shown = 0;
+    for (const auto& a : accesses) {
+        if (!a.write || !a.redundant) {
+            continue;
+        }
+        if (shown++ == 0) {
+            os << "\n  Redundant writes (same value as the previous write):\n";
+        }
+        if (shown > 20) {
+            continue;
+        }
+        os << "    " << std::setw(10) << a.time_ns << " ns  " << a.block << "+0x" << std::hex
+           << a.offset << " = 0x" << a.value << std::dec << "  ["
+           << (a.operation[0] ? a.operation : "(none)") << "]\n";
+    }
+    if (shown > 20) {
+        os << "    ... " << (shown - 20) << " more\n";
+    }
+    if (dropped() > 0) {
+        os << "  ⚠ " << dropped() << " accesses not recorded (capacity)\n";
+    }
+}
+
+} // namespace trace
+
+} // namespace mmio
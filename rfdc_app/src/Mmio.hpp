@@ -0,0 +1,204 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mmio {
+
+/**
+ * @brief Bit field of a 32-bit register
+ */
+struct Field {
+    uint32_t offset;
+    uint32_t shift;
+    uint32_t width;
+
+    constexpr uint32_t mask() const {
+        return (width >= 32 ? 0xFFFFFFFFu : ((1u << width) - 1u)) << shift;
+    }
+    constexpr uint32_t encode(uint32_t value) const { return (value << shift) & mask(); }
+    constexpr uint32_t decode(uint32_t reg) const { return (reg & mask()) >> shift; }
+};
+
+/**
+ * @brief LocalMem data mover (RFTool local_mem.h)
+ */
+namespace lmem {
+constexpr uint32_t INFO = 0x00;
+constexpr uint32_t TRIGGER = 0x04;
+constexpr uint32_t ENABLE = 0x08;           // One bit per memory channel
+constexpr uint32_t ENABLE_TILE = 0x0C;
+constexpr uint32_t ENDADDR0 = 0x10;         // Sample count, one register per channel
+constexpr uint32_t endaddr(uint32_t channel) { return ENDADDR0 + 4 * channel; }
+
+constexpr Field INFO_MEM_SIZE{INFO, 0, 24};
+constexpr Field INFO_NUM_MEM{INFO, 24, 7};
+constexpr Field TRIGGER_START{TRIGGER, 0, 1};   // Self-clears when the transfer is done
+
+constexpr uint32_t ALL_TILES = 0xF;
+} // namespace lmem
+
+/**
+ * @brief Clocking Wizard dynamic reconfiguration (PG065)
+ */
+namespace clk_wiz {
+constexpr uint32_t RESET = 0x00;
+constexpr uint32_t STATUS = 0x04;
+constexpr uint32_t CLK_CONFIG0 = 0x200;
+constexpr uint32_t CLKOUT0 = 0x208;
+constexpr uint32_t CLKOUT1 = 0x214;
+constexpr uint32_t LOAD = 0x25C;
+
+constexpr Field STATUS_LOCKED{STATUS, 0, 1};
+constexpr Field CONFIG0_DIVCLK{CLK_CONFIG0, 0, 8};
+constexpr Field CONFIG0_MULT{CLK_CONFIG0, 8, 8};
+constexpr Field CONFIG0_MULT_FRAC{CLK_CONFIG0, 16, 10};
+constexpr Field CLKOUT0_DIV{CLKOUT0, 0, 8};
+constexpr Field CLKOUT0_FRAC{CLKOUT0, 8, 10};
+constexpr Field CLKOUT1_DIV{CLKOUT1, 0, 8};
+
+constexpr uint32_t LOAD_APPLY = 0x03;       // LOAD | SADDR: apply CLK_CONFIG/CLKOUT
+constexpr uint32_t RESET_KEY = 0x0A;        // Software reset
+} // namespace clk_wiz
+
+/**
+ * @brief A mapped register block
+ *
+ * Accesses go through hw_backend (so the simulator sees them) and are
+ * recorded when tracing is on. Cheap to construct: a pointer and a name.
+ */
+class Block {
+public:
+    Block() = default;
+    Block(void* base, const char* name) : base_(static_cast<uint8_t*>(base)), name_(name) {}
+
+    bool valid() const { return base_ != nullptr; }
+    void* base() const { return base_; }
+    const char* name() const { return name_; }
+
+    uint32_t read(uint32_t offset) const;
+    void write(uint32_t offset, uint32_t value) const;
+
+    uint32_t read(const Field& field) const { return field.decode(read(field.offset)); }
+    // Read-modify-write of one field
+    void modify(const Field& field, uint32_t value) const;
+
+private:
+    uint8_t* base_ = nullptr;
+    const char* name_ = "";
+};
+
+/**
+ * @brief Ordered write sequence, issued back to back
+ *
+ * Addresses are resolved while the batch is built; apply() then issues the
+ * stores with nothing else in between (one backend lookup, one trace lock).
+ * Consecutive set() calls on the same register merge into one write.
+ * Fixed capacity, no allocation: a full batch applies itself. The blocks
+ * are referenced, not copied, and must outlive apply().
+ */
+class Batch {
+public:
+    static constexpr size_t CAPACITY = 16;
+
+    Batch& write(const Block& block, uint32_t offset, uint32_t value);
+    Batch& set(const Block& block, const Field& field, uint32_t value);
+
+    size_t size() const { return count_; }
+    void apply();
+
+private:
+    struct Write {
+        const Block* block;
+        uint32_t offset;
+        uint32_t value;
+    };
+    std::array<Write, CAPACITY> writes_;
+    size_t count_ = 0;
+};
+
+/**
+ * @brief One recorded register access
+ */
+struct Access {
+    uint64_t time_ns = 0;           // Since trace::clear() / first enable
+    const char* block = "";
+    uint32_t offset = 0;
+    uint32_t value = 0;
+    bool write = false;
+    bool redundant = false;         // Write of the value last written there
+    const char* operation = "";     // Innermost Operation, "" outside any
+};
+
+/**
+ * @brief Names the accesses made on this thread until it goes out of scope
+ *
+ * Nested scopes attribute accesses to the innermost one. Per-operation
+ * counts and wall time are kept while tracing is on.
+ */
+class Operation {
+public:
+    explicit Operation(const char* name);
+    ~Operation();
+
+    Operation(const Operation&) = delete;
+    Operation& operator=(const Operation&) = delete;
+
+private:
+    const char* name_;
+    const Operation* parent_;
+    bool timed_;
+    std::chrono::steady_clock::time_point start_;
+
+    friend const char* current_operation();
+};
+
+const char* current_operation();
+
+namespace trace {
+
+struct OperationStats {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t redundant = 0;
+    std::chrono::nanoseconds time{0};   // Wall time inside the scope, all calls
+};
+
+/**
+ * @brief Turn recording on or off
+ *
+ * Off by default, or on when RFDC_MMIO_TRACE=1. While off an access costs
+ * one relaxed atomic load.
+ */
+void enable(bool on);
+bool enabled();
+
+/**
+ * @brief Drop recorded accesses and statistics, restart the clock
+ */
+void clear();
+
+/**
+ * @brief Maximum recorded accesses (statistics keep counting past it)
+ */
+void set_capacity(size_t accesses);
+
+std::vector<Access> snapshot();
+std::vector<OperationStats> summary();
+uint64_t dropped();
+
+/**
+ * @brief Per-operation table followed by the redundant writes
+ */
+void print_summary(std::ostream& os);
+
+} // namespace trace
+
+} // namespace mmio
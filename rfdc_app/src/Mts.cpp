@@ -0,0 +1,284 @@
+#include "Mts.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace mts {
+
+namespace {
+
+const char* type_name(rfdc::TileType type)
+{
+    return type == rfdc::TileType::ADC ? "ADC" : "DAC";
+}
+
+uint32_t enabled_tiles(rfdc::RFDC& rfdc, rfdc::TileType type, uint32_t requested)
+{
+    uint32_t tiles = 0;
+    for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+        if ((requested & (1u << tile)) && rfdc.check_tile_enabled(type, tile)) {
+            tiles |= 1u << tile;
+        }
+    }
+    return tiles;
+}
+
+void sync_type(rfdc::RFDC& rfdc, XRFdc_MultiConverter_Sync_Config& config, TypeResult& result,
+               uint32_t requested, int target_latency)
+{
+    result.tiles = enabled_tiles(rfdc, result.type, requested);
+    result.target_latency = target_latency;
+    if (result.tiles == 0) {
+        return;
+    }
+    config.Tiles = result.tiles;
+    config.Target_Latency = target_latency;
+    result.status = rfdc.multi_converter_sync(result.type, &config);
+    if (!result.ok()) {
+        return;
+    }
+    for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+        if (result.tiles & (1u << tile)) {
+            result.latency[tile] = config.Latency[tile];
+            result.offset[tile] = config.Offset[tile];
+        }
+    }
+}
+
+int max_latency(const TypeResult& result)
+{
+    int latency = -1;
+    for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+        if (result.tiles & (1u << tile)) {
+            latency = std::max(latency, result.latency[tile]);
+        }
+    }
+    return latency;
+}
+
+void write_type(std::ostream& out, const char* prefix, const TypeResult& result)
+{
+    out << prefix << ".tiles = 0x" << std::hex << result.tiles << std::dec << "\n"
+        << prefix << ".target_latency = " << result.target_latency << "\n"
+        << prefix << ".latency =";
+    for (int v : result.latency) {
+        out << " " << v;
+    }
+    out << "\n" << prefix << ".offset =";
+    for (int v : result.offset) {
+        out << " " << v;
+    }
+    out << "\n";
+}
+
+std::string trim(const std::string& s)
+{
+    const size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+} // namespace
+
+Report run(rfdc::RFDC& rfdc, const Options& options)
+{
+    const auto start = std::chrono::steady_clock::now();
+    Report report;
+    report.adc.type = rfdc::TileType::ADC;
+    report.dac.type = rfdc::TileType::DAC;
+
+    XRFdc_MultiConverter_Sync_Config dac_config;
+    XRFdc_MultiConverter_Sync_Config adc_config;
+    rfdc.multi_converter_init(&dac_config, options.ref_tile);
+    rfdc.multi_converter_init(&adc_config, options.ref_tile);
+
+    sync_type(rfdc, dac_config, report.dac, options.dac_tiles, options.dac_target_latency);
+    sync_type(rfdc, adc_config, report.adc, options.adc_tiles, options.adc_target_latency);
+
+    if (options.disable_sysref && (report.adc.tiles || report.dac.tiles)) {
+        rfdc.mts_sysref_config(&dac_config, &adc_config, false);
+    }
+
+    report.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return report;
+}
+
+std::string status_string(uint32_t status)
+{
+    if (status == XRFDC_MTS_OK) {
+        return "OK";
+    }
+    static const struct {
+        uint32_t bit;
+        const char* name;
+    } bits[] = {
+        { XRFDC_MTS_NOT_SUPPORTED, "not supported" },
+        { XRFDC_MTS_TIMEOUT, "timeout" },
+        { XRFDC_MTS_MARKER_RUN, "marker run" },
+        { XRFDC_MTS_MARKER_MISM, "marker mismatch" },
+        { XRFDC_MTS_DELAY_OVER, "delay overflow" },
+        { XRFDC_MTS_TARGET_LOW, "target latency too low" },
+        { XRFDC_MTS_IP_NOT_READY, "IP not ready" },
+        { XRFDC_MTS_DTC_INVALID, "DTC invalid" },
+        { XRFDC_MTS_NOT_ENABLED, "not enabled" },
+        { XRFDC_MTS_SYSREF_GATE_ERROR, "SYSREF gate error" },
+        { XRFDC_MTS_SYSREF_FREQ_NDONE, "SYSREF frequency not done" },
+        { XRFDC_MTS_BAD_REF_TILE, "bad reference tile" },
+    };
+    std::string text;
+    uint32_t known = 0;
+    for (const auto& b : bits) {
+        if (status & b.bit) {
+            text += (text.empty() ? "" : ", ") + std::string(b.name);
+            known |= b.bit;
+        }
+    }
+    if (status & ~known) {
+        std::ostringstream rest;
+        rest << "0x" << std::hex << (status & ~known);
+        text += (text.empty() ? "" : ", ") + rest.str();
+    }
+    return text;
+}
+
+Options targets_from(const Report& saved, const Options& base)
+{
+    Options options = base;
+    options.adc_tiles = saved.adc.tiles;
+    options.dac_tiles = saved.dac.tiles;
+    options.adc_target_latency = max_latency(saved.adc);
+    options.dac_target_latency = max_latency(saved.dac);
+    return options;
+}
+
+bool matches(const Report& saved, const Report& current, std::ostream& diff)
+{
+    bool same = true;
+    auto compare = [&](const TypeResult& a, const TypeResult& b) {
+        const char* name = type_name(a.type);
+        if (a.tiles != b.tiles) {
+            diff << "    • " << name << " tiles 0x" << std::hex << a.tiles << " → 0x" << b.tiles
+                 << std::dec << "\n";
+            same = false;
+            return;
+        }
+        for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+            if ((a.tiles & (1u << tile)) && a.latency[tile] != b.latency[tile]) {
+                diff << "    • " << name << " " << tile << " latency " << a.latency[tile]
+                     << " → " << b.latency[tile] << "\n";
+                same = false;
+            }
+        }
+    };
+    compare(saved.dac, current.dac);
+    compare(saved.adc, current.adc);
+    return same;
+}
+
+bool save(const std::string& path, const Report& report)
+{
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "  ✗ Cannot write " << path << "\n";
+        return false;
+    }
+    out << "# Multi-tile sync results (latency / offset per tile 0-3)\n";
+    write_type(out, "dac", report.dac);
+    write_type(out, "adc", report.adc);
+    return out.good();
+}
+
+bool load(const std::string& path, Report& report)
+{
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    Report loaded;
+    loaded.adc.type = rfdc::TileType::ADC;
+    loaded.dac.type = rfdc::TileType::DAC;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        auto fail = [&](const std::string& msg) {
+            std::cerr << "  ✗ " << path << ":" << number << ": " << msg << "\n";
+            return false;
+        };
+
+        const size_t eq = line.find('=');
+        const size_t dot = line.find('.');
+        if (eq == std::string::npos || dot == std::string::npos || dot > eq) {
+            return fail("expected <adc|dac>.<key> = <value>");
+        }
+        const std::string type = trim(line.substr(0, dot));
+        const std::string key = trim(line.substr(dot + 1, eq - dot - 1));
+        std::istringstream value(line.substr(eq + 1));
+        TypeResult* result = (type == "adc") ? &loaded.adc : (type == "dac") ? &loaded.dac : nullptr;
+        if (!result) {
+            return fail("unknown converter type '" + type + "'");
+        }
+
+        bool ok = false;
+        if (key == "tiles") {
+            std::string text;
+            ok = static_cast<bool>(value >> text);
+            if (ok) {
+                char* end = nullptr;
+                result->tiles = static_cast<uint32_t>(std::strtoul(text.c_str(), &end, 0)) & 0xF;
+                ok = (*end == '\0');
+            }
+        } else if (key == "target_latency") {
+            ok = static_cast<bool>(value >> result->target_latency);
+        } else if (key == "latency" || key == "offset") {
+            std::array<int, 4>& out = (key == "latency") ? result->latency : result->offset;
+            ok = true;
+            for (int& v : out) {
+                ok = ok && static_cast<bool>(value >> v);
+            }
+        } else {
+            return fail("unknown key '" + key + "'");
+        }
+        if (!ok) {
+            return fail("invalid value for " + type + "." + key);
+        }
+    }
+
+    report = loaded;
+    return true;
+}
+
+void print_report(const Report& report, std::ostream& os)
+{
+    for (const TypeResult* result : { &report.dac, &report.adc }) {
+        const char* name = type_name(result->type);
+        if (result->tiles == 0) {
+            os << "  " << name << ": no tiles selected\n";
+            continue;
+        }
+        os << "  " << name << " tiles 0x" << std::hex << result->tiles << std::dec;
+        if (result->target_latency >= 0) {
+            os << ", target latency " << result->target_latency;
+        }
+        os << ": " << status_string(result->status) << "\n";
+        if (!result->ok()) {
+            continue;
+        }
+        for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+            if (result->tiles & (1u << tile)) {
+                os << "    • Tile " << tile << ": latency " << result->latency[tile]
+                   << ", offset " << result->offset[tile] << "\n";
+            }
+        }
+    }
+}
+
+} // namespace mts
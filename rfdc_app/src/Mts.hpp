@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "rfdc_wrapper/RfDc.hpp"
+
+namespace mts {
+
+/**
+ * @brief Multi-tile synchronization of the ADC and DAC tiles
+ *
+ * The driver's SYSREF-based sync measures each tile's latency and delays
+ * every tile to a common one, so all channels of a type line up to the
+ * sample and come up the same way after every restart. Latencies are in
+ * the driver's units (T1 sample periods), offsets are the delay each tile
+ * got.
+ *
+ * Run it after the converters are configured and the MTS clock enables are
+ * set. With a target latency the driver aligns to that value instead of
+ * the slowest tile, which keeps the latency identical across restarts;
+ * it fails with XRFDC_MTS_TARGET_LOW if a tile cannot make it.
+ */
+struct Options {
+    uint32_t adc_tiles = 0xF;           // Requested; disabled tiles are dropped
+    uint32_t dac_tiles = 0xF;
+    rfdc::TileId ref_tile = 0;          // Must be among the synced tiles
+    int adc_target_latency = -1;        // -1: align to the slowest tile
+    int dac_target_latency = -1;
+    bool disable_sysref = true;         // Gate SYSREF off afterwards (no SYSREF spurs)
+};
+
+struct TypeResult {
+    rfdc::TileType type = rfdc::TileType::ADC;
+    uint32_t tiles = 0;                 // Tiles synced, 0 if none were selected
+    uint32_t status = XRFDC_MTS_OK;     // XRFDC_MTS_* mask
+    int target_latency = -1;
+    std::array<int, 4> latency{{0, 0, 0, 0}};
+    std::array<int, 4> offset{{0, 0, 0, 0}};
+
+    bool ok() const { return status == XRFDC_MTS_OK; }
+};
+
+struct Report {
+    TypeResult adc;
+    TypeResult dac;
+    std::chrono::nanoseconds time{0};
+
+    bool ok() const { return adc.ok() && dac.ok(); }
+};
+
+/**
+ * @brief Sync the selected DAC tiles, then the ADC tiles
+ *
+ * Sync failures are reported in the result, not thrown.
+ * @throws rfdc::RFDCException if SYSREF cannot be gated off
+ */
+Report run(rfdc::RFDC& rfdc, const Options& options);
+
+/**
+ * @brief XRFDC_MTS_* mask as text ("OK" for 0)
+ */
+std::string status_string(uint32_t status);
+
+/**
+ * @brief Options that reproduce `saved`: same tiles, latencies as targets
+ */
+Options targets_from(const Report& saved, const Options& base);
+
+/**
+ * @brief Same tiles with the same latency on each
+ *
+ * Offsets are not compared: they absorb the power-up variation that the
+ * sync is there to remove.
+ * @param diff Gets one line per difference
+ */
+bool matches(const Report& saved, const Report& current, std::ostream& diff);
+
+/**
+ * @brief Write / read the tile sets, latencies and offsets ("key = value" lines)
+ */
+bool save(const std::string& path, const Report& report);
+bool load(const std::string& path, Report& report);
+
+/**
+ * @brief One line per synced tile: latency and offset
+ */
+void print_report(const Report& report, std::ostream& os);
+
+} // namespace mts
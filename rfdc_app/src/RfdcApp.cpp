@@ -1,5 +1,15 @@
 #include "RfdcApp.hpp"
+#include "SampleKernels.hpp"
+#include "HwBackend.hpp"
+#include "DacPlayback.hpp"
+#include "Mmio.hpp"
+#include "LockWait.hpp"
+#include "RfdcMonitor.hpp"
+#include "Mts.hpp"
+#include "StreamFormat.hpp"
+#include "rfdc_wrapper/SimRfdc.hpp"
 #include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -7,12 +17,20 @@
 #include <chrono>
 #include <algorithm>
 #include <cstring>
+#include <cstdlib>
+#include <functional>
 
 #define _USE_MATH_DEFINES
 #include <cmath>
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <csignal>
+#include <pthread.h>
 #include <unistd.h>
 
 // Fallback: Define M_PI if still not available
@@ -140,6 +158,7 @@ constexpr int FAIL = -1;
 constexpr const char* PL_MEM = "0x1";
 constexpr const char* NO_MEM = "0x0";
 constexpr const char* BRAM = "0";
+constexpr const char* DDR = "1";
 
 // Helper for formatting
 template<typename... Args>
@@ -170,6 +189,96 @@ static int deinit_path(int* fd, signed char* map, size_t sz) {
     return SUCCESS;
 }
 
+// plmem drivers without a poll hook report "readable" at once; only trust
+// poll() when an idle channel stays quiet.
+static bool plmem_supports_poll(int fd) {
+    if (fd < 0) {
+        return false;
+    }
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    return poll(&pfd, 1, 0) == 0;
+}
+
+// Size of a plmem region. Drivers that don't report one (st_size 0 and no
+// SEEK_END) get `fallback`, the window RFTool always mapped.
+static size_t plmem_region_size(int fd, size_t fallback) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        return static_cast<size_t>(st.st_size);
+    }
+    off_t end = lseek(fd, 0, SEEK_END);
+    lseek(fd, 0, SEEK_SET);
+    return end > 0 ? static_cast<size_t>(end) : fallback;
+}
+
+static bool csv_export_from_env() {
+    const char* env = std::getenv("RFDC_CSV_EXPORT");
+    return env && std::strcmp(env, "1") == 0;
+}
+
+// Cyclic lag of `captured` against `reference`, i.e. the d that best fits
+// captured[n] ~ reference[(n - d) % len]. `score` gets the normalized
+// correlation at that lag.
+static int64_t estimate_cyclic_lag(const int16_t* captured, size_t n,
+                                   const int16_t* reference, size_t len, double* score) {
+    *score = 0.0;
+    if (n == 0 || len == 0) {
+        return -1;
+    }
+    double captured_energy = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        captured_energy += static_cast<double>(captured[k]) * captured[k];
+    }
+    
+    int64_t best = -1;
+    for (size_t d = 0; d < len; ++d) {
+        double dot = 0.0;
+        double ref_energy = 0.0;
+        size_t r = (len - d) % len;
+        for (size_t k = 0; k < n; ++k) {
+            dot += static_cast<double>(captured[k]) * reference[r];
+            ref_energy += static_cast<double>(reference[r]) * reference[r];
+            if (++r == len) {
+                r = 0;
+            }
+        }
+        double denom = std::sqrt(captured_energy * ref_energy);
+        double c = denom > 0.0 ? dot / denom : 0.0;
+        if (c > *score) {
+            *score = c;
+            best = static_cast<int64_t>(d);
+        }
+    }
+    return best;
+}
+
+// Tile restarts would read as PLL loss: the monitor is off while converters
+// are reconfigured and picks the new block set up when it restarts
+class MonitorPause {
+public:
+    explicit MonitorPause(rfdc_monitor::Monitor* monitor)
+        : monitor_(monitor && monitor->running() ? monitor : nullptr)
+    {
+        if (monitor_) {
+            monitor_->stop();
+        }
+    }
+    ~MonitorPause()
+    {
+        if (!monitor_) {
+            return;
+        }
+        try {
+            monitor_->start();
+        } catch (const std::exception& e) {
+            std::cerr << "  ⚠ RFDC monitor not restarted: " << e.what() << "\n";
+        }
+    }
+
+private:
+    rfdc_monitor::Monitor* monitor_;
+};
+
 RfDcApp::RfDcApp(const std::string& name) 
     : name_(name)
 {
@@ -186,6 +295,48 @@ RfDcApp::RfDcApp(const std::string& name)
         info_.map_adc[i] = nullptr;
     }
     info_.fd = -1;
+    csv_export_ = csv_export_from_env();
+}
+
+void RfDcApp::bring_up()
+{
+    // display_status() and the timing line leave std::cout in fixed mode
+    stream_format::Restore restore(std::cout);
+    const auto start = std::chrono::steady_clock::now();
+    // Initialize GPIO first
+    init_gpio();
+    // Initialize clocks
+    initialize_clocks();
+    // Initialize RFDC
+    initialize_rfdc();
+    // Initialize LocalMem controller
+    local_mem_ = std::make_unique<local_mem::LocalMem>(rfdc_.get());
+    // Initialize the Clock Wizard 
+    clock_wiz_ = std::make_unique<clock_wizard::ClockWizard>(rfdc_.get()); 
+    // Initialize memory mapping (for clock wizards)
+    initialize_memory_mapping();
+    if (init_mem() != SUCCESS)
+    {
+        throw std::runtime_error("Failed to initialize UIO memory");
+    }
+    // Configure tiles (PLL, datapath, mixers, MMCM, FIFO): only what differs
+    configure_converters();
+    if (!mts_state_path_.empty()) {
+        sync_tiles();
+    }
+    // Mixers are final now: build the data mover tables before the first trigger
+    local_mem_->refresh_topology();
+    if (hw_backend::simulator()) {
+        connect_sim_loopback();
+    }
+    verify_configuration();
+    start_monitor();
+    display_status();
+
+    std::cout << "✓ Bring-up complete in " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - start).count()
+              << " ms\n\n";
 }
 
 void RfDcApp::run() 
@@ -194,34 +345,31 @@ void RfDcApp::run()
     {
         std::cout << "Starting RF Data Converter Application...\n\n";
         
-        // Initialize GPIO first
-        init_gpio();
-        // Initialize clocks
-        initialize_clocks();
-        // Initialize RFDC
-        initialize_rfdc();
-        // Initialize LocalMem controller
-        local_mem_ = std::make_unique<local_mem::LocalMem>(rfdc_.get());
-        // Initialize the Clock Wizard 
-        clock_wiz_ = std::make_unique<clock_wizard::ClockWizard>(rfdc_.get()); 
-        // Initialize memory mapping (for clock wizards)
-        initialize_memory_mapping();
-        if (init_mem() != SUCCESS)
-        {
-            throw std::runtime_error("Failed to initialize UIO memory");
-        }
-        // Configure tiles
-        configure_dac_tiles();
-        configure_adc_tiles();
-        initialize_mmcm_adc();
-        initialize_mmcm_dac();
-
-        verify_configuration();
-        display_status();
+        bring_up();
         // Run tests
         //run_loopback_test();
         run_iq_loopback_test();
         //run_codec_diagnostic_test();
+        //run_bram_map_benchmark();
+        //run_kernel_diagnostic_test();
+        //run_ddr_stream_capture_test();
+        //run_multi_channel_capture_test();
+        //run_dac_batch_upload_test();
+        //run_buffer_pool_test();
+        //run_device_copy_benchmark();
+        //run_capture_file_test();
+        //run_recording_test();
+        //run_shm_ring_test();
+        //run_capture_server_test();
+        //run_loopback_timing_test();
+        //run_dac_hot_swap_test();
+        //run_mmio_trace_test();
+        //run_config_cache_test();
+        //run_config_apply_test();
+        //run_lock_time_test();
+        //run_rfdc_monitor_test();
+        //run_mts_test();
+        //run_getter_cost_benchmark();
         //run_string_loopback_test();
         std::cout << "\n✓ Application completed successfully!\n";
         
@@ -247,6 +395,92 @@ void RfDcApp::run()
     }
 }
 
+void RfDcApp::serve(const std::string& socket_path)
+{
+    // Handle SIGINT/SIGTERM here only; threads started below inherit the mask
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    
+    try 
+    {
+        std::cout << "Starting RF Data Converter Capture Server...\n\n";
+        
+        bring_up();
+        
+        const uint32_t channel_mask = enabled_adc_channel_mask();
+        capture_server::Options opts;
+        opts.max_samples = FIFO_SIZE / sizeof(int16_t);
+        capture_server::Server server(
+            socket_path,
+            [this, channel_mask](const capture_server::Request& req, capture_server::Block& out) {
+                capture_for_client(channel_mask, req, out);
+            },
+            opts);
+        
+        if (!server.start()) {
+            throw std::runtime_error("Failed to start capture server on " + socket_path);
+        }
+        std::cout << "━━━ Capture Server ━━━\n";
+        std::cout << "  ✓ Listening on " << socket_path << " (ADC channel mask 0x"
+                  << std::hex << channel_mask << std::dec << ")\n";
+        std::cout << "  Ctrl-C to stop\n\n";
+        
+        int sig = 0;
+        sigwait(&signals, &sig);
+        
+        server.stop();
+        const auto st = server.stats();
+        std::cout << "\n  Served " << st.connections << " clients, " << st.requests << " requests, "
+                  << st.frames << " frames (" << st.bytes / (1024 * 1024) << " MB), "
+                  << st.errors << " errors\n";
+        std::cout << "\n✓ Capture server stopped\n";
+        
+        deinit_mem();
+        deinit_gpio();
+    } 
+    catch (const rfdc::RFDCException& e) 
+    {
+        std::cerr << "\n✗ RFDC Error: " << e.what() 
+                  << " (code: " << e.error_code() << ")\n";
+        deinit_mem();
+        deinit_gpio();
+        throw;
+    } 
+    catch (const std::exception& e) 
+    {
+        std::cerr << "\n✗ Error: " << e.what() << "\n";
+        deinit_mem();
+        deinit_gpio();
+        throw;
+    }
+}
+
+void RfDcApp::capture_for_client(uint32_t channel_mask,
+                                 const capture_server::Request& req,
+                                 capture_server::Block& out)
+{
+    if (req.tile > 3 || req.block > 3) {
+        throw std::invalid_argument(format_msg("No ADC tile ", req.tile, " block ", req.block));
+    }
+    const uint32_t channel = req.tile * 4 + req.block;
+    if (!(channel_mask & (1u << channel))) {
+        throw std::invalid_argument(format_msg("ADC tile ", req.tile, " block ", req.block,
+                                               " is not enabled"));
+    }
+    
+    // One capture at a time across all clients
+    std::lock_guard<std::mutex> lock(capture_mutex_);
+    auto captures = capture_adc_channels(1u << channel, req.num_samples, nullptr, false);
+    
+    out.I = std::move(captures.front().samples.I);
+    out.Q = std::move(captures.front().samples.Q);
+    out.timestamp_ns = capture_file::now_ns();
+    out.sample_rate_hz = rfdc_->get_pll_config(rfdc::TileType::ADC, req.tile).sample_rate() * 1e9;
+}
+
 void RfDcApp::run_codec_diagnostic_test()
 {
     std::cout << "━━━ Codec Diagnostic Test ━━━\n";
@@ -393,16 +627,191 @@ void RfDcApp::run_codec_diagnostic_test()
     std::cout << "  → Don't proceed to RF testing until software works\n\n";
 }
 
+void RfDcApp::run_bram_map_benchmark()
+{
+    std::cout << "━━━ BRAM Map Benchmark ━━━\n";
+    std::cout << "  Full-window ADC read, Tile 0 Block 0, per-call mmap vs persistent map\n\n";
+    
+    const auto* win = bram_window(rfdc::TileType::ADC, 0);
+    if (!win) {
+        std::cerr << "  ✗ ADC Tile 0 Block 0 is not mapped\n";
+        return;
+    }
+    
+    constexpr int iterations = 1000;
+    const size_t size_bytes = win->size;
+    std::vector<uint32_t> lanes = { win->paddr_I };
+    if (win->has_separate_q()) {
+        lanes.push_back(win->paddr_Q);
+    }
+    std::vector<uint8_t> dst(size_bytes);
+    
+    // Page faults as the kernel counts them for this thread
+    auto faults = []() {
+        struct rusage ru;
+        getrusage(RUSAGE_THREAD, &ru);
+        return static_cast<uint64_t>(ru.ru_minflt + ru.ru_majflt);
+    };
+    
+    // ----- Before: mmap + copy + munmap per lane, per capture -----
+    const uint64_t f0 = faults();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (uint32_t paddr : lanes) {
+            void* base = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, info_.fd, paddr);
+            if (base == MAP_FAILED) {
+                perror("mmap ADC");
+                return;
+            }
+            device_copy::from_device(dst.data(), base, size_bytes);
+            munmap(base, size_bytes);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    const uint64_t legacy_faults = faults() - f0;
+    
+    // ----- After: copy straight from the persistent windows -----
+    const auto& stats = bram_map_->stats();
+    const uint64_t f2 = faults();
+    auto t2 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        device_copy::from_device(dst.data(), win->I, size_bytes);
+        if (win->has_separate_q()) {
+            device_copy::from_device(dst.data(), win->Q, size_bytes);
+        }
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    const uint64_t mapped_faults = faults() - f2;
+    
+    auto us_per_capture = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / iterations;
+    };
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Lanes per capture : " << lanes.size() << " x " << size_bytes << " bytes ("
+              << device_copy::to_string(device_copy::active_strategy()) << " copies)\n";
+    std::cout << "  Per-call mmap     : " << us_per_capture(t1 - t0) << " us/capture, "
+              << static_cast<double>(legacy_faults) / iterations << " page faults/capture\n";
+    std::cout << "  Persistent map    : " << us_per_capture(t3 - t2) << " us/capture, "
+              << static_cast<double>(mapped_faults) / iterations << " page faults/capture\n";
+    std::cout << "  One-time setup    : " << stats.mmap_calls << " mmap calls for "
+              << stats.adc_channels << " ADC + " << stats.dac_channels << " DAC channels\n\n";
+}
+
+void RfDcApp::run_kernel_diagnostic_test()
+{
+    std::cout << "━━━ Sample Kernel Diagnostic Test ━━━\n";
+    std::cout << "  Implementation: " << kernels::implementation()
+              << " (checked against scalar reference, no RF hardware needed)\n\n";
+    
+    int failures = 0;
+    auto check = [&failures](bool ok, const std::string& what) {
+        std::cout << (ok ? "  ✓ " : "  ✗ ") << what << "\n";
+        if (!ok) failures++;
+    };
+    
+    // ===== TEST 1: Known word layouts =====
+    {
+        const uint32_t words[2] = { 0xFFFF0001u, 0x80007FFFu };
+        int16_t low[2];
+        int16_t pairs[4];
+        kernels::extract_real_low_half(words, low, 2);
+        kernels::unpack_pairs(words, pairs, 2);
+        
+        check(low[0] == 1 && low[1] == 32767, "Low-half extract of known words");
+        check(pairs[0] == 1 && pairs[1] == -1 && pairs[2] == 32767 && pairs[3] == -32768,
+              "Pair unpack of known words (low half first)");
+        
+        const int16_t odd[3] = { -2, 3, -4 };
+        uint32_t packed[2];
+        kernels::pack_pairs(odd, 3, packed);
+        check(packed[0] == 0x0003FFFEu && packed[1] == 0x0000FFFCu,
+              "Pair pack with zero-padded odd tail");
+    }
+    
+    // ===== TEST 2: Randomized, odd lengths and vector tails =====
+    std::default_random_engine rng(1234);
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+    const size_t lengths[] = { 0, 1, 7, 8, 9, 31, 32, 33, 1000, 16387 };
+    
+    bool match_low = true, match_unpack = true, match_merge = true;
+    bool match_pack = true, round_trip = true;
+    for (size_t n : lengths) {
+        std::vector<int16_t> a(n), b(n);
+        std::vector<uint32_t> words(n);
+        for (size_t k = 0; k < n; ++k) {
+            a[k] = static_cast<int16_t>(dist(rng));
+            b[k] = static_cast<int16_t>(dist(rng));
+            words[k] = static_cast<uint32_t>(dist(rng)) ^ (static_cast<uint32_t>(dist(rng)) << 16);
+        }
+        
+        std::vector<int16_t> ref(2 * n + 1), got(2 * n + 1);
+        kernels::scalar::extract_real_low_half(words.data(), ref.data(), n);
+        kernels::extract_real_low_half(words.data(), got.data(), n);
+        match_low &= std::equal(ref.begin(), ref.begin() + n, got.begin());
+        
+        kernels::scalar::unpack_pairs(words.data(), ref.data(), n);
+        kernels::unpack_pairs(words.data(), got.data(), n);
+        match_unpack &= std::equal(ref.begin(), ref.begin() + 2 * n, got.begin());
+        
+        kernels::scalar::merge_iq(a.data(), b.data(), ref.data(), n);
+        kernels::merge_iq(a.data(), b.data(), got.data(), n);
+        match_merge &= std::equal(ref.begin(), ref.begin() + 2 * n, got.begin());
+        
+        std::vector<uint32_t> ref_w((n + 1) / 2), got_w((n + 1) / 2);
+        kernels::scalar::pack_pairs(a.data(), n, ref_w.data());
+        kernels::pack_pairs(a.data(), n, got_w.data());
+        match_pack &= (ref_w == got_w);
+        
+        kernels::unpack_pairs(got_w.data(), got.data(), got_w.size());
+        round_trip &= std::equal(a.begin(), a.end(), got.begin());
+    }
+    check(match_low, "Low-half extract matches reference");
+    check(match_unpack, "Pair unpack matches reference");
+    check(match_merge, "I/Q merge matches reference");
+    check(match_pack, "Pair pack matches reference");
+    check(round_trip, "Pack → unpack round trip");
+    
+    // ===== TEST 3: Throughput =====
+    std::cout << "\n  Throughput (16K words, source bytes processed):\n";
+    constexpr size_t num_words = 16 * 1024;
+    constexpr int iterations = 2000;
+    std::vector<uint32_t> words(num_words, 0x12345678u);
+    std::vector<int16_t> lane_i(2 * num_words, 1), lane_q(2 * num_words, 2);
+    std::vector<int16_t> out(4 * num_words);
+    
+    auto measure = [&](const char* label, size_t bytes, const std::function<void()>& fn) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        stream_format::Restore restore(std::cout);
+        std::cout << "    " << std::left << std::setw(22) << label << std::right
+                  << std::fixed << std::setprecision(1)
+                  << (bytes * iterations) / secs / 1e6 << " MB/s\n";
+    };
+    
+    measure("extract_real_low_half", num_words * 4,
+            [&] { kernels::extract_real_low_half(words.data(), out.data(), num_words); });
+    measure("unpack_pairs", num_words * 4,
+            [&] { kernels::unpack_pairs(words.data(), out.data(), num_words); });
+    measure("merge_iq", num_words * 4,
+            [&] { kernels::merge_iq(lane_i.data(), lane_q.data(), out.data(), num_words); });
+    measure("pack_pairs", num_words * 4,
+            [&] { kernels::pack_pairs(lane_i.data(), 2 * num_words, words.data()); });
+    
+    std::cout << "\n━━━ Kernel Diagnostic Summary ━━━\n";
+    std::cout << "  " << (failures == 0 ? "✓ All kernel checks passed" : "✗ Kernel checks FAILED")
+              << " (" << failures << " failure(s))\n\n";
+}
+
 // ===== Helper Functions =====
 
 int RfDcApp::write_to_file(const std::string& path, const std::string& value) {
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        return FAIL;
-    }
-    file << value;
-    file.close();
-    return SUCCESS;
+    return hw_backend::active().write_attr(path, value) ? SUCCESS : FAIL;
 }
 
 // ===== Memory Initialization (RFTool Compatible API) =====
@@ -413,12 +822,13 @@ int RfDcApp::init_mem() {
     int i, ret;
     
     // Open /dev/mem for BRAM access
-    info_.fd = open("/dev/mem", O_RDWR | O_SYNC);
+    info_.fd = hw_backend::active().open_mem();
     if (info_.fd < 0) {
         std::cerr << "  ✗ Failed to open /dev/mem\n";
         return FAIL;
     }
-    std::cout << "  ✓ Opened /dev/mem\n";
+    std::cout << "  ✓ Opened /dev/mem (" << hw_backend::to_string(hw_backend::active().kind())
+              << " backend)\n";
     
     // Initialize DAC memory paths
     std::cout << "  Initializing DAC UIO devices...\n";
@@ -431,14 +841,15 @@ int RfDcApp::init_mem() {
         }
         
         // Open memory file
-        info_.fd_dac[i] = open(mem_path_dac[i], O_RDWR);
+        info_.fd_dac[i] = hw_backend::active().open_device(mem_path_dac[i], O_RDWR);
         if (info_.fd_dac[i] < 0) {
             std::cerr << "  ✗ File " << mem_path_dac[i] << " open failed\n";
             return FAIL;
         }
         
         // Map size of memory
-        info_.map_dac[i] = (signed char*)mmap(0, DAC_MAP_SZ,
+        info_.map_size_dac[i] = plmem_region_size(info_.fd_dac[i], DAC_MAP_SZ);
+        info_.map_dac[i] = (signed char*)mmap(0, info_.map_size_dac[i],
                                               PROT_READ | PROT_WRITE,
                                               MAP_SHARED,
                                               info_.fd_dac[i], 0);
@@ -447,7 +858,8 @@ int RfDcApp::init_mem() {
             return FAIL;
         }
         
-        std::cout << "    ✓ Mapped " << mem_path_dac[i] << "\n";
+        std::cout << "    ✓ Mapped " << mem_path_dac[i] << " ("
+                  << (info_.map_size_dac[i] >> 20) << " MB)\n";
     }
     
     // Initialize ADC memory paths
@@ -461,14 +873,15 @@ int RfDcApp::init_mem() {
         }
         
         // Open memory file
-        info_.fd_adc[i] = open(mem_path_adc[i], O_RDWR);
+        info_.fd_adc[i] = hw_backend::active().open_device(mem_path_adc[i], O_RDWR);
         if (info_.fd_adc[i] < 0) {
             std::cerr << "  ✗ File " << mem_path_adc[i] << " open failed\n";
             return FAIL;
         }
         
         // Map size of memory
-        info_.map_adc[i] = (signed char*)mmap(0, ADC_MAP_SZ,
+        info_.map_size_adc[i] = plmem_region_size(info_.fd_adc[i], ADC_MAP_SZ);
+        info_.map_adc[i] = (signed char*)mmap(0, info_.map_size_adc[i],
                                               PROT_READ | PROT_WRITE,
                                               MAP_SHARED,
                                               info_.fd_adc[i], 0);
@@ -477,13 +890,38 @@ int RfDcApp::init_mem() {
             return FAIL;
         }
         
-        std::cout << "    ✓ Mapped " << mem_path_adc[i] << "\n";
+        std::cout << "    ✓ Mapped " << mem_path_adc[i] << " ("
+                  << (info_.map_size_adc[i] >> 20) << " MB)\n";
     }
     
     // Set all 4 tiles in BRAM mode
     info_.mem_type_dac = 0xF;
     info_.mem_type_adc = 0xF;
     
+    // Capture completion: plmem fd wakeups if the driver supports them
+    plmem_poll_supported_ = plmem_supports_poll(info_.fd_adc[0]);
+    std::cout << "  ✓ Capture completion via "
+              << (plmem_poll_supported_ ? "plmem poll()" : "data mover status register") << "\n";
+    
+    // Map every BRAM channel once; transfers reuse these windows
+    if (rfdc_) {
+        bram_map_ = std::make_unique<bram_map::BramMap>(info_.fd, FIFO_SIZE);
+        if (!bram_map_->build(rfdc_->get_adc_map(), rfdc_->get_dac_map())) {
+            std::cerr << "  ✗ Failed to map BRAM channels\n";
+            return FAIL;
+        }
+        std::cout << "  ✓ BRAM map: " << bram_map_->stats().adc_channels << " ADC / "
+                  << bram_map_->stats().dac_channels << " DAC channels mapped\n";
+    }
+    
+    // Shared-memory ring for external consumers; captures work without it
+    if (capture_ring_.create(CAPTURE_RING_NAME, CAPTURE_RING_SLOTS, 2 * FIFO_SIZE)) {
+        std::cout << "  ✓ Publishing ADC captures to /dev/shm" << CAPTURE_RING_NAME
+                  << " (" << CAPTURE_RING_SLOTS << " slots)\n";
+    } else {
+        std::cerr << "  ⚠ Shared-memory capture ring unavailable\n";
+    }
+    
     std::cout << "  ✓ Memory initialization complete\n";
     std::cout << "    - Memory type DAC: 0x" << std::hex << info_.mem_type_dac << std::dec << " (BRAM)\n";
     std::cout << "    - Memory type ADC: 0x" << std::hex << info_.mem_type_adc << std::dec << " (BRAM)\n\n";
@@ -496,6 +934,8 @@ int RfDcApp::deinit_mem() {
     
     int i, ret;
     
+    capture_ring_.close();
+    
     // Cleanup DAC memory paths
     std::cout << "  Cleaning up DAC UIO devices...\n";
     for (i = 0; i < 16; i++) {
@@ -512,7 +952,7 @@ int RfDcApp::deinit_mem() {
         }
         
         // Deinitialize path
-        deinit_path(&info_.fd_dac[i], info_.map_dac[i], DAC_MAP_SZ);
+        deinit_path(&info_.fd_dac[i], info_.map_dac[i], info_.map_size_dac[i]);
         std::cout << "    ✓ Cleaned up " << mem_path_dac[i] << "\n";
     }
     
@@ -532,10 +972,13 @@ int RfDcApp::deinit_mem() {
         }
         
         // Deinitialize path
-        deinit_path(&info_.fd_adc[i], info_.map_adc[i], ADC_MAP_SZ);
+        deinit_path(&info_.fd_adc[i], info_.map_adc[i], info_.map_size_adc[i]);
         std::cout << "    ✓ Cleaned up " << mem_path_adc[i] << "\n";
     }
     
+    // Drop the BRAM windows before their /dev/mem descriptor
+    bram_map_.reset();
+    
     // Close /dev/mem
     if (info_.fd >= 0) {
         close(info_.fd);
@@ -561,6 +1004,14 @@ int RfDcApp::change_fifo_stat(int fifo_id, int tile_id, int stat) {
     }
 }
 
+const bram_map::ChannelWindow* RfDcApp::bram_window(rfdc::TileType type, uint32_t channel) const {
+    if (!bram_map_ || !bram_map_->is_built()) {
+        std::cerr << "    ✗ BRAM map not initialized (call init_mem first)\n";
+        return nullptr;
+    }
+    return bram_map_->window(type, channel);
+}
+
 int RfDcApp::write_data_to_memory_bram(uint32_t block_id, int tile_id,
                                        uint32_t size, const std::vector<int16_t>& samples)
 {
@@ -584,35 +1035,18 @@ int RfDcApp::write_data_to_memory_bram(uint32_t block_id, int tile_id,
         return FAIL;
     }
     
-    // Get DAC map for this channel
-    const auto& dac_map = rfdc_->get_dac_map();
-    uint32_t paddr_dac = dac_map[channel].addr_I;
-    
-    if (paddr_dac == 0xFFFFFFFF) {
+    // Get the persistent BRAM window for this channel
+    const auto* win = bram_window(rfdc::TileType::DAC, channel);
+    if (!win) {
         std::cerr << "    ✗ Channel not available\n";
         return FAIL;
     }
     
-    // Map BRAM at physical address
-    void* bram_base_dac = mmap(nullptr, size, PROT_READ | PROT_WRITE,
-                               MAP_SHARED, info_.fd, paddr_dac);
-    if (bram_base_dac == MAP_FAILED) {
-        std::cerr << "    ✗ Failed to mmap BRAM at 0x" << std::hex << paddr_dac << std::dec << "\n";
-        return FAIL;
-    }
-    
-    signed int* vaddr_dac = (signed int*)bram_base_dac;
-    
-    // Convert int16_t samples to 32-bit format and write
-    size_t num_samples = samples.size();
-    for (size_t i = 0; i < num_samples / 2; i++) {
-        // Pack two 16-bit samples into one 32-bit word
-        int16_t sample1 = samples[i * 2];
-        int16_t sample2 = (i * 2 + 1 < num_samples) ? samples[i * 2 + 1] : 0;
-        vaddr_dac[i] = (sample1 & 0xFFFF) | ((sample2 & 0xFFFF) << 16);
-    }
+    uint32_t* vaddr_dac = reinterpret_cast<uint32_t*>(win->I);
     
-    munmap(bram_base_dac, size);
+    // Pack two 16-bit samples per 32-bit word, never past the requested size
+    size_t num_samples = std::min(samples.size(), static_cast<size_t>(size / sizeof(int16_t)));
+    kernels::pack_pairs(samples.data(), num_samples, vaddr_dac);
     
     std::cout << "    ✓ Wrote " << num_samples << " samples (" << size << " bytes)\n";
     
@@ -650,38 +1084,19 @@ int RfDcApp::read_data_from_memory_bram(
     change_fifo_stat(XRFDC_ADC_TILE, tile_id, 1);
 
     // ------------------------------------------------------------
-    // 3. 计算 BRAM 物理地址
+    // 3. 查找已映射的 BRAM 窗口
     // ------------------------------------------------------------
-    const auto& adc_map = rfdc_->get_adc_map();
-
     constexpr uint32_t blocks_per_tile = 4;
     uint32_t idx = tile_id * blocks_per_tile + block_id;
 
-    uint32_t paddr_adc = adc_map[idx].addr_I;
-    if (paddr_adc == 0xFFFFFFFF) {
+    const auto* win = bram_window(rfdc::TileType::ADC, idx);
+    if (!win) {
         std::cerr << "    ✗ Invalid ADC BRAM address\n";
         return FAIL;
     }
 
-    // ------------------------------------------------------------
-    // 4. mmap BRAM
-    // ------------------------------------------------------------
-    void* bram_base = mmap(
-        nullptr,
-        size_bytes,
-        PROT_READ,
-        MAP_SHARED,
-        info_.fd,
-        paddr_adc
-    );
-
-    if (bram_base == MAP_FAILED) {
-        perror("mmap");
-        return FAIL;
-    }
-
-    volatile uint32_t* bram_words =
-        reinterpret_cast<volatile uint32_t*>(bram_base);
+    const uint32_t* bram_words =
+        reinterpret_cast<const uint32_t*>(win->I);
 
     // ------------------------------------------------------------
     // 5. REAL ADC 数据读取
@@ -693,14 +1108,7 @@ int RfDcApp::read_data_from_memory_bram(
     uint32_t num_words = size_bytes / sizeof(uint32_t);
     samples.resize(num_words);
 
-    for (uint32_t i = 0; i < num_words; ++i) {
-        samples[i] = static_cast<int16_t>(bram_words[i] & 0xFFFF);
-    }
-
-    // ------------------------------------------------------------
-    // 6. 清理
-    // ------------------------------------------------------------
-    munmap(bram_base, size_bytes);
+    kernels::extract_real_low_half(bram_words, samples.data(), num_words);
 
     std::cout << "    ✓ Read " << samples.size()
               << " REAL samples (" << size_bytes << " bytes)\n";
@@ -736,30 +1144,15 @@ int RfDcApp::write_dac_bram_rftool_style(
         return FAIL;
     }
 
-    const auto& dac_map = rfdc_->get_dac_map();
     uint32_t idx = tile * 4 + block;
-    uint32_t paddr = dac_map[idx].addr_I;
-
-    if (paddr == 0xFFFFFFFF) {
+    const auto* win = bram_window(rfdc::TileType::DAC, idx);
+    if (!win) {
         std::cerr << "✗ Invalid DAC BRAM address\n";
         return FAIL;
     }
 
-    void* bram = mmap(nullptr,
-                      size_bytes,
-                      PROT_READ | PROT_WRITE,
-                      MAP_SHARED,
-                      info_.fd,
-                      paddr);
-    if (bram == MAP_FAILED) {
-        perror("mmap DAC");
-        return FAIL;
-    }
-
-    // RFTOOL behavior: raw byte copy
-    std::memcpy(bram, data.data(), size_bytes);
-
-    munmap(bram, size_bytes);
+    // RFTOOL behavior: raw byte copy (aligned device accesses only)
+    device_copy::to_device(win->I, data.data(), size_bytes);
 
     // Enable FIFO (same as RFTOOL)
     if (change_fifo_stat(XRFDC_DAC_TILE, tile, 1) != SUCCESS) {
@@ -809,30 +1202,15 @@ int RfDcApp::read_adc_bram_rftool_style(
         return FAIL;
     }
 
-    const auto& adc_map = rfdc_->get_adc_map();
     uint32_t idx = tile * 4 + block;
-    
-    uint32_t paddr = adc_map[idx].addr_I;
-    if (paddr == 0xFFFFFFFF) {
+    const auto* win = bram_window(rfdc::TileType::ADC, idx);
+    if (!win) {
         std::cerr << "✗ Invalid ADC BRAM address\n";
         return FAIL;
     }
 
-    void* bram = mmap(nullptr,
-                      size_bytes,
-                      PROT_READ | PROT_WRITE,
-                      MAP_SHARED,
-                      info_.fd,
-                      paddr);
-    if (bram == MAP_FAILED) {
-        perror("mmap ADC");
-        return FAIL;
-    }
-
     out.resize(size_bytes);
-    std::memcpy(out.data(), bram, size_bytes);
-
-    munmap(bram, size_bytes);
+    device_copy::from_device(out.data(), win->I, size_bytes);
 
     std::cout << "✓ ADC BRAM read done\n";
     return SUCCESS;
@@ -913,48 +1291,39 @@ int RfDcApp::read_adc_bram_rftool_style(
     std::cout << "--------------------------------------------------\n";
 
     // ------------------------------------------------------------
-    // 3) Get BRAM addresses from wrapper map
+    // 3) Get BRAM windows from the persistent map
     // ------------------------------------------------------------
-    const auto& adc_map = rfdc_->get_adc_map();
     constexpr uint32_t blocks_per_tile = 4;
     uint32_t idx = tile * blocks_per_tile + block;
 
-    uint32_t addr_I = adc_map[idx].addr_I;
-    uint32_t addr_Q = adc_map[idx].addr_Q;
-
-    if (addr_I == 0xFFFFFFFF) {
+    const auto* win = bram_window(rfdc::TileType::ADC, idx);
+    if (!win) {
         std::cerr << "Invalid ADC BRAM address\n";
         return FAIL;
     }
 
+    if (size_bytes > win->size) {
+        std::cerr << "ADC read exceeds mapped BRAM window\n";
+        return FAIL;
+    }
+
     // ------------------------------------------------------------
     // 4) REAL mode read (I only)
     // ------------------------------------------------------------
     if (is_real) {
-        void* base = mmap(nullptr, size_bytes,
-                          PROT_READ | PROT_WRITE,
-                          MAP_SHARED, info_.fd, addr_I);
-        if (base == MAP_FAILED) {
-            perror("mmap ADC I");
-            return FAIL;
-        }
-
-        int32_t* src = static_cast<int32_t*>(base);
+        const uint32_t* src = reinterpret_cast<const uint32_t*>(win->I);
         size_t samples = size_bytes / sizeof(uint32_t);
         out.I.resize(samples);
 
-        for (size_t i = 0; i < samples; ++i) {
-            out.I[i] = int16_t(src[i] & 0xFFFF);
-        }
+        kernels::extract_real_low_half(src, out.I.data(), samples);
 
-        munmap(base, size_bytes);
         return SUCCESS;
     }
 
     // ------------------------------------------------------------
     // 5) IQ mode read (I + Q)
     // ------------------------------------------------------------
-    if (addr_Q == 0xFFFFFFFF) {
+    if (win->paddr_Q == bram_map::BramMap::INVALID_ADDR) {
         std::cerr << "IQ expected but Q BRAM missing\n";
         return FAIL;
     }
@@ -965,43 +1334,11 @@ int RfDcApp::read_adc_bram_rftool_style(
     out.I.resize(samples_lane);
     out.Q.resize(samples_lane);
 
-    // ---- I lane ----
-    {
-        void* base = mmap(nullptr, half_bytes,
-                          PROT_READ | PROT_WRITE,
-                          MAP_SHARED, info_.fd, addr_I);
-        if (base == MAP_FAILED) {
-            perror("mmap ADC I");
-            return FAIL;
-        }
-
-        int32_t* src = static_cast<int32_t*>(base);
-        for (size_t i = 0; i < samples_lane / 2; ++i) {
-            uint32_t w = src[i];
-            out.I[i * 2]     = int16_t(w & 0xFFFF);
-            out.I[i * 2 + 1] = int16_t((w >> 16) & 0xFFFF);
-        }
-        munmap(base, half_bytes);
-    }
-
-    // ---- Q lane ----
-    {
-        void* base = mmap(nullptr, half_bytes,
-                          PROT_READ | PROT_WRITE,
-                          MAP_SHARED, info_.fd, addr_Q);
-        if (base == MAP_FAILED) {
-            perror("mmap ADC Q");
-            return FAIL;
-        }
-
-        int32_t* src = static_cast<int32_t*>(base);
-        for (size_t i = 0; i < samples_lane / 2; ++i) {
-            uint32_t w = src[i];
-            out.Q[i * 2]     = int16_t(w & 0xFFFF);
-            out.Q[i * 2 + 1] = int16_t((w >> 16) & 0xFFFF);
-        }
-        munmap(base, half_bytes);
-    }
+    // ---- I and Q lanes: two samples per word ----
+    kernels::unpack_pairs(reinterpret_cast<const uint32_t*>(win->I),
+                          out.I.data(), samples_lane / 2);
+    kernels::unpack_pairs(reinterpret_cast<const uint32_t*>(win->Q),
+                          out.Q.data(), samples_lane / 2);
 
     return SUCCESS;
 }
@@ -1132,11 +1469,6 @@ void RfDcApp::initialize_clocks()
             (rfdc::RFClock::get_board_type() == rfdc::BoardType::ZCU216 ? 
              "ZCU216" : "ZCU111") << "\n";
         
-        // Configure all clocks with preset configuration
-        constexpr uint32_t LMK_CONFIG = 0;
-        constexpr uint32_t LMX_ADC_CONFIG = 0;
-        constexpr uint32_t LMX_DAC_CONFIG = 0;
-        
         std::cout << "\n  Configuring clock chips...\n";
         
         // Reset all chips first
@@ -1149,9 +1481,9 @@ void RfDcApp::initialize_clocks()
         std::cout << "    • Resetting LMX2594_2 (DAC)...\n";
         clock_->reset_chip(rfdc::RFClockChip::LMX2594_2);
         
-        // Configure all chips at once
+        // Configure all chips at once, presets from the converter config
         std::cout << "    • Programming clock configurations...\n";
-        clock_->set_all_configs(LMK_CONFIG, LMX_ADC_CONFIG, LMX_DAC_CONFIG);
+        clock_->set_all_configs(config_.clocks.lmk, config_.clocks.lmx_adc, config_.clocks.lmx_dac);
         
         std::cout << "  ✓ LMK04828 configured\n";
         std::cout << "  ✓ LMX2594_1 configured\n";
@@ -1231,27 +1563,116 @@ void RfDcApp::initialize_memory_mapping()
     );
 }
 
-void RfDcApp::initialize_mmcm_adc() {
-    std::cout << "\n━━━ Initializing MMCM for ADC tiles ━━━\n";
-    for (uint32_t tile = 0; tile < 4; ++tile) {
-        if (rfdc_->check_tile_enabled(rfdc::TileType::ADC, tile)) {
-            clock_wiz_->program_mmcm(rfdc::TileType::ADC, tile);
-        }
+void RfDcApp::configure_converters()
+{
+    std::cout << "━━━ Configuring Converters ━━━\n";
+    if (!config_applier_) {
+        config_applier_ = std::make_unique<converter_config::Applier>(
+            *rfdc_, *clock_wiz_, clock_.get(), &workers());
+        // initialize_clocks() has programmed these already
+        config_applier_->assume_clocks(config_.clocks);
     }
+    converter_config::Report report = config_applier_->apply(config_);
+    std::cout << "\n";
+    converter_config::print_report(report, std::cout);
+    std::cout << "\n";
 }
 
-void RfDcApp::initialize_mmcm_dac() {
-    std::cout << "\n━━━ Initializing MMCM for DAC tiles ━━━\n";
-    for (uint32_t tile = 0; tile < 4; ++tile) {
-        if (rfdc_->check_tile_enabled(rfdc::TileType::DAC, tile)) {
-            clock_wiz_->program_mmcm(rfdc::TileType::DAC, tile);
+void RfDcApp::sync_tiles()
+{
+    std::cout << "━━━ Multi-Tile Sync ━━━\n";
+    mts::Options options;
+    mts::Report saved;
+    const bool have_saved = std::ifstream(mts_state_path_).good();
+    if (have_saved) {
+        if (!mts::load(mts_state_path_, saved)) {
+            throw std::runtime_error("Invalid MTS state file " + mts_state_path_);
+        }
+        options = mts::targets_from(saved, options);
+        std::cout << "  Targeting latencies from " << mts_state_path_ << "\n";
+    }
+
+    MonitorPause pause(monitor_.get());
+    mts::Report report = mts::run(*rfdc_, options);
+    mts::print_report(report, std::cout);
+    mts_report_ = report;
+    mts_synced_ = report.ok();
+    if (!report.ok()) {
+        throw std::runtime_error("Multi-tile sync failed (DAC: " +
+                                 mts::status_string(report.dac.status) + ", ADC: " +
+                                 mts::status_string(report.adc.status) + ")");
+    }
+
+    if (have_saved) {
+        std::ostringstream diff;
+        if (!mts::matches(saved, report, diff)) {
+            std::cerr << "  ✗ Alignment differs from " << mts_state_path_ << ":\n" << diff.str();
+            throw std::runtime_error("Multi-tile sync does not reproduce " + mts_state_path_);
         }
+        std::cout << "  ✓ Alignment matches " << mts_state_path_ << "\n";
+    } else if (mts::save(mts_state_path_, report)) {
+        std::cout << "  ✓ Baseline saved to " << mts_state_path_ << "\n";
     }
+    stream_format::Restore restore(std::cout);
+    std::cout << "  ✓ Synced in " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(report.time).count() << " ms\n\n";
 }
 
+void RfDcApp::start_monitor()
+{
+    std::cout << "━━━ Starting RFDC Monitor ━━━\n";
+    if (!monitor_) {
+        monitor_ = std::make_unique<rfdc_monitor::Monitor>(*rfdc_);
+    }
+    try {
+        monitor_->start();
+    } catch (const rfdc::RFDCException& e) {
+        // Captures still work, they just go untagged
+        std::cerr << "  ⚠ RFDC monitor not started: " << e.what() << "\n\n";
+        return;
+    }
+    std::cout << "  ✓ Watching FIFO, over-range, datapath and PLL events ("
+              << (monitor_->interrupt_driven() ? "UIO interrupt" : "polled") << ")\n\n";
+}
+
+bool RfDcApp::load_config(const std::string& path)
+{
+    converter_config::Config config = converter_config::defaults();
+    if (!converter_config::load(path, config)) {
+        return false;
+    }
+    config_ = config;
+    std::cout << "  ✓ Converter config loaded from " << path << "\n";
+    return true;
+}
+
+void RfDcApp::enable_mts(const std::string& state_path)
+{
+    mts_state_path_ = state_path;
+}
+
+void RfDcApp::enable_csv_export(bool enable)
+{
+    csv_export_ = enable;
+}
+
+converter_config::Report RfDcApp::apply_config(const converter_config::Config& config)
+{
+    if (!config_applier_) {
+        throw std::runtime_error("apply_config: hardware not brought up");
+    }
+    config_ = config;
+    MonitorPause pause(monitor_.get());
+    converter_config::Report report = config_applier_->apply(config_);
+    // Mixer changes move the data mover layout
+    local_mem_->refresh_topology();
+    return report;
+}
+
+#if 0 //this is real mode 
 void RfDcApp::configure_dac_tiles() 
 {
-    std::cout << "━━━ Configuring DAC Tiles (I/Q Mode) ━━━\n";
+    std::cout << "━━━ Configuring DAC Tiles ━━━\n";
     
     constexpr double NCO_FREQ = 0.0;  // MHz
     
@@ -1288,82 +1709,48 @@ void RfDcApp::configure_dac_tiles()
             );
         }
         std::cout << "    • PLL locked\n";
-        
-        // Configure each block in the tile (I/Q pairs)
-        for (uint32_t block = 0; block < 4; block += 2) {  // Process I/Q pairs
+        // Configure each block in the tile
+        for (uint32_t block = 0; block < 4; ++block) {
             if (!rfdc_->check_block_enabled(rfdc::TileType::DAC, tile, block)) {
                 continue;
             }
             
-            std::cout << format_msg("      Block ", block, " (I) & ", block+1, " (Q):\n");
-            
-            // Configure I channel
+            std::cout << format_msg("      Block ", block, ":\n");
             rfdc_->set_datapath_mode(
                 tile,                    
                 block,
                 rfdc::DataPathMode::FullNyquistDucPass
             );   
-            
-            // Configure Q channel
-            rfdc_->set_datapath_mode(
-                tile,                    
-                block + 1,
-                rfdc::DataPathMode::FullNyquistDucPass
-            );
-            
         #if 1
-            // Configure mixer for I channel (Real-to-Complex)
-            rfdc::MixerSettings mixer_i(
-                NCO_FREQ,
-                0.0,
-                rfdc::EventSource::Tile,
-                XRFDC_COARSE_MIX_BYPASS,
-                rfdc::MixerMode::C2C,  // Real-to-Complex for I/Q
-                0.0,
-                rfdc::MixerType::Fine
-            );
-            rfdc_->set_mixer_settings(rfdc::TileType::DAC, tile, block, mixer_i);
-            
-            // Configure mixer for Q channel (Real-to-Complex)
-            rfdc::MixerSettings mixer_q(
+            // Configure mixer
+            rfdc::MixerSettings mixer(
                 NCO_FREQ,
                 0.0,
                 rfdc::EventSource::Tile,
                 XRFDC_COARSE_MIX_BYPASS,
-                rfdc::MixerMode::C2C,  // Real-to-Complex for I/Q
+                rfdc::MixerMode::R2R,
                 0.0,
-                rfdc::MixerType::Fine
+                rfdc::MixerType::Coarse
             );
-            rfdc_->set_mixer_settings(rfdc::TileType::DAC, tile, block + 1, mixer_q);
-            
-            std::cout << format_msg("        - Mixer (I/Q): ", NCO_FREQ, " MHz, R2C mode\n");
+            rfdc_->set_mixer_settings(rfdc::TileType::DAC, tile, block, mixer);
+            std::cout << format_msg("        - Mixer: ", NCO_FREQ, " MHz\n");
             
-            // Set Nyquist zone for both I and Q
+            // Set Nyquist zone
             rfdc_->set_nyquist_zone(rfdc::TileType::DAC, tile, block, 
                                    rfdc::NyquistZone::Zone1);
-            rfdc_->set_nyquist_zone(rfdc::TileType::DAC, tile, block + 1, 
-                                   rfdc::NyquistZone::Zone1);
-            
-            // Configure interpolation for both channels
+            // Configure interpolation
             rfdc_->set_interpolation_factor(tile, block, 2);
-            rfdc_->set_interpolation_factor(tile, block + 1, 2);
-            std::cout << "        - Interpolation: 2x (I/Q)\n";
+            std::cout << "        - Interpolation: 2x\n";
            
-            // Disable inverse sinc filter for both channels
+            // Disable inverse sinc filter
             rfdc_->set_inverse_sinc_filter(tile, block, 0);
-            rfdc_->set_inverse_sinc_filter(tile, block + 1, 0);
-            std::cout << "        - Inverse Sinc: Disabled (I/Q)\n";
+            std::cout << "        - Inverse Sinc: Disabled\n";
             
-            // Reset NCO phase for both channels
             rfdc_->reset_nco_phase(rfdc::TileType::DAC, tile, block);
-            rfdc_->reset_nco_phase(rfdc::TileType::DAC, tile, block + 1);
-            std::cout << "        - NCO Phase: reset (I/Q)\n";
-            
-            // Update event for both channels
+            std::cout << "        - NCO Phase: reset\n";
+            // Update event
             rfdc_->update_event(rfdc::TileType::DAC, tile, block, 
                               XRFDC_EVENT_MIXER);
-            rfdc_->update_event(rfdc::TileType::DAC, tile, block + 1, 
-                              XRFDC_EVENT_MIXER);
             #endif
         }
         
@@ -1377,210 +1764,14 @@ void RfDcApp::configure_dac_tiles()
         rfdc_->setup_fifo(rfdc::TileType::DAC, tile, true);
         std::cout << "    • FIFO enabled\n";
         
-        std::cout << format_msg("  ✓ DAC Tile ", tile, " configured (I/Q)\n\n");
+        std::cout << format_msg("  ✓ DAC Tile ", tile, " configured\n\n");
     }
 }
 
-
 void RfDcApp::configure_adc_tiles() {
-    std::cout << "━━━ Configuring ADC Tiles (I/Q Mode - RF Eval Tool Style) ━━━\n";
+    std::cout << "━━━ Configuring ADC Tiles ━━━\n";
     
-    constexpr double NCO_FREQ = 0.0;  // MHz
-    
-    for (uint32_t tile = 0; tile < 4; ++tile) {
-        if (!rfdc_->check_tile_enabled(rfdc::TileType::ADC, tile)) {
-            continue;
-        }
-        
-        std::cout << format_msg("  Configuring ADC Tile ", tile, "...\n");
-        
-        // Startup the tile
-        rfdc_->startup(rfdc::TileType::ADC, tile);
-        std::cout << "    • Tile started\n";
-        
-        // Wait for PLL lock
-        bool locked = false;
-        for (int retry = 0; retry < 100 && !locked; ++retry) {
-            locked = rfdc_->get_pll_lock_status(rfdc::TileType::ADC, tile);
-            if (!locked) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
-        }
-        
-        if (!locked) {
-            throw rfdc::RFDCException(
-                format_msg("ADC Tile ", tile, " PLL failed to lock")
-            );
-        }
-        std::cout << "    • PLL locked\n";
-        
-        // Configure each block individually (RF Eval Tool style)
-        // Each block is "Real" but outputs I/Q via Fine mixer
-        for (uint32_t block = 0; block < 4; ++block) {
-            if (!rfdc_->check_block_enabled(rfdc::TileType::ADC, tile, block)) {
-                continue;
-            }
-            
-            std::cout << format_msg("      Block ", block, ":\n");
-            
-            // Configure decimation
-            rfdc_->set_decimation_factor(tile, block, 1);  // RF Eval shows 1x
-            std::cout << "        - Decimation: 1x\n";      
-            
-            // CRITICAL: Use Fine mixer with R2C (Real to I/Q) mode
-            // This matches RF Eval Tool's "Real to I/Q" setting
-            rfdc::MixerSettings mixer(
-                NCO_FREQ,                  // 0.0 MHz frequency
-                0.0,                       // Phase
-                rfdc::EventSource::Tile,
-                XRFDC_COARSE_MIX_BYPASS,   // Bypass coarse mixer
-                rfdc::MixerMode::R2C,      // Real-to-Complex (Real to I/Q)
-                0,
-                rfdc::MixerType::Fine      // Fine mixer (as shown in GUI)
-            );
-            rfdc_->set_mixer_settings(rfdc::TileType::ADC, tile, block, mixer);
-            
-            std::cout << format_msg("        - Mixer: Fine, Real to I/Q, ", NCO_FREQ, " MHz\n");
-            
-            // Set Nyquist zone
-            rfdc_->set_nyquist_zone(rfdc::TileType::ADC, tile, block,
-                                   rfdc::NyquistZone::Zone1);
-            
-            // Configure QMC (disabled in RF Eval Tool)
-            rfdc::QMCSettings qmc(
-                false, false, 0.0, 0.0, 0,
-                rfdc::EventSource::Tile
-            );
-            
-            rfdc_->set_qmc_settings(rfdc::TileType::ADC, tile, block, qmc);
-            std::cout << "        - QMC: Disabled\n";
-            
-            // Set calibration mode (AutoCal in RF Eval Tool)
-            rfdc_->set_calibration_mode(tile, block, rfdc::CalibrationMode::Mode1);
-            std::cout << "        - Calibration: Mode 1 (AutoCal)\n";
-            
-            // Update event
-            rfdc_->update_event(rfdc::TileType::ADC, tile, block,
-                              XRFDC_EVENT_MIXER);
-        }
-        
-        // **CRITICAL: Reprogram MMCM after configuration changes**
-        std::cout << "    • Reprogramming MMCM...\n";
-        if (!clock_wiz_->program_mmcm(rfdc::TileType::ADC, tile)) {
-            std::cerr << "    ✗ MMCM programming failed\n";
-        }
-        
-        // Enable FIFO
-        rfdc_->setup_fifo(rfdc::TileType::ADC, tile, true);
-        std::cout << "    • FIFO enabled\n";
-        
-        std::cout << format_msg("  ✓ ADC Tile ", tile, " configured (Real to I/Q mode)\n\n");
-    }
-}
-
-#if 0 //this is real mode 
-void RfDcApp::configure_dac_tiles() 
-{
-    std::cout << "━━━ Configuring DAC Tiles ━━━\n";
-    
-    constexpr double NCO_FREQ = 0.0;  // MHz
-    
-    for (uint32_t tile = 0; tile < 4; ++tile) {
-        if (!rfdc_->check_tile_enabled(rfdc::TileType::DAC, tile)) {
-            continue;
-        }
-        
-        std::cout << format_msg("  Configuring DAC Tile ", tile, "...\n");
-        #if 1
-        constexpr double DAC_SAMPLE_RATE_MHZ = 5898.24;
-        update_pll_sample_rate(
-            rfdc::TileType::DAC,
-            tile,
-            DAC_SAMPLE_RATE_MHZ
-        );
-        #endif
-        // Startup the tile
-        rfdc_->startup(rfdc::TileType::DAC, tile);
-        std::cout << "    • Tile started\n";
-        
-        // Wait for PLL lock
-        bool locked = false;
-        for (int retry = 0; retry < 100 && !locked; ++retry) {
-            locked = rfdc_->get_pll_lock_status(rfdc::TileType::DAC, tile);
-            if (!locked) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
-        }
-        
-        if (!locked) {
-            throw rfdc::RFDCException(
-                format_msg("DAC Tile ", tile, " PLL failed to lock")
-            );
-        }
-        std::cout << "    • PLL locked\n";
-        // Configure each block in the tile
-        for (uint32_t block = 0; block < 4; ++block) {
-            if (!rfdc_->check_block_enabled(rfdc::TileType::DAC, tile, block)) {
-                continue;
-            }
-            
-            std::cout << format_msg("      Block ", block, ":\n");
-            rfdc_->set_datapath_mode(
-                tile,                    
-                block,
-                rfdc::DataPathMode::FullNyquistDucPass
-            );   
-        #if 1
-            // Configure mixer
-            rfdc::MixerSettings mixer(
-                NCO_FREQ,
-                0.0,
-                rfdc::EventSource::Tile,
-                XRFDC_COARSE_MIX_BYPASS,
-                rfdc::MixerMode::R2R,
-                0.0,
-                rfdc::MixerType::Coarse
-            );
-            rfdc_->set_mixer_settings(rfdc::TileType::DAC, tile, block, mixer);
-            std::cout << format_msg("        - Mixer: ", NCO_FREQ, " MHz\n");
-            
-            // Set Nyquist zone
-            rfdc_->set_nyquist_zone(rfdc::TileType::DAC, tile, block, 
-                                   rfdc::NyquistZone::Zone1);
-            // Configure interpolation
-            rfdc_->set_interpolation_factor(tile, block, 2);
-            std::cout << "        - Interpolation: 2x\n";
-           
-            // Disable inverse sinc filter
-            rfdc_->set_inverse_sinc_filter(tile, block, 0);
-            std::cout << "        - Inverse Sinc: Disabled\n";
-            
-            rfdc_->reset_nco_phase(rfdc::TileType::DAC, tile, block);
-            std::cout << "        - NCO Phase: reset\n";
-            // Update event
-            rfdc_->update_event(rfdc::TileType::DAC, tile, block, 
-                              XRFDC_EVENT_MIXER);
-            #endif
-        }
-        
-        // **CRITICAL: Reprogram MMCM after configuration changes**
-        std::cout << "    • Reprogramming MMCM...\n";
-        if (!clock_wiz_->program_mmcm(rfdc::TileType::DAC, tile)) {
-            std::cerr << "    ✗ MMCM programming failed\n";
-        }
-        
-        // Enable FIFO
-        rfdc_->setup_fifo(rfdc::TileType::DAC, tile, true);
-        std::cout << "    • FIFO enabled\n";
-        
-        std::cout << format_msg("  ✓ DAC Tile ", tile, " configured\n\n");
-    }
-}
-
-void RfDcApp::configure_adc_tiles() {
-    std::cout << "━━━ Configuring ADC Tiles ━━━\n";
-    
-    constexpr double NCO_FREQ = 0;  // MHz
+    constexpr double NCO_FREQ = 0;  // MHz
     
     for (uint32_t tile = 0; tile < 4; ++tile) {
         if (!rfdc_->check_tile_enabled(rfdc::TileType::ADC, tile)) {
@@ -1680,6 +1871,44 @@ void RfDcApp::configure_adc_tiles() {
 }
 
 #endif
+void RfDcApp::connect_sim_loopback()
+{
+    std::cout << "━━━ Simulated Loopback Cabling ━━━\n";
+
+    hw_backend::Simulated* sim = hw_backend::simulator();
+    const auto& adc = local_mem_->topology(rfdc::TileType::ADC);
+    const auto& dac = local_mem_->topology(rfdc::TileType::DAC);
+
+    // Same cabling as the loopback tests assume: DAC block n feeds ADC
+    // block n. An ADC in I/Q mode lays out interleaved I,Q in its single
+    // memory channel, so it takes Q from the neighbouring DAC block.
+    for (uint32_t idx = 0; idx < local_mem::LocalMem::NUM_CHANNELS; ++idx) {
+        if (!adc.slots[idx].valid || !dac.slots[idx].valid) {
+            continue;
+        }
+        uint32_t tile = idx / 4;
+        uint32_t block = idx % 4;
+
+        bool iq = adc.slots[idx].sample_multiplier == 2;
+        uint32_t partner = tile * 4 + (block ^ 1);
+        if (iq && dac.slots[partner].valid) {
+            sim->connect(adc.slots[idx].mem_i,
+                         static_cast<int>(dac.slots[idx].mem_i),
+                         static_cast<int>(dac.slots[partner].mem_i));
+            std::cout << format_msg("  • ADC[", tile, "][", block, "] ← DAC[", tile, "][", block,
+                                    "] (I) + DAC[", tile, "][", block ^ 1, "] (Q)\n");
+        } else {
+            sim->connect(adc.slots[idx].mem_i, static_cast<int>(dac.slots[idx].mem_i));
+            std::cout << format_msg("  • ADC[", tile, "][", block, "] ← DAC[", tile, "][", block,
+                                    "] (REAL)\n");
+        }
+    }
+
+    auto model = sim->model();
+    std::cout << "  ✓ Gain " << model.gain << ", noise ±" << model.noise
+              << " LSB, delay " << model.delay_samples << " samples\n\n";
+}
+
 void RfDcApp::verify_configuration() 
 {
     std::cout << "━━━ Verifying Configuration ━━━\n";
@@ -1805,13 +2034,23 @@ void RfDcApp::display_status() {
         }
     }
     
+    std::cout << "\n  Lock times:\n";
+    lock_wait::print_stats(std::cout);
+    if (mts_synced_) {
+        std::cout << "\n  Multi-tile sync:\n";
+        mts::print_report(mts_report_, std::cout);
+    }
+    if (monitor_) {
+        std::cout << "\n  Converter events:\n";
+        monitor_->print(std::cout);
+    }
     std::cout << "\n";
 }
 
 // ===== Data Transfer Wrapper Functions =====
 
 void RfDcApp::write_dac_samples(uint32_t tile, uint32_t block,
-                                const std::vector<int16_t>& samples)
+                                sample::SampleSpan samples)
 {
     #if 0
     uint32_t size_bytes = samples.size() * sizeof(int16_t);
@@ -1821,22 +2060,96 @@ void RfDcApp::write_dac_samples(uint32_t tile, uint32_t block,
     }
     #endif
 
-    const uint32_t size_bytes =
-        samples.size() * sizeof(int16_t);
+    DacUpload upload;
+    upload.tile = tile;
+    upload.block = block;
+    upload.samples = samples;
+
+    if (write_dac_batch({ upload }) != SUCCESS) {
+        throw std::runtime_error("Failed to write DAC samples");
+    }
+}
 
-    std::vector<uint8_t> raw(size_bytes);
-    std::memcpy(raw.data(), samples.data(), size_bytes);
+int RfDcApp::write_dac_batch(const std::vector<DacUpload>& uploads)
+{
+    std::cout << "[DAC] Batch write, " << uploads.size() << " channel(s)\n";
 
-    int ret = write_dac_bram_rftool_style(
-        tile,
-        block,
-        size_bytes,
-        raw
-    );
+    // ------------------------------------------------------------
+    // 1) Validate everything before touching BRAM
+    // ------------------------------------------------------------
+    std::vector<const bram_map::ChannelWindow*> windows(uploads.size(), nullptr);
+    uint32_t seen_channels = 0;
+    uint32_t tile_mask = 0;
+    bool ok = true;
+
+    for (size_t n = 0; n < uploads.size(); ++n) {
+        const auto& up = uploads[n];
+        const size_t size_bytes = up.samples.size() * sizeof(int16_t);
+        const uint32_t channel = up.tile * 4 + up.block;
+
+        std::string where = format_msg("  ✗ DAC[", up.tile, "][", up.block, "]: ");
+        if (up.tile >= 4 || up.block >= 4) {
+            std::cerr << where << "invalid tile/block\n";
+            ok = false;
+            continue;
+        }
+        if (size_bytes == 0 || (size_bytes % ADC_DAC_SZ_ALIGNMENT) != 0) {
+            std::cerr << where << "size must be a non-zero multiple of "
+                      << ADC_DAC_SZ_ALIGNMENT << " bytes\n";
+            ok = false;
+        }
+        if (size_bytes > FIFO_SIZE) {
+            std::cerr << where << "size " << size_bytes << " exceeds FIFO_SIZE\n";
+            ok = false;
+        }
+        if (seen_channels & (1u << channel)) {
+            std::cerr << where << "channel listed twice\n";
+            ok = false;
+        }
+        windows[n] = bram_window(rfdc::TileType::DAC, channel);
+        if (!windows[n]) {
+            std::cerr << where << "invalid DAC BRAM address\n";
+            ok = false;
+        }
 
-    if (ret != SUCCESS) {
-        throw std::runtime_error("Failed to write DAC samples");
+        seen_channels |= 1u << channel;
+        tile_mask |= 1u << up.tile;
+    }
+
+    if (!ok) {
+        std::cerr << "✗ DAC batch rejected, nothing written\n";
+        return FAIL;
+    }
+
+    // ------------------------------------------------------------
+    // 2) Copy every channel (channels are independent BRAMs)
+    // ------------------------------------------------------------
+    auto copy_channel = [&](size_t n) {
+        device_copy::to_device(windows[n]->I, uploads[n].samples.data(),
+                               uploads[n].samples.size() * sizeof(int16_t));
+    };
+    if (uploads.size() > 1) {
+        workers().parallel_for(uploads.size(), copy_channel);
+    } else if (!uploads.empty()) {
+        copy_channel(0);
+    }
+
+    // ------------------------------------------------------------
+    // 3) Enable each touched tile FIFO once
+    // ------------------------------------------------------------
+    for (uint32_t tile = 0; tile < 4; ++tile) {
+        if (!(tile_mask & (1u << tile))) {
+            continue;
+        }
+        if (change_fifo_stat(XRFDC_DAC_TILE, tile, 1) != SUCCESS) {
+            std::cerr << "✗ Failed to enable DAC FIFO on tile " << tile << "\n";
+            return FAIL;
+        }
     }
+
+    std::cout << "✓ DAC batch write done (" << uploads.size() << " channel(s), "
+              << __builtin_popcount(tile_mask) << " FIFO enable(s))\n";
+    return SUCCESS;
 }
 
 
@@ -2068,8 +2381,9 @@ void RfDcApp::run_loopback_test()
         dac_meta << "# num_samples: " << num_samples << "\n";
         dac_meta << "# amplitude: 30000\n";
         
-        save_samples_to_csv(samples, dac_pll_rate_hz, "dac_t0_b0_100MHz.csv", dac_meta.str());
-        std::cout << "    ✓ Saved: dac_t0_b0_100MHz.csv (with metadata)\n";
+        auto dac_info = capture_metadata(rfdc::TileType::DAC, tile, block, dac_pll_rate_hz);
+        dac_info.notes = dac_meta.str();
+        save_capture("dac_t0_b0_100MHz", samples, {}, dac_info);
         
         std::cout << "  Step 5: **TRIGGER DAC playback**\n";
         local_mem_trigger(rfdc::TileType::DAC, tile, num_samples, channel_mask);
@@ -2091,9 +2405,7 @@ void RfDcApp::run_loopback_test()
         
         std::cout << "  Step 2: **TRIGGER ADC capture**\n";
         local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, channel_mask);
-        
-        std::cout << "    Waiting 200ms for capture to complete...\n";
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        wait_for_capture(rfdc::TileType::ADC, tile, channel_mask);
         
         std::cout << "  Step 3: Reading captured data from ADC BRAM\n";
         auto captured = read_adc_samples_i_q(tile, block, num_samples);
@@ -2111,8 +2423,9 @@ void RfDcApp::run_loopback_test()
         adc_meta << "# signal_frequency_mhz: " << test_frequency << "\n";  // Baseband in BRAM
         adc_meta << "# num_samples: " << num_samples << "\n";
         
-        save_samples_to_csv(captured.I, adc_pll_rate_hz, "adc_t0_b0_capture.csv", adc_meta.str());
-        std::cout << "    ✓ Saved: adc_t0_b0_capture.csv (with metadata)\n";
+        auto adc_info = capture_metadata(rfdc::TileType::ADC, tile, block, adc_pll_rate_hz);
+        adc_info.notes = adc_meta.str();
+        save_capture("adc_t0_b0_capture", captured.I, captured.Q, adc_info);
         
         // ===== ANALYSIS =====
         std::cout << "\n━━━ Analysis ━━━\n";
@@ -2162,29 +2475,112 @@ void RfDcApp::run_loopback_test()
     }
 }
 
-void RfDcApp::save_samples_to_csv(const std::vector<int16_t>& samples,
-                                  double sample_rate_hz,
-                                  const std::string& filename,
-                                  const std::string& metadata)
+capture_file::Metadata RfDcApp::capture_metadata(rfdc::TileType type, uint32_t tile,
+                                                 uint32_t block, double sample_rate_hz)
 {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file for writing: " + filename);
-    }
+    capture_file::Metadata meta;
+    meta.type = (type == rfdc::TileType::DAC) ? "DAC" : "ADC";
+    meta.tile = tile;
+    meta.block = block;
+    meta.sample_rate_hz = sample_rate_hz;
+    meta.timestamp_ns = capture_file::now_ns();
     
-    // Write metadata as comments if provided
-    if (!metadata.empty()) {
-        file << metadata;
+    try {
+        auto mixer = rfdc_->get_mixer_settings(type, tile, block);
+        meta.mixer_mode = rfdc_->to_string(mixer.mode());
+        meta.nco_freq_mhz = mixer.frequency();
+    } catch (const std::exception& e) {
+        std::cerr << "    ⚠ Mixer settings unavailable for capture metadata: " << e.what() << "\n";
     }
+    return meta;
+}
+
+std::string RfDcApp::save_capture(const std::string& base_name,
+                                  sample::SampleSpan I,
+                                  sample::SampleSpan Q,
+                                  const capture_file::Metadata& meta)
+{
+    const std::string path = base_name + (Q.empty() ? ".i16" : ".ci16");
+    if (!capture_file::write(path, I, Q, meta)) {
+        throw std::runtime_error("Failed to write capture: " + path);
+    }
+    std::cout << "    ✓ Saved: " << path << " (+ .json sidecar)\n";
     
-    // Write CSV header
-    file << "sample_index,time_ns,value\n";
-    
-    // Calculate time step
-    double time_step_ns = (1.0 / sample_rate_hz) * 1e9;
-    
-    // Write samples
-    for (size_t i = 0; i < samples.size(); ++i) {
+    if (csv_export_) {
+        const std::string csv = base_name + ".csv";
+        if (Q.empty()) {
+            save_samples_to_csv(I, meta.sample_rate_hz, csv, meta.notes);
+        } else {
+            save_samples_to_csv(I, Q, meta.sample_rate_hz, csv, meta.notes);
+        }
+        std::cout << "    ✓ Saved: " << csv << "\n";
+    }
+    return path;
+}
+
+capture_writer::CaptureWriter& RfDcApp::recorder()
+{
+    if (!recorder_) {
+        capture_writer::Options opts;
+        recorder_ = std::make_unique<capture_writer::CaptureWriter>(
+            opts, csv_export_ ? csv_sink() : capture_writer::Sink());
+    }
+    return *recorder_;
+}
+
+bool RfDcApp::record_capture(const std::string& base_name, AdcSamples&& samples,
+                             const capture_file::Metadata& meta)
+{
+    capture_writer::Record rec;
+    rec.base_name = base_name;
+    rec.I = std::move(samples.I);
+    rec.Q = std::move(samples.Q);
+    rec.meta = meta;
+    return recorder().submit(std::move(rec));
+}
+
+capture_writer::Sink RfDcApp::csv_sink()
+{
+    return [this](const capture_writer::Record& rec) {
+        try {
+            if (rec.Q.empty()) {
+                save_samples_to_csv(rec.I, rec.meta.sample_rate_hz,
+                                    rec.base_name + ".csv", rec.meta.notes);
+            } else {
+                save_samples_to_csv(rec.I, rec.Q, rec.meta.sample_rate_hz,
+                                    rec.base_name + ".csv", rec.meta.notes);
+            }
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "    ✗ " << e.what() << "\n";
+            return false;
+        }
+    };
+}
+
+void RfDcApp::save_samples_to_csv(sample::SampleSpan samples,
+                                  double sample_rate_hz,
+                                  const std::string& filename,
+                                  const std::string& metadata)
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+    
+    // Write metadata as comments if provided
+    if (!metadata.empty()) {
+        file << metadata;
+    }
+    
+    // Write CSV header
+    file << "sample_index,time_ns,value\n";
+    
+    // Calculate time step
+    double time_step_ns = (1.0 / sample_rate_hz) * 1e9;
+    
+    // Write samples
+    for (size_t i = 0; i < samples.size(); ++i) {
         double time_ns = i * time_step_ns;
         file << i << "," << time_ns << "," << samples[i] << "\n";
     }
@@ -2193,8 +2589,8 @@ void RfDcApp::save_samples_to_csv(const std::vector<int16_t>& samples,
 }
 
 void RfDcApp::save_samples_to_csv(
-    const std::vector<int16_t>& I,
-    const std::vector<int16_t>& Q,
+    sample::SampleSpan I,
+    sample::SampleSpan Q,
     double fabric_sample_rate_hz,
     const std::string& filename,
     const std::string& metadata
@@ -2226,7 +2622,7 @@ void RfDcApp::save_samples_to_csv(
 }
 // ===== Waveform Generation Functions =====
 
-std::vector<int16_t> RfDcApp::generate_sine_wave(
+buffer_pool::SampleVector RfDcApp::generate_sine_wave(
     double frequency_hz,          // Digital frequency (CF in RF Eval Tool)
     double dac_pll_rate_hz,        // PLL rate
     uint32_t dac_interpolation,
@@ -2236,7 +2632,7 @@ std::vector<int16_t> RfDcApp::generate_sine_wave(
     bool imr_lowpass_enabled
 )
 {
-    std::vector<int16_t> samples(num_samples);
+    buffer_pool::SampleVector samples(num_samples);
     const uint32_t eff_interp =
         dac_interpolation * (imr_lowpass_enabled ? 2 : 1);
     // RF Eval Tool behavior:
@@ -2279,7 +2675,7 @@ std::vector<int16_t> RfDcApp::generate_sine_wave(
     return samples;
 }
 
-std::vector<int16_t> RfDcApp::generate_sine_wave_rf(
+buffer_pool::SampleVector RfDcApp::generate_sine_wave_rf(
     double frequency_mhz,      // RF-equivalent frequency (what user expects)
     double dac_pll_rate_hz,
     uint32_t dac_interpolation,
@@ -2290,7 +2686,7 @@ std::vector<int16_t> RfDcApp::generate_sine_wave_rf(
 )
 {
     double rf_freq_mhz = frequency_mhz;
-    std::vector<int16_t> samples(num_samples);
+    buffer_pool::SampleVector samples(num_samples);
     // RF Eval Tool behavior:
     // Samples are generated at the FABRIC rate
     const double sample_rate_hz = dac_pll_rate_hz / dac_interpolation;
@@ -2331,281 +2727,2059 @@ std::vector<int16_t> RfDcApp::generate_sine_wave_rf(
 }
 
 
-std::vector<int16_t> RfDcApp::generate_dc_offset(int16_t value, size_t num_samples)
+buffer_pool::SampleVector RfDcApp::generate_dc_offset(int16_t value, size_t num_samples)
+{
+    buffer_pool::SampleVector samples(num_samples, value);
+    
+    std::cout << "  ✓ Generated " << num_samples 
+              << " sample DC offset: " << value << "\n";
+    
+    return samples;
+}
+
+// Simplify set_local_mem_sample to use LocalMem class
+void RfDcApp::set_local_mem_sample(rfdc::TileType type, uint32_t tile_id,
+                                   uint32_t block_id, uint32_t num_samples)
+{
+    void* mem_base_addr = (type == rfdc::TileType::DAC) ? 
+                          rfdc_->get_dac_vaddr() : 
+                          rfdc_->get_adc_vaddr();
+    
+    local_mem_->set_sample_count(type, tile_id, block_id, num_samples, mem_base_addr);
+}
+
+// Simplify local_mem_trigger to use LocalMem class
+void RfDcApp::local_mem_trigger(rfdc::TileType type, uint32_t tile_id,
+                               uint32_t num_samples, uint32_t channel_mask)
+{
+    if (channel_mask == 0) {
+        std::cout << "  • Reset " << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
+                  << " Tile " << tile_id << "\n";
+        
+        // Reset via LocalMem
+        void* mem_base_addr = (type == rfdc::TileType::DAC) ? 
+                              rfdc_->get_dac_vaddr() : 
+                              rfdc_->get_adc_vaddr();
+        
+        local_mem_->trigger(type, mem_base_addr, 0);
+        return;
+    }
+    
+    std::cout << "  • **TRIGGER** " << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
+              << " Tile " << tile_id << " mask=0x" << std::hex << channel_mask << std::dec
+              << " samples=" << num_samples << "\n";
+    
+    // Use LocalMem hardware trigger
+    void* mem_base_addr = (type == rfdc::TileType::DAC) ? 
+                          rfdc_->get_dac_vaddr() : 
+                          rfdc_->get_adc_vaddr();
+    
+    local_mem_->trigger(type, mem_base_addr, channel_mask);
+    
+    if (type == rfdc::TileType::DAC) {
+        last_trigger_dac_ = std::chrono::steady_clock::now();
+    } else {
+        last_trigger_adc_ = std::chrono::steady_clock::now();
+    }
+    
+    // Also trigger via UIO for redundancy (both methods used in RFTool)
+    for (uint32_t block = 0; block < 4; ++block) {
+        if (!(channel_mask & (1 << block))) {
+            continue;
+        }
+        
+        uint32_t channel = tile_id * 4 + block;
+        
+        if (type == rfdc::TileType::DAC) {
+            if (channel < 16 && info_.fd_dac[channel] >= 0) {
+                uint64_t trigger = 1;
+                write(info_.fd_dac[channel], &trigger, sizeof(trigger));
+                std::cout << "    ✓ Triggered DAC channel " << channel << " (UIO)\n";
+            }
+        } else {
+            if (channel < 16 && info_.fd_adc[channel] >= 0) {
+                uint64_t trigger = 1;
+                write(info_.fd_adc[channel], &trigger, sizeof(trigger));
+                std::cout << "    ✓ Triggered ADC channel " << channel << " (UIO)\n";
+            }
+        }
+    }
+}
+
+RfDcApp::LoopbackCapture RfDcApp::loopback_capture(uint32_t tile, uint32_t block,
+                                                   sample::SampleSpan waveform,
+                                                   size_t num_samples)
+{
+    const auto& dac = local_mem_->topology(rfdc::TileType::DAC);
+    const auto& adc = local_mem_->topology(rfdc::TileType::ADC);
+    if (tile >= local_mem::LocalMem::NUM_TILES || block >= adc.blocks_per_tile[tile] ||
+        !dac.slots[dac.index(tile, block)].valid || !adc.slots[adc.index(tile, block)].valid) {
+        throw std::invalid_argument(format_msg("No DAC/ADC pair at tile ", tile, " block ", block));
+    }
+    const uint32_t dac_mask = 1u << dac.index(tile, block);
+    const uint32_t adc_mask = 1u << adc.index(tile, block);
+    const uint32_t channel = tile * 4 + block;
+    
+    // Everything that logs or touches files happens before the trigger
+    local_mem_->trigger(rfdc::TileType::DAC, rfdc_->get_dac_vaddr(), 0);
+    set_local_mem_sample(rfdc::TileType::DAC, tile, block, static_cast<uint32_t>(waveform.size()));
+    write_dac_samples(tile, block, waveform);
+    set_local_mem_sample(rfdc::TileType::ADC, tile, block, static_cast<uint32_t>(num_samples));
+    
+    LoopbackCapture result;
+    const rfdc_monitor::Snapshot events_before =
+        monitor_ ? monitor_->snapshot() : rfdc_monitor::Snapshot();
+    // plmem triggers after both movers are running, as capture_adc_channels
+    // does; they are part of the start sequence, so they count in the skew
+    auto plmem_triggers = [this, channel] {
+        uint64_t trigger = 1;
+        if (info_.fd_dac[channel] >= 0) {
+            write(info_.fd_dac[channel], &trigger, sizeof(trigger));
+        }
+        if (info_.fd_adc[channel] >= 0) {
+            write(info_.fd_adc[channel], &trigger, sizeof(trigger));
+        }
+    };
+    if (!local_mem_->trigger_loopback(rfdc_->get_dac_vaddr(), dac_mask,
+                                      rfdc_->get_adc_vaddr(), adc_mask, &result.timing,
+                                      plmem_triggers)) {
+        throw std::runtime_error("Loopback trigger failed");
+    }
+    last_trigger_dac_ = result.timing.dac_fired;
+    last_trigger_adc_ = result.timing.adc_fired;
+    
+    result.completion = wait_for_capture(rfdc::TileType::ADC, tile, 1u << block);
+    if (monitor_ && monitor_->running()) {
+        monitor_->sweep(rfdc::TileType::ADC, 1u << channel);
+        result.verdict = rfdc_monitor::compare(events_before, monitor_->snapshot(),
+                                               rfdc::TileType::ADC, 1u << channel);
+    }
+    result.samples = read_adc_samples_i_q(tile, block, num_samples);
+    
+    // A non-high-speed ADC in I/Q mode interleaves I,Q in the I memory; the
+    // DAC waveform is the I (even) half of it
+    sample::SampleSpan lane(result.samples.I);
+    buffer_pool::SampleVector i_lane;
+    if (result.samples.is_iq && !rfdc_->check_high_speed_adc(tile)) {
+        i_lane.resize(lane.size() / 2);
+        for (size_t k = 0; k < i_lane.size(); ++k) {
+            i_lane[k] = lane[2 * k];
+        }
+        lane = sample::SampleSpan(i_lane);
+    }
+    result.offset = estimate_cyclic_lag(lane.data(), lane.size(),
+                                        waveform.data(), waveform.size(), &result.correlation);
+    return result;
+}
+
+RfDcApp::CaptureCompletion RfDcApp::wait_for_capture(rfdc::TileType type, uint32_t tile_id,
+                                                     uint32_t channel_mask,
+                                                     std::chrono::milliseconds timeout)
+{
+    // Per-tile block mask → global channel mask (channel = tile * 4 + block)
+    return wait_for_channels(type, (channel_mask & 0xF) << (tile_id * 4), timeout);
+}
+
+RfDcApp::CaptureCompletion RfDcApp::wait_for_channels(rfdc::TileType type,
+                                                      uint32_t channel_mask,
+                                                      std::chrono::milliseconds timeout)
+{
+    CaptureCompletion result;
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + timeout;
+    const auto triggered = (type == rfdc::TileType::DAC) ? last_trigger_dac_ : last_trigger_adc_;
+    const int* fds = (type == rfdc::TileType::DAC) ? info_.fd_dac : info_.fd_adc;
+    
+    if (plmem_poll_supported_) {
+        result.method = "poll";
+        
+        // One pollfd per channel in the mask
+        std::vector<struct pollfd> pending;
+        for (uint32_t channel = 0; channel < 16; ++channel) {
+            if ((channel_mask & (1u << channel)) && fds[channel] >= 0) {
+                pending.push_back({ fds[channel], POLLIN, 0 });
+            }
+        }
+        
+        while (!pending.empty()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            int ret = poll(pending.data(), pending.size(),
+                           static_cast<int>(std::max<int64_t>(0, remaining.count())));
+            if (ret < 0) {
+                perror("poll plmem");
+                break;
+            }
+            if (ret == 0) {
+                break;  // Timed out
+            }
+            
+            for (size_t k = 0; k < pending.size();) {
+                if (pending[k].revents & POLLIN) {
+                    uint64_t events = 0;
+                    ssize_t n = read(pending[k].fd, &events, sizeof(events));  // Acknowledge
+                    (void)n;
+                    pending.erase(pending.begin() + k);
+                } else {
+                    ++k;
+                }
+            }
+        }
+        result.completed = pending.empty();
+    } else {
+        result.method = "register";
+        void* mem_base_addr = (type == rfdc::TileType::DAC) ?
+                              rfdc_->get_dac_vaddr() :
+                              rfdc_->get_adc_vaddr();
+        result.completed = local_mem_->wait_trigger_done(
+            mem_base_addr,
+            std::chrono::duration_cast<std::chrono::microseconds>(timeout));
+    }
+    
+    const auto now = std::chrono::steady_clock::now();
+    const auto since = (triggered.time_since_epoch().count() != 0 && triggered <= start) ? triggered : start;
+    result.latency = std::chrono::duration_cast<std::chrono::microseconds>(now - since);
+    
+    if (result.completed) {
+        std::cout << "    ✓ Transfer complete in " << result.latency.count()
+                  << " us (" << result.method << ")\n";
+    } else {
+        std::cerr << "    ⚠ Transfer not complete after " << timeout.count()
+                  << " ms (" << result.method << ")\n";
+    }
+    return result;
+}
+
+void RfDcApp::update_pll_sample_rate(
+    rfdc::TileType type,
+    uint32_t tile,
+    double desired_sample_rate_mhz
+)
+{
+    // Read current PLL configuration
+    auto pll = rfdc_->get_pll_config(type, tile);
+
+    std::cout << format_msg(
+        "    • Updating PLL Fs ",
+        pll.sample_rate_mhz(),
+        " MHz → ",
+        desired_sample_rate_mhz,
+        " MHz\n"
+    );
+
+    // Reuse existing ref clock & source
+    rfdc_->set_pll_config(
+        type,
+        tile,
+        rfdc::ClockSource::Internal,
+        pll.ref_clk_freq(),                // MHz
+        desired_sample_rate_mhz   // MHz
+    );
+
+    const auto lock = lock_wait::wait(
+        format_msg("PLL ", type == rfdc::TileType::DAC ? "DAC " : "ADC ", tile),
+        [&] { return rfdc_->get_pll_lock_status(type, tile); },
+        lock_wait::pll_policy());
+    if (!lock.locked) {
+        throw std::runtime_error(
+            format_msg("PLL failed to lock on tile ", tile)
+        );
+    }
+    std::cout << format_msg("    • PLL locked in ",
+                            std::chrono::duration_cast<std::chrono::microseconds>(lock.time).count(),
+                            " us\n");
+}
+
+
+// ===== CRITICAL FIX: Reduce amplitude to avoid clipping =====
+RfDcApp::AdcCaptureView RfDcApp::capture_adc_view(
+    uint32_t tile,
+    uint32_t block,
+    size_t num_samples,
+    bool verbose
+)
+{
+    AdcCaptureView view;
+
+    // ------------------------------------------------------------
+    // 1) Check mixer settings to determine if we're in I/Q mode
+    // ------------------------------------------------------------
+    auto mixer = rfdc_->get_mixer_settings(rfdc::TileType::ADC, tile, block);
+    bool is_high_speed = rfdc_->check_high_speed_adc(tile);
+
+    // Determine if this is REAL or IQ mode based on mixer
+    bool is_real = 
+        (mixer.mode() == rfdc::MixerMode::R2R) ||
+        (mixer.type() == rfdc::MixerType::Coarse &&
+         mixer.frequency() == XRFDC_COARSE_MIX_BYPASS);
+
+    bool is_iq_mode = !is_real;
+
+    if (verbose) {
+        std::cout << "--------------------------------------------------\n";
+        std::cout << "ADC Read (Tile " << tile << ", Block " << block << ")\n";
+        std::cout << "  Mixer Mode     : " << rfdc_->to_string(mixer.mode()) << "\n";
+        std::cout << "  Mixer Type     : " << rfdc_->to_string(mixer.type()) << "\n";
+        std::cout << "  High-speed ADC : " << (is_high_speed ? "YES" : "NO") << "\n";
+        std::cout << "  Detected Mode  : " << (is_iq_mode ? "I/Q" : "REAL") << "\n";
+        std::cout << "--------------------------------------------------\n";
+    }
+
+    // ------------------------------------------------------------
+    // 2) Calculate read size (must be word-aligned)
+    //    RFDC BRAM stores 2× int16 per 32-bit word
+    // ------------------------------------------------------------
+    const size_t samples_per_word = 2;
+    const size_t words = (num_samples + samples_per_word - 1) / samples_per_word;
+    const size_t size_bytes = words * sizeof(uint32_t);
+
+    uint32_t idx = tile * 4 + block;
+    const auto* win = bram_window(rfdc::TileType::ADC, idx);
+    if (!win) {
+        throw std::runtime_error("Invalid ADC BRAM address");
+    }
+    if (size_bytes > win->size) {
+        throw std::runtime_error("ADC read exceeds mapped BRAM window");
+    }
+
+    // ------------------------------------------------------------
+    // 3) REAL mode - view the I lane only
+    // ------------------------------------------------------------
+    view.length = num_samples;
+    view.I = sample::SampleSpan(reinterpret_cast<const int16_t*>(win->I), num_samples);
+
+    if (!is_iq_mode) {
+        // Enable FIFO (same as RFTOOL), as read_adc_bram_rftool_style did
+        if (change_fifo_stat(XRFDC_ADC_TILE, tile, 1) != SUCCESS) {
+            throw std::runtime_error("Failed to enable ADC FIFO");
+        }
+        view.type = rfdc::DataType::Real;
+        if (verbose) {
+            std::cout << "  ✓ Viewing " << view.length << " REAL samples at 0x"
+                      << std::hex << win->paddr_I << std::dec << "\n";
+        }
+        publish_capture(tile, block, view);
+        return view;
+    }
+
+    // ------------------------------------------------------------
+    // 4) I/Q mode - addr_I and addr_Q of the SAME block
+    // ------------------------------------------------------------
+    if (win->paddr_Q == bram_map::BramMap::INVALID_ADDR) {
+        throw std::runtime_error("Invalid ADC I/Q BRAM addresses");
+    }
+
+    view.Q = sample::SampleSpan(reinterpret_cast<const int16_t*>(win->Q), num_samples);
+    view.type = rfdc::DataType::IQ;
+
+    if (verbose) {
+        std::cout << "  ✓ Viewing " << view.length << " I/Q samples (I=0x"
+                  << std::hex << win->paddr_I << ", Q=0x" << win->paddr_Q << std::dec << ")\n";
+    }
+
+    publish_capture(tile, block, view);
+    return view;
+}
+
+shm_ring::FrameHeader RfDcApp::capture_frame_header(uint32_t tile, uint32_t block)
+{
+    const auto mixer = rfdc_->get_mixer_settings(rfdc::TileType::ADC, tile, block);
+    shm_ring::FrameHeader frame;
+    frame.timestamp_ns = capture_file::now_ns();
+    frame.type = 0;
+    frame.tile = tile;
+    frame.block = block;
+    frame.nco_freq_mhz = mixer.frequency();
+    std::string mode = rfdc_->to_string(mixer.mode());
+    mode.copy(frame.mixer_mode, sizeof(frame.mixer_mode) - 1);
+    try {
+        frame.sample_rate_hz = rfdc_->get_pll_config(rfdc::TileType::ADC, tile).sample_rate() * 1e9;
+    } catch (const std::exception&) {
+        frame.sample_rate_hz = 0.0;
+    }
+    return frame;
+}
+
+void RfDcApp::publish_capture(uint32_t tile, uint32_t block, const AdcCaptureView& view)
+{
+    // Nobody attached: skip the copy and the RFDC queries below
+    if (!capture_ring_.has_readers()) {
+        return;
+    }
+
+    const uint32_t lanes = view.is_iq() ? 2 : 1;
+    int16_t* slot = capture_ring_.begin(lanes, static_cast<uint32_t>(view.size()));
+    if (!slot) {
+        return;     // Larger than a ring slot
+    }
+    // The slot is the only destination: BRAM → shared memory in one pass
+    device_copy::from_device(slot, view.I.data(), view.I.size() * sizeof(int16_t));
+    if (lanes == 2) {
+        device_copy::from_device(slot + view.size(), view.Q.data(), view.Q.size() * sizeof(int16_t));
+    }
+    capture_ring_.commit(capture_frame_header(tile, block));
+}
+
+void RfDcApp::publish_stream_chunk(
+    const shm_ring::FrameHeader& frame,
+    sample::SampleSpan values,
+    bool interleaved_iq
+)
 {
-    std::vector<int16_t> samples(num_samples, value);
+    if (!capture_ring_.has_readers()) {
+        return;
+    }
+
+    // A DDR chunk is far larger than a slot: publish it as consecutive frames
+    const uint32_t lanes = interleaved_iq ? 2 : 1;
+    const size_t frame_values = capture_ring_.payload_bytes() / sizeof(int16_t) / lanes * lanes;
+    if (frame_values == 0) {
+        return;
+    }
+
+    for (size_t offset = 0; offset < values.size(); offset += frame_values) {
+        const size_t count = std::min(frame_values, values.size() - offset);
+        const size_t samples = count / lanes;
+        int16_t* slot = capture_ring_.begin(lanes, static_cast<uint32_t>(samples));
+        if (!slot) {
+            return;
+        }
+        const int16_t* src = values.data() + offset;
+        if (lanes == 1) {
+            device_copy::from_device(slot, src, count * sizeof(int16_t));
+        } else {
+            // Ring frames are planar: split I/Q pairs through a small cache-resident block
+            alignas(64) int16_t block[2048];
+            int16_t* I = slot;
+            int16_t* Q = slot + samples;
+            for (size_t n = 0; n < count; n += 2048) {
+                const size_t len = std::min<size_t>(2048, count - n);
+                device_copy::from_device(block, src + n, len * sizeof(int16_t));
+                for (size_t k = 0; k + 1 < len; k += 2) {
+                    *I++ = block[k];
+                    *Q++ = block[k + 1];
+                }
+            }
+        }
+        capture_ring_.commit(frame);
+    }
+}
+
+RfDcApp::AdcSamples RfDcApp::AdcCaptureView::snapshot() const
+{
+    AdcSamples copy;
+    copy.I.resize(I.size());
+    copy.Q.resize(Q.size());
+    device_copy::from_device(copy.I.data(), I.data(), I.size() * sizeof(int16_t));
+    device_copy::from_device(copy.Q.data(), Q.data(), Q.size() * sizeof(int16_t));
+    copy.is_iq = is_iq();
+    return copy;
+}
+
+RfDcApp::AdcSamples RfDcApp::read_adc_samples_i_q(
+    uint32_t tile,
+    uint32_t block,
+    size_t num_samples,
+    bool verbose
+)
+{
+    // Single copy out of BRAM into owning buffers (the view already fed the ring)
+    AdcSamples captured = capture_adc_view(tile, block, num_samples, verbose).snapshot();
+
+    if (verbose) {
+        std::cout << "  ✓ Read " << captured.I.size() << " I samples and " 
+                  << captured.Q.size() << " Q samples\n";
+    }
+
+    return captured;
+}
+
+// ===== Simultaneous Multi-Channel Capture =====
+
+worker_pool::WorkerPool& RfDcApp::workers()
+{
+    if (!workers_) {
+        workers_ = std::make_unique<worker_pool::WorkerPool>();
+    }
+    return *workers_;
+}
+
+uint32_t RfDcApp::enabled_adc_channel_mask() const
+{
+    uint32_t mask = 0;
+    for (uint32_t tile = 0; tile < 4; ++tile) {
+        for (uint32_t block = 0; block < 4; ++block) {
+            uint32_t channel = tile * 4 + block;
+            if (rfdc_->check_block_enabled(rfdc::TileType::ADC, tile, block) &&
+                bram_window(rfdc::TileType::ADC, channel)) {
+                mask |= 1u << channel;
+            }
+        }
+    }
+    return mask;
+}
+
+std::vector<RfDcApp::ChannelCapture> RfDcApp::capture_adc_channels(
+    uint32_t channel_mask,
+    size_t num_samples,
+    MultiCaptureStats* stats,
+    bool parallel_readout
+)
+{
+    std::vector<ChannelCapture> captures;
+    for (uint32_t channel = 0; channel < 16; ++channel) {
+        if (!(channel_mask & (1u << channel))) {
+            continue;
+        }
+        if (!bram_window(rfdc::TileType::ADC, channel)) {
+            throw std::runtime_error(format_msg("ADC channel ", channel, " is not mapped"));
+        }
+        ChannelCapture cap;
+        cap.tile = channel / 4;
+        cap.block = channel % 4;
+        captures.push_back(std::move(cap));
+    }
+    if (captures.empty()) {
+        return captures;
+    }
+    
+    auto t0 = std::chrono::steady_clock::now();
+    const rfdc_monitor::Snapshot events_before =
+        monitor_ ? monitor_->snapshot() : rfdc_monitor::Snapshot();
+    
+    // ------------------------------------------------------------
+    // 1) Program every end address, then a single trigger for all
+    // ------------------------------------------------------------
+    for (const auto& cap : captures) {
+        set_local_mem_sample(rfdc::TileType::ADC, cap.tile, cap.block, num_samples);
+    }
+    
+    local_mem_->trigger(rfdc::TileType::ADC, rfdc_->get_adc_vaddr(), channel_mask);
+    last_trigger_adc_ = std::chrono::steady_clock::now();
+    
+    for (const auto& cap : captures) {
+        if (info_.fd_adc[cap.channel()] >= 0) {
+            uint64_t trigger = 1;
+            write(info_.fd_adc[cap.channel()], &trigger, sizeof(trigger));
+        }
+    }
+    
+    auto done = wait_for_channels(rfdc::TileType::ADC, channel_mask);
+    if (!done.completed) {
+        throw std::runtime_error("Multi-channel ADC capture did not complete");
+    }
+    if (monitor_ && monitor_->running()) {
+        // Pick up anything the monitor thread has not serviced yet
+        monitor_->sweep(rfdc::TileType::ADC, channel_mask);
+        const rfdc_monitor::Snapshot events_after = monitor_->snapshot();
+        for (auto& cap : captures) {
+            cap.verdict = rfdc_monitor::compare(events_before, events_after,
+                                                rfdc::TileType::ADC, 1u << cap.channel());
+        }
+    }
+    
+    auto t1 = std::chrono::steady_clock::now();
+    
+    // ------------------------------------------------------------
+    // 2) Resolve views up front (RFDC queries stay on this thread),
+    //    then copy each channel out of BRAM on the worker pool
+    // ------------------------------------------------------------
+    std::vector<AdcCaptureView> views;
+    views.reserve(captures.size());
+    for (const auto& cap : captures) {
+        views.push_back(capture_adc_view(cap.tile, cap.block, num_samples, false));
+    }
+    
+    auto copy_channel = [&](size_t n) {
+        captures[n].samples = views[n].snapshot();
+    };
+    if (parallel_readout && captures.size() > 1) {
+        workers().parallel_for(captures.size(), copy_channel);
+    } else {
+        for (size_t n = 0; n < captures.size(); ++n) {
+            copy_channel(n);
+        }
+    }
+    
+    auto t2 = std::chrono::steady_clock::now();
+    
+    if (stats) {
+        stats->channels = static_cast<uint32_t>(captures.size());
+        stats->bytes = 0;
+        for (const auto& cap : captures) {
+            stats->bytes += (cap.samples.I.size() + cap.samples.Q.size()) * sizeof(int16_t);
+        }
+        stats->trigger_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        stats->readout_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    }
+    
+    return captures;
+}
+
+
+
+// ===== DDR Streaming Capture =====
+
+int RfDcApp::set_adc_mem_type(uint32_t tile, uint32_t block, local_mem::LocalMem::MemType type)
+{
+    uint32_t channel = tile * 4 + block;
+    if (channel >= 16) {
+        std::cerr << "    ✗ Invalid ADC channel " << channel << "\n";
+        return FAIL;
+    }
+    
+    bool ddr = (type == local_mem::LocalMem::MemType::DDR);
+    if (write_to_file(bram_ddr_path_adc[channel], ddr ? DDR : BRAM) != SUCCESS) {
+        std::cerr << "    ✗ Error configuring ADC mem type: mem index: " << channel << "\n";
+        return FAIL;
+    }
+    
+    // mem_type_adc keeps one bit per tile, set = BRAM
+    if (ddr) {
+        info_.mem_type_adc &= ~(1u << tile);
+    } else {
+        info_.mem_type_adc |= (1u << tile);
+    }
+    return SUCCESS;
+}
+
+int RfDcApp::set_dac_mem_type(uint32_t tile, uint32_t block, local_mem::LocalMem::MemType type)
+{
+    uint32_t channel = tile * 4 + block;
+    if (channel >= 16) {
+        std::cerr << "    ✗ Invalid DAC channel " << channel << "\n";
+        return FAIL;
+    }
+    
+    bool ddr = (type == local_mem::LocalMem::MemType::DDR);
+    if (write_to_file(bram_ddr_path_dac[channel], ddr ? DDR : BRAM) != SUCCESS) {
+        std::cerr << "    ✗ Error configuring DAC mem type: mem index: " << channel << "\n";
+        return FAIL;
+    }
+    
+    // mem_type_dac keeps one bit per tile, set = BRAM
+    if (ddr) {
+        info_.mem_type_dac &= ~(1u << tile);
+    } else {
+        info_.mem_type_dac |= (1u << tile);
+    }
+    return SUCCESS;
+}
+
+int RfDcApp::capture_adc_ddr_stream(
+    uint32_t tile,
+    uint32_t block,
+    size_t num_samples,
+    size_t chunk_samples,
+    const StreamConsumer& consumer,
+    StreamStats* stats
+)
+{
+    std::cout << "━━━ DDR Streaming Capture ADC[" << tile << "][" << block << "] ━━━\n";
+    
+    StreamStats result;
+    uint32_t channel = tile * 4 + block;
+    if (channel >= 16 || !info_.map_adc[channel] || info_.map_adc[channel] == MAP_FAILED) {
+        std::cerr << "  ✗ ADC channel " << channel << " has no plmem mapping\n";
+        return FAIL;
+    }
+    if (!consumer || num_samples == 0 || chunk_samples == 0) {
+        std::cerr << "  ✗ Invalid stream request\n";
+        return FAIL;
+    }
+    
+    // ------------------------------------------------------------
+    // 1) Size the transfer from the data mover's memory info
+    // ------------------------------------------------------------
+    auto mem_info = local_mem_->get_mem_info(rfdc::TileType::ADC, rfdc_->get_adc_vaddr());
+    
+    // End-address counts must be multiples of 16 and of the fabric width
+    size_t granularity = 16;
+    if (mem_info.num_words > 0 && (granularity % mem_info.num_words) != 0) {
+        granularity = static_cast<size_t>(mem_info.num_words) * 16;
+    }
+    num_samples = (num_samples + granularity - 1) / granularity * granularity;
+    chunk_samples = (chunk_samples + granularity - 1) / granularity * granularity;
+    
+    // Non-high-speed IQ channels interleave I and Q in the same memory
+    auto mixer = rfdc_->get_mixer_settings(rfdc::TileType::ADC, tile, block);
+    bool is_real =
+        (mixer.mode() == rfdc::MixerMode::R2R) ||
+        (mixer.type() == rfdc::MixerType::Coarse &&
+         mixer.frequency() == XRFDC_COARSE_MIX_BYPASS);
+    bool interleaved_iq = !is_real && !rfdc_->check_high_speed_adc(tile);
+    
+    const size_t total_values = num_samples * (interleaved_iq ? 2 : 1);
+    const size_t total_bytes = total_values * sizeof(int16_t);
+    
+    std::cout << "  Memory info: " << mem_info.num_mem << " memories, BRAM "
+              << mem_info.mem_size << " bytes each, " << mem_info.num_words << " words/clk\n";
+    std::cout << "  Request    : " << num_samples << " samples"
+              << (interleaved_iq ? " (I/Q interleaved)" : "") << ", "
+              << (total_bytes / (1024.0 * 1024.0)) << " MB in chunks of " << chunk_samples << "\n";
+    
+    const size_t window = info_.map_size_adc[channel];
+    if (total_bytes > window || num_samples > 0xFFFFFFFFull) {
+        std::cerr << "  ✗ Capture exceeds the " << (window >> 20) << " MB DDR window\n";
+        return FAIL;
+    }
+    
+    // ------------------------------------------------------------
+    // 2) Switch the channel to DDR, capture, always switch back
+    // ------------------------------------------------------------
+    if (set_adc_mem_type(tile, block, local_mem::LocalMem::MemType::DDR) != SUCCESS) {
+        return FAIL;
+    }
+    
+    int ret = SUCCESS;
+    try {
+        auto t0 = std::chrono::steady_clock::now();
+        
+        set_local_mem_sample(rfdc::TileType::ADC, tile, block, static_cast<uint32_t>(num_samples));
+        local_mem_trigger(rfdc::TileType::ADC, tile, static_cast<uint32_t>(num_samples), 1u << block);
+        
+        // Timeout: the capture window itself (fabric rate), plus margin
+        auto pll = rfdc_->get_pll_config(rfdc::TileType::ADC, tile);
+        uint32_t decimation = std::max<uint32_t>(1, rfdc_->get_decimation_factor(tile, block));
+        double fs_hz = pll.sample_rate() * 1e9 / decimation;
+        auto capture_time = std::chrono::milliseconds(
+            static_cast<int64_t>(num_samples / fs_hz * 1e3) + 1000);
+        auto done = wait_for_capture(rfdc::TileType::ADC, tile, 1u << block, capture_time);
+        if (!done.completed) {
+            throw std::runtime_error("DDR capture did not complete");
+        }
+        
+        auto t1 = std::chrono::steady_clock::now();
+        result.capture_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        
+        // ------------------------------------------------------------
+        // 3) Stream the DDR buffer in place, chunk by chunk
+        // ------------------------------------------------------------
+        const int16_t* base = reinterpret_cast<const int16_t*>(info_.map_adc[channel]);
+        const size_t chunk_values = chunk_samples * (interleaved_iq ? 2 : 1);
+        const bool publish = capture_ring_.has_readers();
+        const shm_ring::FrameHeader frame =
+            publish ? capture_frame_header(tile, block) : shm_ring::FrameHeader();
+        
+        StreamChunk chunk;
+        for (size_t offset = 0; offset < total_values; offset += chunk_values) {
+            size_t count = std::min(chunk_values, total_values - offset);
+            chunk.samples = sample::SampleSpan(base + offset, count);
+            chunk.offset = offset;
+            chunk.last = (offset + count >= total_values);
+            if (publish) {
+                publish_stream_chunk(frame, chunk.samples, interleaved_iq);
+            }
+            
+            result.samples += count;
+            result.chunks++;
+            if (!consumer(chunk)) {
+                std::cout << "  ⚠ Consumer stopped the stream after " << result.chunks << " chunks\n";
+                break;
+            }
+            chunk.index++;
+        }
+        
+        result.completed = (result.samples == total_values);
+        result.stream_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t1).count();
+    } catch (const std::exception& e) {
+        std::cerr << "  ✗ DDR capture failed: " << e.what() << "\n";
+        ret = FAIL;
+    }
+    
+    if (set_adc_mem_type(tile, block, local_mem::LocalMem::MemType::BRAM) != SUCCESS) {
+        ret = FAIL;
+    }
+    
+    if (ret == SUCCESS) {
+        double mb = result.samples * sizeof(int16_t) / (1024.0 * 1024.0);
+        std::cout << "  ✓ Streamed " << result.samples << " values in " << result.chunks
+                  << " chunks (capture " << result.capture_ms << " ms, stream "
+                  << result.stream_ms << " ms, "
+                  << (result.stream_ms > 0 ? mb / (result.stream_ms / 1000.0) : 0.0) << " MB/s)\n";
+    }
+    
+    if (stats) {
+        *stats = result;
+    }
+    return ret;
+}
+
+void RfDcApp::run_ddr_stream_capture_test()
+{
+    std::cout << "━━━ Running DDR Streaming Capture Test ━━━\n";
+    
+    const uint32_t tile = 0;
+    const uint32_t block = 0;
+    const size_t chunk_samples = 1024 * 1024;
+    
+    // Fill the channel's DDR window, leaving room for I/Q interleaving
+    const size_t window = info_.map_size_adc[tile * 4 + block];
+    const size_t num_samples = window / (2 * sizeof(int16_t)) / chunk_samples * chunk_samples;
+    std::cout << "  ADC Tile " << tile << " Block " << block << ", "
+              << (num_samples >> 20) << "M samples (" << (window >> 20)
+              << " MB window), 1M-sample chunks\n\n";
+    if (num_samples == 0) {
+        std::cout << "  ✗ DDR window smaller than one chunk\n";
+        return;
+    }
+    
+    int16_t min_val = INT16_MAX;
+    int16_t max_val = INT16_MIN;
+    double sum_sq = 0.0;
+    
+    StreamStats stats;
+    int ret = capture_adc_ddr_stream(tile, block, num_samples, chunk_samples,
+        [&](const StreamChunk& chunk) {
+            for (int16_t v : chunk.samples) {
+                min_val = std::min(min_val, v);
+                max_val = std::max(max_val, v);
+                sum_sq += static_cast<double>(v) * v;
+            }
+            return true;
+        }, &stats);
+    
+    if (ret != SUCCESS || stats.samples == 0) {
+        std::cout << "  ✗ DDR streaming capture failed\n";
+        return;
+    }
+    
+    std::cout << "  Min: " << min_val << ", Max: " << max_val
+              << ", P-P: " << (max_val - min_val)
+              << ", RMS: " << static_cast<int>(std::sqrt(sum_sq / stats.samples)) << "\n";
+    std::cout << "  " << (stats.completed ? "✓ Complete capture streamed" : "⚠ Partial stream") << "\n\n";
+}
+
+
+
+void RfDcApp::run_multi_channel_capture_test()
+{
+    std::cout << "━━━ Running Multi-Channel Capture Test ━━━\n";
+    
+    const uint32_t mask = enabled_adc_channel_mask();
+    const size_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr int iterations = 20;
+    
+    std::cout << "  Enabled ADC channels: mask=0x" << std::hex << mask << std::dec
+              << ", " << num_samples << " samples each, "
+              << workers().size() << " readout workers\n\n";
+    if (mask == 0) {
+        std::cout << "  ✗ No enabled ADC channels\n";
+        return;
+    }
+    
+    // ----- Before: one channel at a time, serial readout -----
+    size_t serial_bytes = 0;
+    double serial_ms = 0.0;
+    for (int it = 0; it < iterations; ++it) {
+        for (uint32_t channel = 0; channel < 16; ++channel) {
+            if (!(mask & (1u << channel))) {
+                continue;
+            }
+            MultiCaptureStats st;
+            capture_adc_channels(1u << channel, num_samples, &st, false);
+            serial_bytes += st.bytes;
+            serial_ms += st.trigger_ms + st.readout_ms;
+        }
+    }
+    
+    // ----- After: one trigger, concurrent readout -----
+    size_t parallel_bytes = 0;
+    double parallel_ms = 0.0;
+    double readout_ms = 0.0;
+    std::vector<ChannelCapture> last;
+    for (int it = 0; it < iterations; ++it) {
+        MultiCaptureStats st;
+        last = capture_adc_channels(mask, num_samples, &st);
+        parallel_bytes += st.bytes;
+        parallel_ms += st.trigger_ms + st.readout_ms;
+        readout_ms += st.readout_ms;
+    }
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& cap : last) {
+        auto mm = std::minmax_element(cap.samples.I.begin(), cap.samples.I.end());
+        std::cout << "  Channel " << std::setw(2) << cap.channel()
+                  << " (T" << cap.tile << "B" << cap.block << ")"
+                  << (cap.samples.is_iq ? " I/Q " : " REAL")
+                  << "  P-P: " << (cap.samples.I.empty() ? 0 : *mm.second - *mm.first) << "\n";
+    }
+    
+    auto mb_per_s = [](size_t bytes, double ms) {
+        return ms > 0.0 ? bytes / (ms * 1e3) : 0.0;
+    };
+    std::cout << "\n  Single-channel loop : " << mb_per_s(serial_bytes, serial_ms) << " MB/s\n";
+    std::cout << "  Simultaneous        : " << mb_per_s(parallel_bytes, parallel_ms) << " MB/s"
+              << " (readout only " << mb_per_s(parallel_bytes, readout_ms) << " MB/s)\n";
+    if (parallel_ms > 0.0 && serial_ms > 0.0) {
+        std::cout << "  Speedup             : " << std::setprecision(2)
+                  << (serial_ms / serial_bytes) / (parallel_ms / parallel_bytes) << "x\n\n";
+    }
+}
+
+void RfDcApp::run_dac_batch_upload_test()
+{
+    std::cout << "━━━ Running DAC Batch Upload Test ━━━\n";
+    
+    const size_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr int iterations = 20;
+    
+    // One distinct DC level per mapped DAC channel
+    std::vector<buffer_pool::SampleVector> waveforms;
+    std::vector<DacUpload> uploads;
+    waveforms.reserve(16);
+    for (uint32_t channel = 0; channel < 16; ++channel) {
+        if (!bram_window(rfdc::TileType::DAC, channel)) {
+            continue;
+        }
+        waveforms.push_back(generate_dc_offset(static_cast<int16_t>(1000 * (channel + 1)), num_samples));
+        DacUpload up;
+        up.tile = channel / 4;
+        up.block = channel % 4;
+        up.samples = waveforms.back();
+        uploads.push_back(up);
+    }
+    if (uploads.empty()) {
+        std::cout << "  ✗ No mapped DAC channels\n";
+        return;
+    }
+    
+    // ----- Before: one call per block, FIFO enabled every time -----
+    auto t0 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (const auto& up : uploads) {
+            const uint32_t size_bytes = up.samples.size() * sizeof(int16_t);
+            std::vector<uint8_t> raw(size_bytes);
+            std::memcpy(raw.data(), up.samples.data(), size_bytes);
+            write_dac_bram_rftool_style(up.tile, up.block, size_bytes, raw);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    
+    // ----- After: one batch -----
+    int ret = SUCCESS;
+    for (int it = 0; it < iterations && ret == SUCCESS; ++it) {
+        ret = write_dac_batch(uploads);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    
+    // Read back to confirm every level landed in its own channel
+    bool verified = (ret == SUCCESS);
+    std::vector<int16_t> readback;
+    for (const auto& up : uploads) {
+        const auto* win = bram_window(rfdc::TileType::DAC, up.tile * 4 + up.block);
+        const size_t bytes = up.samples.size() * sizeof(int16_t);
+        readback.resize(up.samples.size());
+        device_copy::from_device(readback.data(), win->I, bytes);
+        verified &= std::memcmp(readback.data(), up.samples.data(), bytes) == 0;
+    }
+    
+    uint32_t tiles = 0;
+    for (const auto& up : uploads) {
+        tiles |= 1u << up.tile;
+    }
+    auto us_per_load = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / iterations;
+    };
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\n  Channels          : " << uploads.size() << " x " << num_samples << " samples\n";
+    std::cout << "  Per-block writes  : " << uploads.size() << " FIFO enables, "
+              << us_per_load(t1 - t0) << " us/load\n";
+    std::cout << "  Batch write       : " << __builtin_popcount(tiles) << " FIFO enables, "
+              << us_per_load(t2 - t1) << " us/load\n";
+    std::cout << "  " << (verified ? "✓ All channels verified" : "✗ Readback mismatch") << "\n\n";
+}
+
+void RfDcApp::run_buffer_pool_test()
+{
+    std::cout << "━━━ Running Buffer Pool Test ━━━\n";
+    std::cout << "  Capture + waveform + encode loop, Tile 0 Block 0\n\n";
+    
+    auto& pool = buffer_pool::BufferPool::shared();
+    const size_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr int iterations = 100;
+    
+    codec::StringCodec::Config config;
+    config.modulation = codec::StringCodec::ModulationType::QPSK;
+    codec::StringCodec codec(config);
+    buffer_pool::SampleVector tx_I, tx_Q;
+    
+    bool aligned = true;
+    auto iteration = [&](int it) {
+        AdcSamples captured = read_adc_samples_i_q(0, 0, num_samples, false);
+        auto wave = generate_dc_offset(static_cast<int16_t>(it), num_samples);
+        codec.encode("Hello RFSoC", tx_I, tx_Q);
+        
+        aligned &= (reinterpret_cast<uintptr_t>(captured.I.data()) % buffer_pool::BufferPool::ALIGNMENT) == 0;
+        aligned &= (reinterpret_cast<uintptr_t>(wave.data()) % buffer_pool::BufferPool::ALIGNMENT) == 0;
+    };
+    
+    // Warm-up: one full iteration takes the peak number of blocks
+    iteration(0);
+    pool.reset_stats();
+    
+    for (int it = 0; it < iterations; ++it) {
+        iteration(it);
+    }
+    
+    const auto st = pool.stats();
+    std::cout << "  Block size        : " << pool.block_bytes() << " bytes\n";
+    std::cout << "  Heap allocations  : " << st.heap_allocations << "\n";
+    std::cout << "  Reused blocks     : " << st.reuses << "\n";
+    std::cout << "  Oversize requests : " << st.oversize << "\n";
+    std::cout << "  Outstanding/cached: " << st.outstanding << "/" << st.cached << "\n";
+    std::cout << "  " << (aligned ? "✓" : "✗") << " Buffers 64-byte aligned\n";
+    std::cout << "  " << (st.heap_allocations == 0 ? "✓ No heap allocations in steady state"
+                                                  : "✗ Pool still allocating in steady state") << "\n\n";
+}
+
+void RfDcApp::run_device_copy_benchmark()
+{
+    std::cout << "━━━ Device Copy Benchmark ━━━\n";
+    std::cout << "  Full-window transfers per copy strategy (memcpy: host reference only)\n\n";
+    
+    constexpr int iterations = 200;
+    const size_t size_bytes = FIFO_SIZE;
+    
+    auto report = [](const char* target, const std::vector<device_copy::BenchResult>& results) {
+        std::cout << "  " << target << ":\n";
+        stream_format::Restore restore(std::cout);
+        std::cout << std::fixed << std::setprecision(1);
+        for (const auto& r : results) {
+            std::cout << "    " << std::left << std::setw(8) << device_copy::to_string(r.strategy)
+                      << std::right << " write " << std::setw(8) << r.write_mb_per_s << " MB/s"
+                      << "   read " << std::setw(8) << r.read_mb_per_s << " MB/s"
+                      << "   " << (r.verified ? "✓" : "✗") << "\n";
+        }
+    };
+    
+    // ----- memfd stand-in: a shared mapping without a real device behind it -----
+    int fd = memfd_create("rfdc_copy_bench", 0);
+    if (fd >= 0 && ftruncate(fd, size_bytes) == 0) {
+        void* buf = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (buf != MAP_FAILED) {
+            // memcpy only here, as a reference: it is not safe on Device memory
+            report("memfd mapping", device_copy::benchmark(buf, size_bytes, iterations, true));
+            munmap(buf, size_bytes);
+        }
+    } else {
+        perror("memfd_create");
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    
+    // ----- Real BRAM: DAC Tile 0 Block 0 window (overwrites its waveform) -----
+    const auto* win = bram_window(rfdc::TileType::DAC, 0);
+    if (!win) {
+        std::cout << "  ✗ DAC Tile 0 Block 0 not mapped, cannot run BRAM benchmark\n\n";
+        return;
+    }
+    auto results = device_copy::benchmark(win->I, std::min(size_bytes, win->size), iterations);
+    report("DAC BRAM (Tile 0 Block 0)", results);
+    
+    auto chosen = device_copy::select_fastest(results);
+    std::cout << "\n  ✓ Active strategy: " << device_copy::to_string(chosen) << "\n\n";
+}
+
+void RfDcApp::run_capture_file_test()
+{
+    std::cout << "━━━ Running Capture File Test ━━━\n";
+    std::cout << "  16K-sample I/Q capture: binary + sidecar vs CSV\n\n";
+    
+    const size_t num_samples = 16 * 1024;
+    const double fs = 1e9;
+    auto iq = generate_iq_sine_wave(10e6, fs, 1, num_samples, 20000);
+    
+    auto meta = capture_metadata(rfdc::TileType::ADC, 0, 0, fs);
+    meta.q_block = 1;
+    meta.notes = "capture file round trip";
+    
+    auto t0 = std::chrono::steady_clock::now();
+    save_capture("capture_file_test", iq.I, iq.Q, meta);
+    auto t1 = std::chrono::steady_clock::now();
+    save_samples_to_csv(iq.I, iq.Q, fs, "capture_file_test.csv", "");
+    auto t2 = std::chrono::steady_clock::now();
+    
+    capture_file::MappedCapture mapped;
+    if (!mapped.open("capture_file_test.ci16")) {
+        std::cout << "  ✗ Could not map capture_file_test.ci16\n";
+        return;
+    }
+    
+    bool match = mapped.is_iq() && mapped.num_samples() == num_samples;
+    for (size_t n = 0; match && n < num_samples; ++n) {
+        match = mapped.i(n) == iq.I[n] && mapped.q(n) == iq.Q[n];
+    }
+    
+    struct stat bin_st, csv_st;
+    stat("capture_file_test.ci16", &bin_st);
+    stat("capture_file_test.csv", &csv_st);
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Binary : " << bin_st.st_size / 1024.0 << " KB in "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+    std::cout << "  CSV    : " << csv_st.st_size / 1024.0 << " KB in "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms\n";
+    std::cout << "  Sidecar: " << mapped.metadata().type << " T" << mapped.metadata().tile
+              << " B" << mapped.metadata().block << "/" << mapped.metadata().q_block
+              << ", " << mapped.metadata().sample_rate_hz / 1e6 << " MHz, mixer "
+              << mapped.metadata().mixer_mode << "\n";
+    std::cout << "  " << (match ? "✓ mmap readback matches" : "✗ mmap readback mismatch") << "\n\n";
+}
+
+void RfDcApp::run_recording_test()
+{
+    std::cout << "━━━ Running Recording Test ━━━\n";
+    std::cout << "  Continuous ADC Tile 0 Block 0 captures, synchronous vs background writer\n\n";
+    
+    const uint32_t tile = 0;
+    const uint32_t block = 0;
+    const uint32_t channel_mask = 1u << block;
+    const size_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr int captures = 200;
+    
+    auto adc_pll = rfdc_->get_pll_config(rfdc::TileType::ADC, tile);
+    auto meta = capture_metadata(rfdc::TileType::ADC, tile, block, adc_pll.sample_rate() * 1e9);
+    
+    auto capture_once = [&]() {
+        set_local_mem_sample(rfdc::TileType::ADC, tile, block, num_samples);
+        local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, channel_mask);
+        wait_for_capture(rfdc::TileType::ADC, tile, channel_mask);
+        return read_adc_samples_i_q(tile, block, num_samples, false);
+    };
+    
+    // ----- Before: write each capture before the next trigger -----
+    auto t0 = std::chrono::steady_clock::now();
+    for (int n = 0; n < captures; ++n) {
+        AdcSamples s = capture_once();
+        meta.timestamp_ns = capture_file::now_ns();
+        save_capture(format_msg("rec_sync_", n), s.I, s.Q, meta);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    
+    // ----- After: hand buffers to the writer thread -----
+    auto& writer = recorder();
+    const auto before = writer.stats();
+    AdcSamples kept;    // Last capture, to check against its file
+    for (int n = 0; n < captures; ++n) {
+        meta.timestamp_ns = capture_file::now_ns();
+        AdcSamples s = capture_once();
+        if (n == captures - 1) {
+            kept = s;
+        }
+        record_capture(format_msg("rec_async_", n), std::move(s), meta);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    writer.flush();
+    auto t3 = std::chrono::steady_clock::now();
+    
+    auto rate = [](std::chrono::steady_clock::duration d) {
+        double s = std::chrono::duration<double>(d).count();
+        return s > 0.0 ? captures / s : 0.0;
+    };
+    auto st = writer.stats();
+    st.written -= before.written;
+    st.dropped -= before.dropped;
+    st.failed -= before.failed;
+    st.stalls -= before.stalls;
+    
+    // Read the last background file back the way run_capture_file_test does
+    const std::string last_file = format_msg("rec_async_", captures - 1, kept.is_iq ? ".ci16" : ".i16");
+    capture_file::MappedCapture mapped;
+    bool match = mapped.open(last_file) && mapped.is_iq() == kept.is_iq &&
+                 mapped.num_samples() == kept.size();
+    for (size_t n = 0; match && n < kept.size(); ++n) {
+        match = mapped.i(n) == kept.I[n] && (!kept.is_iq || mapped.q(n) == kept.Q[n]);
+    }
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\n  Synchronous save  : " << rate(t1 - t0) << " captures/s\n";
+    std::cout << "  Background writer : " << rate(t2 - t1) << " captures/s (drain +"
+              << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms)\n";
+    std::cout << "  Writer            : " << st.written << " written, " << st.dropped << " dropped, "
+              << st.failed << " failed, " << st.stalls << " stalls, queue high-water "
+              << st.high_water << "/" << writer.options().queue_depth << "\n";
+    std::cout << "  Disk throughput   : " << st.mb_per_s() << " MB/s"
+              << (st.direct_io ? " (O_DIRECT)" : "") << "\n";
+    const bool recorded = (st.written == captures && st.failed == 0 && st.dropped == 0);
+    std::cout << "  " << (recorded ? "✓" : "✗") << " " << st.written << "/" << captures
+              << " background captures on disk\n";
+    std::cout << "  " << (match ? "✓" : "✗") << " " << last_file
+              << (match ? " matches its capture" : " does not match its capture") << "\n\n";
+}
+
+void RfDcApp::run_shm_ring_test()
+{
+    std::cout << "━━━ Running Shared-Memory Ring Test ━━━\n";
+    std::cout << "  Host only: publisher in this process, reader in a forked process\n\n";
+    
+    const char* ring_name = "/rfdc_ring_test";
+    const uint32_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr uint32_t frames = 20000;
+    
+    shm_ring::Writer writer;
+    if (!writer.create(ring_name, CAPTURE_RING_SLOTS, 2 * FIFO_SIZE)) {
+        std::cout << "  ✗ Could not create " << ring_name << "\n";
+        return;
+    }
+    
+    struct ReaderReport {
+        uint64_t received;
+        uint64_t lost;
+        uint64_t corrupt;
+        double mean_latency_us;
+        double max_latency_us;
+    };
+    
+    int ready_pipe[2];
+    int report_pipe[2];
+    if (pipe(ready_pipe) != 0 || pipe(report_pipe) != 0) {
+        perror("pipe");
+        return;
+    }
+    
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return;
+    }
+    
+    if (pid == 0) {
+        // ----- Reader process -----
+        ReaderReport report = {};
+        shm_ring::Reader reader;
+        char go = reader.open(ring_name) ? 1 : 0;
+        (void)!write(ready_pipe[1], &go, 1);
+        
+        shm_ring::FrameHeader frame;
+        buffer_pool::SampleVector I, Q;
+        double latency_sum = 0.0;
+        while (go && reader.next(frame, I, Q, std::chrono::milliseconds(500)) ==
+                     shm_ring::Reader::Status::Ok) {
+            double latency_us = (capture_file::now_ns() - frame.timestamp_ns) / 1e3;
+            latency_sum += latency_us;
+            report.max_latency_us = std::max(report.max_latency_us, latency_us);
+            if (I.size() != num_samples || Q.size() != num_samples ||
+                I.front() != static_cast<int16_t>(frame.seq) ||
+                Q.back() != static_cast<int16_t>(~frame.seq)) {
+                report.corrupt++;
+            }
+            if (++report.received + reader.lost() >= frames) {
+                break;
+            }
+        }
+        report.lost = reader.lost();
+        report.mean_latency_us = report.received ? latency_sum / report.received : 0.0;
+        (void)!write(report_pipe[1], &report, sizeof(report));
+        _exit(0);
+    }
+    
+    // ----- Publisher -----
+    char go = 0;
+    if (read(ready_pipe[0], &go, 1) != 1 || !go) {
+        std::cout << "  ✗ Reader could not attach\n";
+        waitpid(pid, nullptr, 0);
+        return;
+    }
+    
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < frames; ++n) {
+        int16_t* slot = writer.begin(2, num_samples);
+        std::fill(slot, slot + num_samples, static_cast<int16_t>(n));
+        std::fill(slot + num_samples, slot + 2 * num_samples, static_cast<int16_t>(~n));
+        
+        shm_ring::FrameHeader frame;
+        frame.timestamp_ns = capture_file::now_ns();
+        frame.tile = n % 4;
+        frame.block = (n / 4) % 4;
+        frame.sample_rate_hz = 1e9;
+        std::strncpy(frame.mixer_mode, "C2C", sizeof(frame.mixer_mode) - 1);
+        writer.commit(frame);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    
+    ReaderReport report = {};
+    bool reported = read(report_pipe[0], &report, sizeof(report)) == sizeof(report);
+    waitpid(pid, nullptr, 0);
+    for (int fd : {ready_pipe[0], ready_pipe[1], report_pipe[0], report_pipe[1]}) {
+        close(fd);
+    }
+    writer.close();
+    
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+    double mb = static_cast<double>(frames) * 2 * FIFO_SIZE / 1e6;
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Published : " << frames << " frames x " << 2 * FIFO_SIZE / 1024 << " KB in "
+              << secs * 1e3 << " ms (" << frames / secs << " frames/s, " << mb / secs << " MB/s)\n";
+    if (!reported) {
+        std::cout << "  ✗ No report from reader process\n\n";
+    } else {
+        std::cout << "  Reader    : " << report.received << " received, " << report.lost
+                  << " lost (overrun), " << report.corrupt << " corrupt\n";
+        std::cout << "  Latency   : mean " << report.mean_latency_us << " µs, max "
+                  << report.max_latency_us << " µs\n";
+        if (report.received == 0 || report.received + report.lost != frames) {
+            std::cout << "  ✗ Reader accounted for " << report.received + report.lost
+                      << " of " << frames << " frames\n\n";
+        } else if (report.corrupt != 0) {
+            std::cout << "  ✗ Torn frames delivered\n\n";
+        } else {
+            std::cout << "  ✓ No torn frames delivered\n\n";
+        }
+    }
+    
+    // ----- The app's own ring: BRAM captures and DDR stream chunks -----
+    std::cout << "  Capture ring " << CAPTURE_RING_NAME << ":\n";
+    shm_ring::Reader app_reader;
+    if (!app_reader.open(CAPTURE_RING_NAME)) {
+        std::cout << "    ✗ Could not attach to " << CAPTURE_RING_NAME << "\n\n";
+        return;
+    }
+    
+    shm_ring::FrameHeader frame;
+    buffer_pool::SampleVector I, Q;
+    AdcSamples captured = read_adc_samples_i_q(0, 0, num_samples, false);
+    bool bram_ok = app_reader.next(frame, I, Q, std::chrono::milliseconds(500)) ==
+                   shm_ring::Reader::Status::Ok &&
+                   frame.tile == 0 && frame.block == 0 &&
+                   std::equal(captured.I.begin(), captured.I.end(), I.begin(), I.end()) &&
+                   std::equal(captured.Q.begin(), captured.Q.end(), Q.begin(), Q.end());
+    std::cout << "    " << (bram_ok ? "✓" : "✗") << " BRAM capture published ("
+              << I.size() << " samples, " << frame.lanes << " lane(s))\n";
+    
+    // A few slots' worth of DDR stream, so every frame is still in the ring
+    const size_t stream_samples = 4 * num_samples;
+    const uint64_t before = capture_ring_.published();
+    buffer_pool::SampleVector head;
+    int ret = capture_adc_ddr_stream(0, 0, stream_samples, stream_samples,
+        [&](const StreamChunk& chunk) {
+            if (chunk.index == 0) {
+                head.resize(std::min<size_t>(chunk.samples.size(), 2 * FIFO_SIZE / sizeof(int16_t)));
+                device_copy::from_device(head.data(), chunk.samples.data(), head.size() * sizeof(int16_t));
+            }
+            return true;
+        });
+    const uint64_t stream_frames = capture_ring_.published() - before;
+    
+    size_t stream_values = 0;
+    bool first = true;
+    bool ddr_ok = (ret == SUCCESS && stream_frames > 0);
+    for (uint64_t n = 0; ddr_ok && n < stream_frames; ++n) {
+        if (app_reader.next(frame, I, Q, std::chrono::milliseconds(500)) != shm_ring::Reader::Status::Ok) {
+            ddr_ok = false;
+            break;
+        }
+        stream_values += I.size() + Q.size();
+        if (first) {
+            // Frames are planar; the stream interleaves I/Q when both lanes are present
+            for (size_t k = 0; k < I.size() && ddr_ok; ++k) {
+                const size_t i = (frame.lanes == 2) ? 2 * k : k;
+                ddr_ok = (i >= head.size()) ||
+                         (I[k] == head[i] && (frame.lanes == 1 || Q[k] == head[i + 1]));
+            }
+            first = false;
+        }
+    }
+    std::cout << "    " << (ddr_ok && app_reader.lost() == 0 ? "✓" : "✗") << " DDR stream published ("
+              << stream_frames << " frames, " << stream_values << " values)\n\n";
+}
+
+void RfDcApp::run_capture_server_test()
+{
+    std::cout << "━━━ Running Capture Server Test ━━━\n";
+    std::cout << "  Local client against an in-process server, ADC Tile 0 Block 0\n\n";
+    
+    const std::string socket_path = "/tmp/rfdc_capture_test.sock";
+    const uint32_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr uint32_t requests = 8;
+    constexpr uint32_t repeat = 25;
+    
+    const uint32_t channel_mask = enabled_adc_channel_mask();
+    capture_server::Options opts;
+    opts.max_samples = num_samples;
+    capture_server::Server server(
+        socket_path,
+        [this, channel_mask](const capture_server::Request& req, capture_server::Block& out) {
+            capture_for_client(channel_mask, req, out);
+        },
+        opts);
+    if (!server.start()) {
+        std::cout << "  ✗ Could not start server on " << socket_path << "\n";
+        return;
+    }
+    
+    capture_server::Client client;
+    if (!client.connect(socket_path)) {
+        std::cout << "  ✗ Could not connect to " << socket_path << "\n";
+        return;
+    }
+    
+    capture_server::Request req;
+    req.tile = 0;
+    req.block = 0;
+    req.num_samples = num_samples;
+    capture_server::FrameHeader frame;
+    buffer_pool::SampleVector I, Q;
+    std::string error;
+    
+    // ----- Before: one capture per round trip -----
+    auto t0 = std::chrono::steady_clock::now();
+    req.repeat = 1;
+    uint32_t sequential = 0;
+    for (uint32_t n = 0; n < requests * repeat; ++n) {
+        req.id = n;
+        if (client.send(req) && client.receive(frame, I, Q, &error) && frame.status == 0) {
+            sequential++;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
     
-    std::cout << "  ✓ Generated " << num_samples 
-              << " sample DC offset: " << value << "\n";
+    // ----- After: all requests in flight, frames streamed back -----
+    req.repeat = repeat;
+    for (uint32_t n = 0; n < requests; ++n) {
+        req.id = 1000 + n;
+        client.send(req);
+    }
+    uint32_t pipelined = 0;
+    bool in_order = true;
+    for (uint32_t n = 0; n < requests * repeat; ++n) {
+        if (!client.receive(frame, I, Q, &error) || frame.status != 0) {
+            break;
+        }
+        in_order = in_order && frame.request_id == 1000 + n / repeat && frame.index == n % repeat &&
+                   frame.num_samples == num_samples;
+        pipelined++;
+    }
+    auto t2 = std::chrono::steady_clock::now();
     
-    return samples;
+    // ----- Errors are reported, not fatal -----
+    req.id = 9999;
+    req.tile = 9;
+    req.repeat = 1;
+    bool rejected = client.send(req) && client.receive(frame, I, Q, &error) &&
+                    frame.status == static_cast<uint32_t>(capture_server::Status::BadRequest);
+    
+    client.close();
+    server.stop();
+    
+    auto rate = [](uint32_t frames, std::chrono::steady_clock::duration d) {
+        double s = std::chrono::duration<double>(d).count();
+        return s > 0.0 ? frames / s : 0.0;
+    };
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Round trip per capture : " << sequential << " frames, "
+              << rate(sequential, t1 - t0) << " frames/s\n";
+    std::cout << "  Pipelined              : " << pipelined << " frames, "
+              << rate(pipelined, t2 - t1) << " frames/s\n";
+    const uint32_t expected = requests * repeat;
+    const bool all_served = (sequential == expected && pipelined == expected);
+    std::cout << "  " << (all_served ? "✓" : "✗") << " " << expected
+              << " frames served per mode\n";
+    std::cout << "  " << (all_served && in_order ? "✓" : "✗") << " Frames in request order\n";
+    std::cout << "  " << (rejected ? "✓" : "✗") << " Bad request rejected"
+              << (rejected ? " (\"" + error + "\")" : std::string()) << "\n\n";
 }
 
-// Simplify set_local_mem_sample to use LocalMem class
-void RfDcApp::set_local_mem_sample(rfdc::TileType type, uint32_t tile_id,
-                                   uint32_t block_id, uint32_t num_samples)
+void RfDcApp::run_loopback_timing_test()
 {
-    void* mem_base_addr = (type == rfdc::TileType::DAC) ? 
-                          rfdc_->get_dac_vaddr() : 
-                          rfdc_->get_adc_vaddr();
+    std::cout << "━━━ Running Loopback Timing Test ━━━\n";
+    std::cout << "  DAC Tile 0 Block 0 → ADC Tile 0 Block 0, combined trigger\n\n";
+    
+    constexpr uint32_t tile = 0;
+    constexpr uint32_t block = 0;
+    constexpr int runs = 10;
+    const size_t num_samples = 4096;
+    
+    // Square wave with a marker edge: unambiguous correlation peak over one period
+    buffer_pool::SampleVector waveform(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        waveform[i] = ((i / 16) % 2) ? 8000 : -8000;
+    }
+    for (size_t i = 0; i < 64; ++i) {
+        waveform[i] = 16000;
+    }
+    
+    std::vector<double> skew_ns;
+    std::vector<int64_t> offsets;
+    std::vector<double> correlations;
+    int completed = 0;
+    for (int run = 0; run < runs; ++run) {
+        auto cap = loopback_capture(tile, block, waveform, num_samples);
+        completed += cap.completion.completed ? 1 : 0;
+        skew_ns.push_back(static_cast<double>(cap.timing.skew.count()));
+        offsets.push_back(cap.offset);
+        correlations.push_back(cap.correlation);
+        stream_format::Restore restore(std::cout);
+        std::cout << "    run " << run << ": skew " << cap.timing.skew.count()
+                  << " ns, arm " << cap.timing.arm.count() << " ns, offset " << cap.offset
+                  << " (corr " << std::fixed << std::setprecision(3) << cap.correlation << ")\n";
+    }
     
-    const void* channel_map = (type == rfdc::TileType::DAC) ?
-                              static_cast<const void*>(rfdc_->get_dac_map().data()) :
-                              static_cast<const void*>(rfdc_->get_adc_map().data());
+    auto skew_mm = std::minmax_element(skew_ns.begin(), skew_ns.end());
+    auto off_mm = std::minmax_element(offsets.begin(), offsets.end());
+    auto corr_min = std::min_element(correlations.begin(), correlations.end());
+    double skew_mean = 0.0;
+    for (double v : skew_ns) {
+        skew_mean += v / skew_ns.size();
+    }
     
-    local_mem_->set_sample_count(type, tile_id, block_id, num_samples, 
-                                 mem_base_addr, channel_map);
+    std::cout << "\n  Completed        : " << completed << "/" << runs << "\n";
+    std::cout << "  Trigger skew     : min " << *skew_mm.first << " ns, mean "
+              << static_cast<int64_t>(skew_mean) << " ns, max " << *skew_mm.second << " ns\n";
+    const bool repeatable = *off_mm.first == *off_mm.second && *off_mm.first >= 0;
+    const bool locked_on = *corr_min >= 0.9;
+    std::cout << "  Capture offset   : " << *off_mm.first << " .. " << *off_mm.second << " samples\n";
+    std::cout << "  Correlation      : min " << *corr_min << "\n";
+    std::cout << "  " << (locked_on ? "✓ Waveform found in every capture"
+                                    : "✗ Weak correlation, offset unreliable") << "\n";
+    std::cout << "  " << (repeatable ? "✓ Offset repeatable across runs"
+                                     : "✗ Offset not repeatable across runs") << "\n\n";
 }
 
-// Simplify local_mem_trigger to use LocalMem class
-void RfDcApp::local_mem_trigger(rfdc::TileType type, uint32_t tile_id,
-                               uint32_t num_samples, uint32_t channel_mask)
+void RfDcApp::run_dac_hot_swap_test()
 {
-    if (channel_mask == 0) {
-        std::cout << "  • Reset " << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
-                  << " Tile " << tile_id << "\n";
-        
-        // Reset via LocalMem
-        void* mem_base_addr = (type == rfdc::TileType::DAC) ? 
-                              rfdc_->get_dac_vaddr() : 
-                              rfdc_->get_adc_vaddr();
-        
-        const void* channel_map = (type == rfdc::TileType::DAC) ?
-                                  static_cast<const void*>(rfdc_->get_dac_map().data()) :
-                                  static_cast<const void*>(rfdc_->get_adc_map().data());
-        
-        local_mem_->trigger(type, mem_base_addr, 0, channel_map);
+    std::cout << "━━━ Running DAC Hot-Swap Test ━━━\n";
+    std::cout << "  DAC Tile 0 Block 0, double-buffered cyclic playback\n\n";
+    
+    constexpr uint32_t tile = 0;
+    constexpr uint32_t block = 0;
+    constexpr uint32_t channel = tile * 4 + block;
+    constexpr int swaps = 8;
+    constexpr uint32_t interpolation = 40;      // Lowest fabric rate the DUC offers
+    const std::chrono::milliseconds target_half(10);
+    
+    const bram_map::ChannelWindow* win = bram_window(rfdc::TileType::DAC, channel);
+    if (!win || !info_.map_dac[channel] || info_.map_dac[channel] == MAP_FAILED) {
+        std::cout << "  ✗ DAC channel " << channel << " is not mapped\n\n";
         return;
     }
     
-    std::cout << "  • **TRIGGER** " << (type == rfdc::TileType::DAC ? "DAC" : "ADC")
-              << " Tile " << tile_id << " mask=0x" << std::hex << channel_mask << std::dec
-              << " samples=" << num_samples << "\n";
-    
-    // Use LocalMem hardware trigger
-    void* mem_base_addr = (type == rfdc::TileType::DAC) ? 
-                          rfdc_->get_dac_vaddr() : 
-                          rfdc_->get_adc_vaddr();
-    
-    const void* channel_map = (type == rfdc::TileType::DAC) ?
-                              static_cast<const void*>(rfdc_->get_dac_map().data()) :
-                              static_cast<const void*>(rfdc_->get_adc_map().data());
+    // Whole cycles per buffer so the waveform is continuous across boundaries
+    auto tone = [](size_t len, uint32_t cycles, int16_t amplitude) {
+        buffer_pool::SampleVector wave(len);
+        for (size_t i = 0; i < len; ++i) {
+            wave[i] = static_cast<int16_t>(std::lrint(
+                amplitude * std::sin(2.0 * M_PI * cycles * static_cast<double>(i) / len)));
+        }
+        return wave;
+    };
     
-    local_mem_->trigger(type, mem_base_addr, channel_mask, channel_map);
+    // ----- Before: stop, rewrite, re-trigger (output gap) -----
+    const size_t bram_samples = win->size / sizeof(int16_t) / 2;
+    auto first = tone(bram_samples, 16, 20000);
+    auto t0 = std::chrono::steady_clock::now();
+    local_mem_trigger(rfdc::TileType::DAC, tile, static_cast<uint32_t>(bram_samples), 0x0000);
+    set_local_mem_sample(rfdc::TileType::DAC, tile, block, static_cast<uint32_t>(bram_samples));
+    write_dac_samples(tile, block, first);
+    local_mem_trigger(rfdc::TileType::DAC, tile, static_cast<uint32_t>(bram_samples), 1u << block);
+    auto gap = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0);
+    local_mem_trigger(rfdc::TileType::DAC, tile, static_cast<uint32_t>(bram_samples), 0x0000);
+    
+    // ----- After: hot swap at buffer boundaries -----
+    // A half has to outlast a write plus the wake-up jitter of this thread:
+    // BRAM halves last ~1 us at GSPS rates, so play from DDR with the
+    // highest interpolation and halves of several milliseconds.
+    const converter_config::Config saved = config_;
+    converter_config::Config slow = config_;
+    for (auto& b : slow.dac[tile].blocks) {
+        b.factor = interpolation;
+    }
     
-    // Also trigger via UIO for redundancy (both methods used in RFTool)
-    for (uint32_t block = 0; block < 4; ++block) {
-        if (!(channel_mask & (1 << block))) {
-            continue;
+    int glitches = 0;
+    int64_t worst_latency = 0;
+    int64_t worst_write = 0;
+    int64_t half_us = 0;
+    bool ok = false;
+    try {
+        apply_config(slow);
+        if (set_dac_mem_type(tile, block, local_mem::LocalMem::MemType::DDR) != SUCCESS) {
+            throw std::runtime_error("DAC DDR mode unavailable");
+        }
+        if (change_fifo_stat(XRFDC_DAC_TILE, tile, 1) != SUCCESS) {
+            throw std::runtime_error("Failed to enable DAC FIFO");
         }
         
-        uint32_t channel = tile_id * 4 + block;
-        
-        if (type == rfdc::TileType::DAC) {
-            if (channel < 16 && info_.fd_dac[channel] >= 0) {
-                uint64_t trigger = 1;
-                write(info_.fd_dac[channel], &trigger, sizeof(trigger));
-                std::cout << "    ✓ Triggered DAC channel " << channel << " (UIO)\n";
-            }
-        } else {
-            if (channel < 16 && info_.fd_adc[channel] >= 0) {
-                uint64_t trigger = 1;
-                write(info_.fd_adc[channel], &trigger, sizeof(trigger));
-                std::cout << "    ✓ Triggered ADC channel " << channel << " (UIO)\n";
+        uint32_t words = 0;
+        rfdc_->get_fab_wr_vld_words(rfdc::TileType::DAC, tile, block, words);
+        const double rate = rfdc_->get_fabric_clk_freq(rfdc::TileType::DAC, tile) * 1e6 * words;
+        
+        const size_t window = info_.map_size_dac[channel] / sizeof(int16_t) / 2;
+        size_t half = static_cast<size_t>(rate * std::chrono::duration<double>(target_half).count());
+        half = std::min(half, window) / 16 * 16;
+        
+        dac_playback::DoubleBuffer::Config config;
+        config.tile = tile;
+        config.block = block;
+        config.regs = rfdc_->get_dac_vaddr();
+        config.memory = reinterpret_cast<uint8_t*>(info_.map_dac[channel]);
+        config.memory_bytes = info_.map_size_dac[channel];
+        config.samples_per_second = rate;
+        
+        dac_playback::DoubleBuffer player(*local_mem_, config);
+        if (!player.start(tone(half, 16, 20000))) {
+            throw std::runtime_error("DDR playback did not start");
+        }
+        half_us = std::chrono::duration_cast<std::chrono::microseconds>(player.half_period()).count();
+        std::cout << "\n  Half: " << half << " samples (DDR), " << half_us << " us at "
+                  << rate / 1e6 << " MS/s (" << interpolation << "x interpolation)\n";
+        
+        for (int n = 0; n < swaps; ++n) {
+            auto wave = tone(half, 16 + 8 * (n + 1), static_cast<int16_t>(20000 - 1000 * n));
+            auto report = player.swap(wave);
+            if (!report.swapped) {
+                throw std::runtime_error("Swap failed");
             }
+            glitches += report.glitch ? 1 : 0;
+            worst_latency = std::max<int64_t>(worst_latency, report.latency.count());
+            worst_write = std::max<int64_t>(worst_write, report.write_time.count() / 2);
+            std::cout << "    swap " << n << ": latency " << report.latency.count()
+                      << " us, writes " << report.write_time.count() << " us, half "
+                      << report.first_half << (report.glitch ? ", ✗ glitch" : "") << "\n";
         }
+        player.stop();
+        ok = true;
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ Hot swap failed: " << e.what() << "\n";
+    }
+    
+    // Back to BRAM playback at the configured rate
+    set_dac_mem_type(tile, block, local_mem::LocalMem::MemType::BRAM);
+    try {
+        apply_config(saved);
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ DAC tile " << tile << " not restored: " << e.what() << "\n";
+    }
+    if (!ok) {
+        std::cout << "\n";
+        return;
+    }
+    
+    std::cout << "\n  Stop/rewrite/re-trigger gap : " << gap.count() << " us\n";
+    std::cout << "  Hot swap worst latency      : " << worst_latency << " us (no gap)\n";
+    std::cout << "  Slowest half write          : " << worst_write << " of " << half_us << " us\n";
+    std::cout << "  " << (glitches == 0 ? "✓" : "✗") << " " << glitches << "/" << swaps
+              << " swaps glitched";
+    if (glitches > 0) {
+        std::cout << " (a write overlapped playback of its half)";
     }
+    std::cout << "\n\n";
 }
 
-void RfDcApp::update_pll_sample_rate(
-    rfdc::TileType type,
-    uint32_t tile,
-    double desired_sample_rate_mhz
-)
+void RfDcApp::run_mmio_trace_test()
 {
-    // Read current PLL configuration
-    auto pll = rfdc_->get_pll_config(type, tile);
-
-    std::cout << format_msg(
-        "    • Updating PLL Fs ",
-        pll.sample_rate_mhz(),
-        " MHz → ",
-        desired_sample_rate_mhz,
-        " MHz\n"
-    );
-
-    // Reuse existing ref clock & source
-    rfdc_->set_pll_config(
-        type,
-        tile,
-        rfdc::ClockSource::Internal,
-        pll.ref_clk_freq(),                // MHz
-        desired_sample_rate_mhz   // MHz
-    );
+    std::cout << "━━━ Running MMIO Trace Test ━━━\n";
+    std::cout << "  Register accesses per operation: capture, MMCM program, FIFO enable\n\n";
+    
+    constexpr uint32_t tile = 0;
+    constexpr uint32_t block = 0;
+    constexpr int captures = 4;
+    const uint32_t num_samples = FIFO_SIZE / sizeof(int16_t) / 2;
+    
+    const bool was_enabled = mmio::trace::enabled();
+    mmio::trace::enable(true);
+    mmio::trace::clear();
+    
+    for (int n = 0; n < captures; ++n) {
+        set_local_mem_sample(rfdc::TileType::ADC, tile, block, num_samples);
+        local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, 1u << block);
+        wait_for_capture(rfdc::TileType::ADC, tile, 1u << block);
+    }
+    clock_wiz_->program_mmcm(rfdc::TileType::ADC, tile);
+    change_fifo_stat(XRFDC_DAC_TILE, tile, 1);
+    change_fifo_stat(XRFDC_DAC_TILE, tile, 1);
+    
+    std::cout << "\n";
+    mmio::trace::print_summary(std::cout);
+    std::cout << "\n  (rfdc.* rows time driver calls; their register accesses happen\n"
+              << "   inside libmetal and are not counted)\n\n";
+    
+    mmio::trace::enable(was_enabled);
+}
 
-    // Optional: wait for lock
-    for (int retry = 0; retry < 100; ++retry) {
-        if (rfdc_->get_pll_lock_status(type, tile)) {
-            std::cout << "    • PLL locked\n";
-            return;
+void RfDcApp::run_config_cache_test()
+{
+    std::cout << "━━━ Running Config Cache Test ━━━\n";
+    std::cout << "  Per-capture configuration reads: shadow hits vs hardware reads\n\n";
+    
+    constexpr uint32_t tile = 0;
+    constexpr int iterations = 1000;
+    using clock = std::chrono::steady_clock;
+    
+    // One capture's worth of configuration reads
+    auto read_config = [this]() {
+        for (uint32_t block = 0; block < 4; ++block) {
+            if (!rfdc_->check_block_enabled(rfdc::TileType::ADC, tile, block)) {
+                continue;
+            }
+            rfdc_->get_mixer_settings(rfdc::TileType::ADC, tile, block);
+            rfdc_->get_decimation_factor(tile, block);
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        rfdc_->get_pll_config(rfdc::TileType::ADC, tile);
+        rfdc_->check_high_speed_adc(tile);
+    };
+    
+    auto t0 = clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        rfdc_->resync_config(rfdc::TileType::ADC, tile);
+    }
+    auto t1 = clock::now();
+    
+    rfdc::RFDC::CacheStats before = rfdc_->config_cache_stats();
+    for (int i = 0; i < iterations; ++i) {
+        read_config();
+    }
+    auto t2 = clock::now();
+    rfdc::RFDC::CacheStats after = rfdc_->config_cache_stats();
+    
+    double cold_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+    double warm_us = std::chrono::duration<double, std::micro>(t2 - t1).count() / iterations;
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  Resync from hardware:   " << cold_us << " us\n";
+    std::cout << "  Reads from shadow:      " << warm_us << " us\n";
+    std::cout << "  Hits/misses during reads: " << (after.hits - before.hits) << "/"
+              << (after.misses - before.misses) << "\n";
+    
+    if (after.misses == before.misses) {
+        std::cout << "  ✓ All reads served from the shadow\n\n";
+    } else {
+        std::cout << "  ✗ " << (after.misses - before.misses) << " reads went to hardware\n\n";
     }
-
-    throw std::runtime_error(
-        format_msg("PLL failed to lock on tile ", tile)
-    );
 }
 
-
-// ===== CRITICAL FIX: Reduce amplitude to avoid clipping =====
-RfDcApp::AdcSamples RfDcApp::read_adc_samples_i_q(
-    uint32_t tile,
-    uint32_t block,
-    size_t num_samples
-)
+void RfDcApp::run_config_apply_test()
 {
-    AdcSamples captured;
-    captured.I.clear();
-    captured.Q.clear();
-    captured.is_iq = false;
-
-    // ------------------------------------------------------------
-    // 1) Check mixer settings to determine if we're in I/Q mode
-    // ------------------------------------------------------------
-    auto mixer = rfdc_->get_mixer_settings(rfdc::TileType::ADC, tile, block);
-    bool is_high_speed = rfdc_->check_high_speed_adc(tile);
-
-    // Determine if this is REAL or IQ mode based on mixer
-    bool is_real = 
-        (mixer.mode() == rfdc::MixerMode::R2R) ||
-        (mixer.type() == rfdc::MixerType::Coarse &&
-         mixer.frequency() == XRFDC_COARSE_MIX_BYPASS);
-
-    bool is_iq_mode = !is_real;
-
-    std::cout << "--------------------------------------------------\n";
-    std::cout << "ADC Read (Tile " << tile << ", Block " << block << ")\n";
-    std::cout << "  Mixer Mode     : " << rfdc_->to_string(mixer.mode()) << "\n";
-    std::cout << "  Mixer Type     : " << rfdc_->to_string(mixer.type()) << "\n";
-    std::cout << "  High-speed ADC : " << (is_high_speed ? "YES" : "NO") << "\n";
-    std::cout << "  Detected Mode  : " << (is_iq_mode ? "I/Q" : "REAL") << "\n";
-    std::cout << "--------------------------------------------------\n";
-
-    // ------------------------------------------------------------
-    // 2) Calculate read size (must be word-aligned)
-    //    RFDC BRAM stores 2× int16 per 32-bit word
-    // ------------------------------------------------------------
-    const size_t samples_per_word = 2;
-    const size_t words = (num_samples + samples_per_word - 1) / samples_per_word;
-    const uint32_t size_bytes = words * sizeof(uint32_t);
-
-    // ------------------------------------------------------------
-    // 3) REAL mode - read from single block (I channel only)
-    // ------------------------------------------------------------
-    if (!is_iq_mode) {
-        std::cout << "  Reading REAL mode from block " << block << "\n";
-        
-        std::vector<uint8_t> raw;
-        int ret = read_adc_bram_rftool_style(tile, block,size_bytes, raw);
-        
-        if (ret != SUCCESS) {
-            throw std::runtime_error("Failed to read ADC BRAM (REAL mode)");
+    std::cout << "━━━ Running Config Apply Test ━━━\n";
+    std::cout << "  Re-apply unchanged, retune one NCO, restore, then full apply\n\n";
+    
+    const converter_config::Config original = config_;
+    MonitorPause pause(monitor_.get());
+    
+    auto run_step = [this](const char* title, const converter_config::Config& config,
+                           bool force, double* ms = nullptr) {
+        std::cout << "  " << title << ":\n";
+        converter_config::Applier::Options options;
+        options.force = force;
+        options.verbose = false;
+        auto t0 = std::chrono::steady_clock::now();
+        converter_config::Report report = config_applier_->apply(config, options);
+        auto t1 = std::chrono::steady_clock::now();
+        converter_config::print_report(report, std::cout);
+        std::cout << "\n";
+        if (ms) {
+            *ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
         }
-
-        // Decode int16 stream
-        const int16_t* s = reinterpret_cast<const int16_t*>(raw.data());
-        const size_t total_samples = raw.size() / sizeof(int16_t);
-
-        captured.I.reserve(num_samples);
-        for (size_t i = 0; i < total_samples && captured.I.size() < num_samples; ++i) {
-            captured.I.push_back(s[i]);
+        return report;
+    };
+    auto step_count = [](const converter_config::Report& report, const char* name) {
+        for (const auto& step : report.steps) {
+            if (step.name == name) {
+                return step.count;
+            }
         }
+        return 0u;
+    };
+    // Exactly one mixer write and its event, nothing else
+    auto only_mixer = [&](const converter_config::Report& report) {
+        return report.changes == 1 && step_count(report, "mixer") == 1 &&
+               step_count(report, "mixer_event") == 1;
+    };
+    
+    double unchanged_ms = 0.0;
+    const auto unchanged = run_step("Unchanged", original, false, &unchanged_ms);
+    
+    converter_config::Config retuned = original;
+    retuned.adc[0].blocks[0].mixer.freq_mhz = 100.0;
+    const auto retune = run_step("ADC 0/0 NCO → 100 MHz", retuned, false);
+    const auto restored = run_step("Restore", original, false);
+    
+    double full_ms = 0.0;
+    run_step("Full apply (force)", original, true, &full_ms);
+    local_mem_->refresh_topology();
+    
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Diff apply " << unchanged_ms << " ms vs full " << full_ms << " ms\n";
+    std::cout << "  " << (unchanged.changes == 0 ? "✓" : "✗") << " Unchanged apply: "
+              << unchanged.changes << " changes\n";
+    std::cout << "  " << (only_mixer(retune) ? "✓" : "✗") << " NCO retune: " << retune.changes
+              << " change(s), " << step_count(retune, "mixer") << " mixer write, "
+              << step_count(retune, "mixer_event") << " mixer event\n";
+    std::cout << "  " << (only_mixer(restored) ? "✓" : "✗") << " Restore: " << restored.changes
+              << " change(s)\n\n";
+}
 
-        captured.is_iq = false;
-        std::cout << "  ✓ Read " << captured.I.size() << " REAL samples\n";
-        return captured;
+void RfDcApp::run_lock_time_test()
+{
+    std::cout << "━━━ Running Lock Time Test ━━━\n";
+    std::cout << "  Forced re-apply (every PLL and MMCM relocks), three rounds\n\n";
+    
+    lock_wait::reset_stats();
+    MonitorPause pause(monitor_.get());
+    converter_config::Applier::Options options;
+    options.force = true;
+    options.verbose = false;
+    for (int round = 0; round < 3; ++round) {
+        auto t0 = std::chrono::steady_clock::now();
+        config_applier_->apply(config_, options);
+        auto t1 = std::chrono::steady_clock::now();
+        stream_format::Restore restore(std::cout);
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  Round " << round << ": "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
     }
-
-    // ------------------------------------------------------------
-    // 4) I/Q mode - read from BOTH addr_I and addr_Q of the SAME block
-    // ------------------------------------------------------------
-    std::cout << "  Reading I/Q mode from block " << block << " (I and Q addresses)\n";
-
-    const auto& adc_map = rfdc_->get_adc_map();
-    uint32_t idx = tile * 4 + block;
+    local_mem_->refresh_topology();
     
-    uint32_t addr_i = adc_map[idx].addr_I;
-    uint32_t addr_q = adc_map[idx].addr_Q;
+    std::cout << "\n";
+    lock_wait::print_stats(std::cout);
     
-    if (addr_i == 0xFFFFFFFF || addr_q == 0xFFFFFFFF) {
-        throw std::runtime_error("Invalid ADC I/Q BRAM addresses");
+    uint32_t timeouts = 0;
+    for (const auto& s : lock_wait::stats()) {
+        timeouts += s.timeouts;
+    }
+    if (timeouts == 0) {
+        std::cout << "\n  ✓ All locks acquired\n\n";
+    } else {
+        std::cout << "\n  ✗ " << timeouts << " lock waits timed out\n\n";
     }
+}
 
-    // Read I channel from addr_I
-    std::cout << "    Reading I channel (addr=0x" << std::hex << addr_i << std::dec << ")...\n";
-    std::vector<uint8_t> raw_i;
+void RfDcApp::run_rfdc_monitor_test()
+{
+    std::cout << "━━━ Running RFDC Monitor Test ━━━\n";
+    std::cout << "  ADC Tile 0 Block 0 captures tagged clean/corrupted by converter events\n\n";
     
-    void* bram_i = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE,
-                        MAP_SHARED, info_.fd, addr_i);
-    if (bram_i == MAP_FAILED) {
-        perror("mmap ADC I");
-        throw std::runtime_error("Failed to mmap ADC I channel");
+    if (!monitor_ || !monitor_->running()) {
+        std::cout << "  ✗ Monitor not running\n\n";
+        return;
     }
     
-    raw_i.resize(size_bytes);
-    std::memcpy(raw_i.data(), bram_i, size_bytes);
-    munmap(bram_i, size_bytes);
-    std::cout << "    ✓ Read I channel (" << size_bytes << " bytes)\n";
-
-    // Read Q channel from addr_Q
-    std::cout << "    Reading Q channel (addr=0x" << std::hex << addr_q << std::dec << ")...\n";
-    std::vector<uint8_t> raw_q;
-    
-    void* bram_q = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE,
-                        MAP_SHARED, info_.fd, addr_q);
-    if (bram_q == MAP_FAILED) {
-        perror("mmap ADC Q");
-        throw std::runtime_error("Failed to mmap ADC Q channel");
+    const uint32_t tile = 0;
+    const uint32_t block = 0;
+    const uint32_t channel = tile * 4 + block;
+    const size_t num_samples = FIFO_SIZE / sizeof(int16_t);
+    constexpr int captures = 50;
+    // On the simulated backend an over-range is latched before these captures
+    const int inject_at[] = { 10, 11, 30 };
+    rfdc::SimRfdc* sim = rfdc_->simulator();
+    
+    uint32_t corrupted = 0;
+    for (int n = 0; n < captures; ++n) {
+        if (sim && std::find(std::begin(inject_at), std::end(inject_at), n) != std::end(inject_at)) {
+            sim->raise_interrupts(rfdc::TileType::ADC, tile, block, XRFDC_ADC_OVR_RANGE_MASK);
+        }
+        auto caps = capture_adc_channels(1u << channel, num_samples, nullptr, false);
+        const rfdc_monitor::Verdict& verdict = caps.front().verdict;
+        if (!verdict.clean) {
+            corrupted++;
+            std::cout << "    • Capture " << n << ": " << verdict.summary << "\n";
+        }
     }
     
-    raw_q.resize(size_bytes);
-    std::memcpy(raw_q.data(), bram_q, size_bytes);
-    munmap(bram_q, size_bytes);
-    std::cout << "    ✓ Read Q channel (" << size_bytes << " bytes)\n";
-
-    // ------------------------------------------------------------
-    // 5) Decode I samples (2 int16 per 32-bit word)
-    // ------------------------------------------------------------
-    const int16_t* i_ptr = reinterpret_cast<const int16_t*>(raw_i.data());
-    const size_t total_i_samples = raw_i.size() / sizeof(int16_t);
+    std::cout << "\n  " << (captures - corrupted) << " clean, " << corrupted << " corrupted\n";
+    std::cout << "\n  Monitor counters:\n";
+    monitor_->print(std::cout);
     
-    captured.I.reserve(num_samples);
-    for (size_t i = 0; i < total_i_samples && captured.I.size() < num_samples; ++i) {
-        captured.I.push_back(i_ptr[i]);
+    // Idle: let the thread run a few passes on its own
+    const auto before = monitor_->snapshot();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto after = monitor_->snapshot();
+    std::cout << "  Background passes in 200 ms: " << (after.sweeps - before.sweeps) << "\n";
+    
+    // Per-capture tagging cost: two snapshots and one sweep of the channel
+    constexpr int reps = 1000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int n = 0; n < reps; ++n) {
+        rfdc_monitor::Snapshot snap = monitor_->snapshot();
+        (void)snap;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int n = 0; n < reps; ++n) {
+        monitor_->sweep(rfdc::TileType::ADC, 1u << channel);
     }
+    auto t2 = std::chrono::steady_clock::now();
+    stream_format::Restore restore(std::cout);
+    std::cout << std::fixed << std::setprecision(2)
+              << "  snapshot " << std::chrono::duration<double, std::micro>(t1 - t0).count() / reps
+              << " us, sweep " << std::chrono::duration<double, std::micro>(t2 - t1).count() / reps
+              << " us\n";
+    
+    if (sim) {
+        const uint32_t expected = sizeof(inject_at) / sizeof(inject_at[0]);
+        std::cout << "  " << (corrupted == expected ? "✓" : "✗") << " Expected "
+                  << expected << " corrupted captures\n";
+    }
+    std::cout << "\n";
+}
 
-    // ------------------------------------------------------------
-    // 6) Decode Q samples (2 int16 per 32-bit word)
-    // ------------------------------------------------------------
-    const int16_t* q_ptr = reinterpret_cast<const int16_t*>(raw_q.data());
-    const size_t total_q_samples = raw_q.size() / sizeof(int16_t);
+void RfDcApp::run_mts_test()
+{
+    std::cout << "━━━ Running Multi-Tile Sync Test ━━━\n";
+    std::cout << "  Free-running sync, targeted repeats, a target too low, state file round trip\n\n";
+    
+    MonitorPause pause(monitor_.get());
+    bool pass = true;
+    
+    // Free-running: every tile delayed to the slowest
+    mts::Options options;
+    mts::Report first = mts::run(*rfdc_, options);
+    mts::print_report(first, std::cout);
+    if (!first.ok()) {
+        std::cout << "  ✗ Sync failed\n\n";
+        return;
+    }
     
-    captured.Q.reserve(num_samples);
-    for (size_t i = 0; i < total_q_samples && captured.Q.size() < num_samples; ++i) {
-        captured.Q.push_back(q_ptr[i]);
+    // Target a few T1 above the slowest tile and repeat: the latency must not move
+    auto target_of = [](const mts::TypeResult& r) {
+        int latency = -1;
+        for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+            if (r.tiles & (1u << tile)) {
+                latency = std::max(latency, r.latency[tile]);
+            }
+        }
+        return latency < 0 ? -1 : latency + 8;
+    };
+    options.adc_target_latency = target_of(first.adc);
+    options.dac_target_latency = target_of(first.dac);
+    std::cout << "\n  Targets: DAC " << options.dac_target_latency
+              << ", ADC " << options.adc_target_latency << "\n";
+    
+    constexpr int repeats = 5;
+    mts::Report report;
+    std::chrono::nanoseconds total{0};
+    for (int n = 0; n < repeats; ++n) {
+        report = mts::run(*rfdc_, options);
+        total += report.time;
+        for (const mts::TypeResult* r : { &report.dac, &report.adc }) {
+            for (rfdc::TileId tile = 0; tile < 4; ++tile) {
+                if (!(r->tiles & (1u << tile))) {
+                    continue;
+                }
+                if (!r->ok() || r->latency[tile] != r->target_latency) {
+                    std::cout << "    • Run " << n << ": " << (r->type == rfdc::TileType::ADC ? "ADC " : "DAC ")
+                              << tile << " latency " << r->latency[tile] << " ("
+                              << mts::status_string(r->status) << ")\n";
+                    pass = false;
+                }
+            }
+        }
     }
+    stream_format::Restore restore(std::cout);
+    std::cout << "  " << (pass ? "✓" : "✗") << " " << repeats
+              << " targeted runs, all tiles at target, mean " << std::fixed << std::setprecision(2)
+              << std::chrono::duration<double, std::milli>(total).count() / repeats << " ms\n";
+    
+    // A target no tile can make must be refused, not silently missed
+    mts::Options low = options;
+    low.adc_target_latency = 0;
+    low.dac_target_latency = 0;
+    mts::Report refused = mts::run(*rfdc_, low);
+    const bool target_low = (refused.dac.tiles == 0 || (refused.dac.status & XRFDC_MTS_TARGET_LOW)) &&
+                            (refused.adc.tiles == 0 || (refused.adc.status & XRFDC_MTS_TARGET_LOW));
+    std::cout << "  " << (target_low ? "✓" : "✗") << " Target 0 refused (DAC: "
+              << mts::status_string(refused.dac.status) << ", ADC: "
+              << mts::status_string(refused.adc.status) << ")\n";
+    pass = pass && target_low;
+    
+    // Leave the tiles aligned, then check what a restart would see
+    report = mts::run(*rfdc_, options);
+    const std::string path = "/tmp/rfdc_mts_test.txt";
+    mts::Report loaded;
+    std::ostringstream diff;
+    const bool round_trip = report.ok() && mts::save(path, report) && mts::load(path, loaded) &&
+                            mts::matches(loaded, report, diff) &&
+                            mts::targets_from(loaded, mts::Options()).adc_target_latency ==
+                                options.adc_target_latency;
+    std::cout << "  " << (round_trip ? "✓" : "✗") << " State file round trip (" << path << ")\n"
+              << diff.str();
+    pass = pass && round_trip;
+    std::remove(path.c_str());
+    
+    std::cout << "\n  " << (pass ? "✓ Multi-tile sync test passed" : "✗ Multi-tile sync test failed")
+              << "\n\n";
+}
 
-    captured.is_iq = true;
+void RfDcApp::run_getter_cost_benchmark()
+{
+    std::cout << "━━━ Getter Cost Benchmark ━━━\n";
+    std::cout << "  Per-call cost of the status getters polled by lock waits and the monitor\n\n";
+    
+    MonitorPause pause(monitor_.get());
+    constexpr int iterations = 100000;
+    const rfdc::TileType type = rfdc::TileType::ADC;
+    const rfdc::TileId tile = 0;
+    const rfdc::BlockId block = 0;
+    const rfdc::TileId bad_tile = 7;
+    volatile uint64_t sink = 0;     // Volatile stores keep the calls from being optimized out
+    
+    auto time_ns = [](int n, auto body) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            body();
+        }
+        return std::chrono::duration<double, std::nano>(
+                   std::chrono::steady_clock::now() - t0).count() / n;
+    };
+    auto row = [](const char* name, double ns) {
+        stream_format::Restore restore(std::cout);
+        std::cout << "    " << std::left << std::setw(44) << name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(10) << ns << " ns\n";
+    };
     
-    std::cout << "  ✓ Read " << captured.I.size() << " I samples and " 
-              << captured.Q.size() << " Q samples\n";
-
-    return captured;
+    std::cout << "  Successful calls:\n";
+    row("get_pll_lock_status", time_ns(iterations, [&] {
+        sink += rfdc_->get_pll_lock_status(type, tile);
+    }));
+    row("try_get_pll_lock_status", time_ns(iterations, [&] {
+        sink += rfdc_->try_get_pll_lock_status(type, tile).value;
+    }));
+    // What every check used to cost on top: the message built before the call
+    row("get_pll_lock_status + eager message", time_ns(iterations, [&] {
+        const std::string msg = format_msg("GetPLLLockStatus tile ", tile);
+        sink += msg.size() + rfdc_->get_pll_lock_status(type, tile);
+    }));
+    row("get_interrupt_status", time_ns(iterations, [&] {
+        sink += rfdc_->get_interrupt_status(type, tile, block);
+    }));
+    row("try_get_interrupt_status", time_ns(iterations, [&] {
+        sink += rfdc_->try_get_interrupt_status(type, tile, block).value;
+    }));
+    row("get_fifo_status", time_ns(iterations, [&] {
+        sink += rfdc_->get_fifo_status(type, tile);
+    }));
+    row("get_mixer_settings (cached)", time_ns(iterations, [&] {
+        sink += rfdc_->get_mixer_settings(type, tile, block).coarse_mix_freq();
+    }));
+    
+    // Failures: the throwing getter pays for the message and the unwind
+    constexpr int failing = 10000;
+    std::cout << "\n  Failing calls (tile " << bad_tile << "):\n";
+    row("get_pll_lock_status (throws)", time_ns(failing, [&] {
+        try {
+            sink += rfdc_->get_pll_lock_status(type, bad_tile);
+        } catch (const rfdc::RFDCException&) {
+            ++sink;
+        }
+    }));
+    row("try_get_pll_lock_status", time_ns(failing, [&] {
+        const auto lock = rfdc_->try_get_pll_lock_status(type, bad_tile);
+        sink += lock.ok() ? lock.value : 1;
+    }));
+    std::cout << "\n";
 }
 
-
-
 void RfDcApp::run_string_loopback_test() 
 {
     std::cout << "━━━ Running String Loopback Test ━━━\n";
@@ -2699,7 +4873,7 @@ void RfDcApp::run_string_loopback_test()
         
         set_local_mem_sample(rfdc::TileType::ADC, tile, block, num_samples);
         local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, channel_mask);
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        wait_for_capture(rfdc::TileType::ADC, tile, channel_mask);
         
         auto captured = read_adc_samples_i_q(tile, block, num_samples);
         std::cout << "  ✓ Captured " << captured.I.size() << " samples\n";
@@ -2888,12 +5062,14 @@ void RfDcApp::run_string_loopback_test()
         auto dac_pll = rfdc_->get_pll_config(rfdc::TileType::DAC, tile);
         auto adc_pll = rfdc_->get_pll_config(rfdc::TileType::ADC, tile);
         
-        save_samples_to_csv(tx_samples, dac_pll.sample_rate() * 1e9, 
-                           "string_tx.csv", "# TX\n");
-        save_samples_to_csv(captured.I, adc_pll.sample_rate() * 1e9,
-                           "string_rx.csv", "# RX\n");
+        auto tx_info = capture_metadata(rfdc::TileType::DAC, tile, block, dac_pll.sample_rate() * 1e9);
+        tx_info.notes = "# TX\n";
+        auto rx_info = capture_metadata(rfdc::TileType::ADC, tile, block, adc_pll.sample_rate() * 1e9);
+        rx_info.notes = "# RX\n";
+        auto tx_file = save_capture("string_tx", tx_samples, {}, tx_info);
+        auto rx_file = save_capture("string_rx", captured.I, {}, rx_info);
         
-        std::cout << "\n  Files: string_tx.csv, string_rx.csv, constellation.csv\n";
+        std::cout << "\n  Files: " << tx_file << ", " << rx_file << ", constellation.csv\n";
         
     } catch (const std::exception& e) {
         std::cerr << "\n✗ Error: " << e.what() << "\n";
@@ -2933,7 +5109,7 @@ void RfDcApp::run_simple_pattern_test()
     // ADC
     set_local_mem_sample(rfdc::TileType::ADC, tile, block, num_samples);
     local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, channel_mask);
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    wait_for_capture(rfdc::TileType::ADC, tile, channel_mask);
     
     auto captured = read_adc_samples_i_q(tile, block, num_samples);
     
@@ -2975,8 +5151,12 @@ void RfDcApp::run_simple_pattern_test()
     }
     std::cout << "\n";
     
-    save_samples_to_csv(pattern, 1e9, "pattern_tx.csv", "# TX pattern\n");
-    save_samples_to_csv(captured.I, 1e9, "pattern_rx.csv", "# RX pattern\n");
+    auto tx_info = capture_metadata(rfdc::TileType::DAC, tile, block, 1e9);
+    tx_info.notes = "# TX pattern\n";
+    auto rx_info = capture_metadata(rfdc::TileType::ADC, tile, block, 1e9);
+    rx_info.notes = "# RX pattern\n";
+    save_capture("pattern_tx", pattern, {}, tx_info);
+    save_capture("pattern_rx", captured.I, {}, rx_info);
 }
 
 // ===== AMPLITUDE CALIBRATION TEST =====
@@ -3015,7 +5195,7 @@ void RfDcApp::calibrate_amplitude()
         // Receive
         set_local_mem_sample(rfdc::TileType::ADC, tile, block, num_samples);
         local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, channel_mask);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        wait_for_capture(rfdc::TileType::ADC, tile, channel_mask);
         
         auto captured = read_adc_samples_i_q(tile, block, num_samples);
         
@@ -3190,24 +5370,19 @@ void RfDcApp::write_dac_iq_samples(
     std::cout << "  Writing I/Q to DAC[" << tile << "][" 
               << i_block << "/" << q_block << "]...\n";
     
-    // Write I channel
-    const uint32_t size_bytes_i = samples.I.size() * sizeof(int16_t);
-    std::vector<uint8_t> raw_i(size_bytes_i);
-    std::memcpy(raw_i.data(), samples.I.data(), size_bytes_i);
-    
-    int ret = write_dac_bram_rftool_style(tile, i_block, size_bytes_i, raw_i);
-    if (ret != SUCCESS) {
-        throw std::runtime_error("Failed to write DAC I samples");
-    }
+    // I and Q blocks in one batch: one FIFO enable for the tile
+    DacUpload i_upload;
+    i_upload.tile = tile;
+    i_upload.block = i_block;
+    i_upload.samples = samples.I;
     
-    // Write Q channel
-    const uint32_t size_bytes_q = samples.Q.size() * sizeof(int16_t);
-    std::vector<uint8_t> raw_q(size_bytes_q);
-    std::memcpy(raw_q.data(), samples.Q.data(), size_bytes_q);
+    DacUpload q_upload;
+    q_upload.tile = tile;
+    q_upload.block = q_block;
+    q_upload.samples = samples.Q;
     
-    ret = write_dac_bram_rftool_style(tile, q_block, size_bytes_q, raw_q);
-    if (ret != SUCCESS) {
-        throw std::runtime_error("Failed to write DAC Q samples");
+    if (write_dac_batch({ i_upload, q_upload }) != SUCCESS) {
+        throw std::runtime_error("Failed to write DAC I/Q samples");
     }
     
     std::cout << "    ✓ Wrote " << samples.I.size() 
@@ -3223,7 +5398,19 @@ void RfDcApp::save_iq_samples_to_csv(
     const std::string& metadata
 )
 {
-    if (!samples.is_iq) {
+    save_iq_samples_to_csv(AdcCaptureView(samples), sample_rate_hz,
+                           i_filename, q_filename, metadata);
+}
+
+void RfDcApp::save_iq_samples_to_csv(
+    const AdcCaptureView& samples,
+    double sample_rate_hz,
+    const std::string& i_filename,
+    const std::string& q_filename,
+    const std::string& metadata
+)
+{
+    if (!samples.is_iq()) {
         throw std::runtime_error("Expected I/Q samples but got REAL samples");
     }
     
@@ -3347,13 +5534,11 @@ void RfDcApp::run_iq_loopback_test()
         dac_meta << "# num_samples: " << num_samples << "\n";
         dac_meta << "# amplitude: 30000\n";
         
-        save_iq_samples_to_csv(
-            iq_samples,
-            dac_pll_rate_hz / dac_interpolation,
-            "dac_i_t0_b0_50MHz.csv",
-            "dac_q_t0_b1_50MHz.csv",
-            dac_meta.str()
-        );
+        auto dac_info = capture_metadata(rfdc::TileType::DAC, tile, i_block,
+                                         dac_pll_rate_hz / dac_interpolation);
+        dac_info.q_block = static_cast<int32_t>(q_block);
+        dac_info.notes = dac_meta.str();
+        save_capture("dac_iq_t0_b0_b1_50MHz", iq_samples.I, iq_samples.Q, dac_info);
         
         std::cout << "  Step 5: **TRIGGER DAC I/Q playback**\n";
         local_mem_trigger(rfdc::TileType::DAC, tile, num_samples, channel_mask);
@@ -3376,17 +5561,15 @@ void RfDcApp::run_iq_loopback_test()
         
         std::cout << "  Step 2: **TRIGGER ADC I/Q capture**\n";
         local_mem_trigger(rfdc::TileType::ADC, tile, num_samples, channel_mask);
+        wait_for_capture(rfdc::TileType::ADC, tile, channel_mask);
         
-        std::cout << "    Waiting 200ms for capture to complete...\n";
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        
-        std::cout << "  Step 3: Reading captured I/Q data from ADC BRAM\n";
-        // Use the updated read_adc_samples_i_q which now handles I/Q mode
-        auto captured_iq = read_adc_samples_i_q(tile, i_block, num_samples);
+        std::cout << "  Step 3: Viewing captured I/Q data in ADC BRAM\n";
+        // Zero-copy view; valid until the next ADC trigger on this tile
+        auto captured_iq = capture_adc_view(tile, i_block, num_samples);
         
         std::cout << "  ✓ Captured " << captured_iq.I.size() << " I samples and " 
                   << captured_iq.Q.size() << " Q samples\n";
-        std::cout << "  ✓ Mode: " << (captured_iq.is_iq ? "I/Q" : "REAL") << "\n";
+        std::cout << "  ✓ Mode: " << (captured_iq.is_iq() ? "I/Q" : "REAL") << "\n";
         
         // Save ADC data
         std::stringstream adc_meta;
@@ -3400,13 +5583,11 @@ void RfDcApp::run_iq_loopback_test()
         adc_meta << "# baseband_frequency_mhz: " << (test_frequency / 1e6) << "\n";
         adc_meta << "# num_samples: " << num_samples << "\n";
         
-        save_iq_samples_to_csv(
-            captured_iq,
-            adc_pll_rate_hz / adc_decimation,
-            "adc_i_t0_b0_capture.csv",
-            "adc_q_t0_b1_capture.csv",
-            adc_meta.str()
-        );
+        auto adc_info = capture_metadata(rfdc::TileType::ADC, tile, i_block,
+                                         adc_pll_rate_hz / adc_decimation);
+        adc_info.q_block = static_cast<int32_t>(q_block);
+        adc_info.notes = adc_meta.str();
+        save_capture("adc_iq_t0_b0_b1_capture", captured_iq.I, captured_iq.Q, adc_info);
         
         // ===== ANALYSIS =====
         std::cout << "\n━━━ Analysis ━━━\n";
@@ -3454,7 +5635,7 @@ void RfDcApp::run_iq_loopback_test()
                   << iq_imbalance_db << " dB\n";
         
         std::cout << "\n━━━ Result ━━━\n";
-        if (captured_iq.is_iq && i_pp > 1000 && q_pp > 1000) {
+        if (captured_iq.is_iq() && i_pp > 1000 && q_pp > 1000) {
             std::cout << "  ✓✓✓ I/Q LOOPBACK SUCCESS! ✓✓✓\n";
             std::cout << "  Strong signals detected on both I and Q channels!\n";
             
@@ -3470,7 +5651,7 @@ void RfDcApp::run_iq_loopback_test()
             std::cout << "    python3 plot_iq_loopback.py \\\n";
             std::cout << "      dac_i_t0_b0_50MHz.csv dac_q_t0_b1_50MHz.csv \\\n";
             std::cout << "      adc_i_t0_b0_capture.csv adc_q_t0_b1_capture.csv\n";
-        } else if (!captured_iq.is_iq) {
+        } else if (!captured_iq.is_iq()) {
             std::cout << "  ✗ ADC NOT IN I/Q MODE!\n";
             std::cout << "  ADC detected REAL mode instead of I/Q\n";
             std::cout << "  Check mixer configuration (should be C2C)\n";
@@ -8,12 +8,27 @@
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <functional>
+#include <chrono>
+#include <mutex>
 #include "rfdc_wrapper/RfDc.hpp"
 #include "rfdc_wrapper/RfClock.hpp"
 #include "gpio.hpp"
 #include "LocalMem.hpp"
 #include "ClockWizard.hpp"
 #include "StringCodec.hpp"
+#include "BramMap.hpp"
+#include "SampleSpan.hpp"
+#include "WorkerPool.hpp"
+#include "BufferPool.hpp"
+#include "DeviceCopy.hpp"
+#include "CaptureFile.hpp"
+#include "CaptureWriter.hpp"
+#include "ShmRing.hpp"
+#include "CaptureServer.hpp"
+#include "ConverterConfig.hpp"
+#include "RfdcMonitor.hpp"
+#include "Mts.hpp"
 
 class RfDcApp
 {
@@ -28,6 +43,25 @@ public:
     // Main entry point for your RF initialization & test code
     void run();
     
+    // Bring up the hardware, then serve captures on a Unix socket until SIGINT/SIGTERM
+    void serve(const std::string& socket_path);
+    
+    // Converter setup used by bring-up: converter_config::defaults() with
+    // the file's settings on top. Call before run()/serve().
+    bool load_config(const std::string& path);
+    
+    // Run multi-tile sync at bring-up. The first run saves the latencies to
+    // `state_path`; later runs target them and fail if they cannot be met.
+    // Call before run()/serve().
+    void enable_mts(const std::string& state_path);
+    
+    // Also write a CSV next to every binary capture (default: RFDC_CSV_EXPORT=1).
+    // Call before run()/serve().
+    void enable_csv_export(bool enable = true);
+    
+    // Move the running converters to `config`, touching only what differs
+    converter_config::Report apply_config(const converter_config::Config& config);
+    
     // Public memory initialization (matching RFTool API)
     int init_mem();
     int deinit_mem();
@@ -74,14 +108,17 @@ private:
         signed char *map_adc[16];
         int fd_dac[16];
         int fd_adc[16];
+        size_t map_size_dac[16];    // Bytes mapped at map_dac[i]
+        size_t map_size_adc[16];    // Bytes mapped at map_adc[i]
         int fd;  // /dev/mem file descriptor
         unsigned int mem_type_dac;
         unsigned int mem_type_adc;
     };
     
+    // I/Q storage comes from the shared buffer pool (64-byte aligned, recycled)
     struct AdcSamples {
-        std::vector<int16_t> I;
-        std::vector<int16_t> Q;
+        buffer_pool::SampleVector I;
+        buffer_pool::SampleVector Q;
         bool is_iq = false;
 
         // Compatibility helpers
@@ -91,13 +128,103 @@ private:
         auto end() const { return I.end(); }
     };
 
+    // Non-owning capture straight over the mapped ADC BRAM window.
+    // Valid until the next trigger of that channel; snapshot() for a stable copy.
+    struct AdcCaptureView {
+        sample::SampleSpan I;
+        sample::SampleSpan Q;       // empty in REAL mode
+        size_t length = 0;
+        rfdc::DataType type = rfdc::DataType::Real;
+
+        AdcCaptureView() = default;
+        explicit AdcCaptureView(const AdcSamples& samples)
+            : I(samples.I)
+            , Q(samples.Q)
+            , length(samples.I.size())
+            , type(samples.is_iq ? rfdc::DataType::IQ : rfdc::DataType::Real)
+        {}
+
+        bool is_iq() const { return type == rfdc::DataType::IQ; }
+        size_t size() const { return length; }
+        AdcSamples snapshot() const;
+    };
+
+    // One chunk of a DDR streaming capture, viewed in place in the plmem map
+    struct StreamChunk {
+        sample::SampleSpan samples;     // Raw int16 stream (I/Q interleaved in IQ mode)
+        size_t offset = 0;              // Index of the first sample in the capture
+        size_t index = 0;               // Chunk number
+        bool last = false;
+    };
+    // Return false to stop streaming early
+    using StreamConsumer = std::function<bool(const StreamChunk&)>;
+
+    struct StreamStats {
+        size_t samples = 0;             // int16 values delivered
+        size_t chunks = 0;
+        double capture_ms = 0.0;
+        double stream_ms = 0.0;
+        bool completed = false;
+    };
+
+    // Result of waiting for a triggered data-mover transfer
+    struct CaptureCompletion {
+        bool completed = false;
+        std::chrono::microseconds latency{0};   // Trigger → completion seen
+        const char* method = "none";            // "poll" (plmem fd) or "register"
+    };
+
+    // One channel of a simultaneous multi-channel capture
+    struct ChannelCapture {
+        uint32_t tile = 0;
+        uint32_t block = 0;
+        AdcSamples samples;
+        rfdc_monitor::Verdict verdict;  // Converter events during the capture
+
+        uint32_t channel() const { return tile * 4 + block; }
+    };
+
+    struct MultiCaptureStats {
+        uint32_t channels = 0;
+        size_t bytes = 0;               // Total bytes copied out of BRAM
+        double trigger_ms = 0.0;        // Setup + trigger + completion wait
+        double readout_ms = 0.0;
+        
+        double readout_mb_per_s() const {
+            return readout_ms > 0.0 ? bytes / (readout_ms * 1e3) : 0.0;
+        }
+    };
+
+    // One DAC channel waveform for a batch upload
+    struct DacUpload {
+        uint32_t tile = 0;
+        uint32_t block = 0;
+        sample::SampleSpan samples;
+    };
+
+    // DAC playback + ADC capture fired together (LocalMem::trigger_loopback)
+    struct LoopbackCapture {
+        AdcSamples samples;
+        local_mem::LocalMem::LoopbackTiming timing;
+        CaptureCompletion completion;
+        int64_t offset = -1;            // Waveform samples from DAC start to ADC sample 0
+        double correlation = 0.0;       // Normalized peak behind offset (0..1)
+        rfdc_monitor::Verdict verdict;  // Converter events during the capture
+    };
+
     RfSocInfo info_;
+    bool csv_export_ = false;           // Also write CSV next to binary captures
+    bool plmem_poll_supported_ = false;
+    std::chrono::steady_clock::time_point last_trigger_adc_;
+    std::chrono::steady_clock::time_point last_trigger_dac_;
     
-    // Memory size constants
+    // Memory size constants (plmem windows, used when the device reports no size)
     static constexpr size_t DAC_MAP_SZ = (1024 * 1024 * 1024) / 8;  // 128MB
     static constexpr size_t ADC_MAP_SZ = (1024 * 1024 * 1024) / 8;  // 128MB
     static constexpr size_t FIFO_SIZE = 16 * 1024 * 2;
     static constexpr size_t ADC_DAC_SZ_ALIGNMENT = 32;
+    static constexpr const char* CAPTURE_RING_NAME = "/rfdc_capture";
+    static constexpr uint32_t CAPTURE_RING_SLOTS = 64;
     
     std::string name_;
     
@@ -106,15 +233,27 @@ private:
     std::unique_ptr<rfdc::RFDC> rfdc_;
     std::unique_ptr<local_mem::LocalMem> local_mem_; 
     std::unique_ptr<clock_wizard::ClockWizard> clock_wiz_;
+    std::unique_ptr<bram_map::BramMap> bram_map_;
+    std::unique_ptr<worker_pool::WorkerPool> workers_;  // Created on first use
+    std::unique_ptr<capture_writer::CaptureWriter> recorder_;  // Created on first use
+    shm_ring::Writer capture_ring_;     // ADC captures (BRAM and DDR stream), for other processes
+    std::mutex capture_mutex_;          // Serializes captures from server clients
+    converter_config::Config config_ = converter_config::defaults();
+    std::unique_ptr<converter_config::Applier> config_applier_;    // Created at bring-up
+    std::unique_ptr<rfdc_monitor::Monitor> monitor_;                // Started at bring-up
+    std::string mts_state_path_;        // Empty: no multi-tile sync
+    mts::Report mts_report_;            // Last sync, if any
+    bool mts_synced_ = false;
     
     // Initialization methods
+    void bring_up();
     void initialize_clocks();
     void initialize_rfdc();
     void initialize_memory_mapping();
-    void initialize_mmcm_adc();
-    void initialize_mmcm_dac();
-    void configure_dac_tiles();
-    void configure_adc_tiles();
+    void configure_converters();
+    void sync_tiles();
+    void start_monitor();
+    void connect_sim_loopback();        // Simulated backend only
     void verify_configuration();
     
     // GPIO methods
@@ -149,6 +288,9 @@ private:
     );
     std::vector<int16_t> read_adc_samples_pure_real(uint32_t tile, uint32_t block,
                                                size_t num_samples);
+    // Persistent BRAM window lookup (channel = tile * 4 + block)
+    const bram_map::ChannelWindow* bram_window(rfdc::TileType type, uint32_t channel) const;
+    
     // FIFO control
     int change_fifo_stat(int fifo_id, int tile_id, int stat);
     
@@ -157,6 +299,16 @@ private:
                           uint32_t num_samples, uint32_t channel_mask);
     void set_local_mem_sample(rfdc::TileType type, uint32_t tile_id,
                              uint32_t block_id, uint32_t num_samples);
+    CaptureCompletion wait_for_capture(rfdc::TileType type, uint32_t tile_id,
+                                       uint32_t channel_mask,
+                                       std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+    // Same, for a global mask (bit n = channel n = tile * 4 + block)
+    CaptureCompletion wait_for_channels(rfdc::TileType type, uint32_t channel_mask,
+                                        std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+    // Play `waveform` on DAC[tile][block] and capture ADC[tile][block] with one
+    // combined trigger; offset assumes equal DAC/ADC fabric sample rates
+    LoopbackCapture loopback_capture(uint32_t tile, uint32_t block,
+                                     sample::SampleSpan waveform, size_t num_samples);
     
     // Helper to write to sysfs
     int write_to_file(const std::string& path, const std::string& value);
@@ -165,27 +317,82 @@ private:
     void run_loopback_test();
     void run_string_loopback_test();
     void display_status();
-    void save_samples_to_csv(const std::vector<int16_t>& samples,
+    // Binary capture + JSON sidecar (see CaptureFile.hpp), CSV if csv_export_
+    capture_file::Metadata capture_metadata(rfdc::TileType type, uint32_t tile,
+                                            uint32_t block, double sample_rate_hz);
+    std::string save_capture(const std::string& base_name,
+                             sample::SampleSpan I,
+                             sample::SampleSpan Q,
+                             const capture_file::Metadata& meta);
+    // Asynchronous recording: buffers are moved to the writer thread
+    capture_writer::CaptureWriter& recorder();
+    bool record_capture(const std::string& base_name, AdcSamples&& samples,
+                        const capture_file::Metadata& meta);
+    capture_writer::Sink csv_sink();
+    // Capture server handler: one ADC capture for a client request
+    void capture_for_client(uint32_t channel_mask,
+                            const capture_server::Request& req,
+                            capture_server::Block& out);
+    // Fill shared-memory ring slots straight from the mapped capture (no-op without readers)
+    shm_ring::FrameHeader capture_frame_header(uint32_t tile, uint32_t block);
+    void publish_capture(uint32_t tile, uint32_t block, const AdcCaptureView& view);
+    void publish_stream_chunk(const shm_ring::FrameHeader& frame, sample::SampleSpan values,
+                              bool interleaved_iq);
+    void save_samples_to_csv(sample::SampleSpan samples,
                             double sample_rate_hz,
                             const std::string& filename,
                             const std::string& metadata = "");
     void save_samples_to_csv(
-        const std::vector<int16_t>& I,
-        const std::vector<int16_t>& Q,
+        sample::SampleSpan I,
+        sample::SampleSpan Q,
         double fabric_sample_rate_hz,
         const std::string& filename,
         const std::string& metadata
     );  
     // Data transfer helper methods
     void write_dac_samples(uint32_t tile, uint32_t block,
-                          const std::vector<int16_t>& samples);
+                          sample::SampleSpan samples);
+    // Validate all entries, copy them into BRAM, enable each tile FIFO once
+    int write_dac_batch(const std::vector<DacUpload>& uploads);
     AdcSamples read_adc_samples_i_q(
         uint32_t tile,
         uint32_t block,
-        size_t num_samples
+        size_t num_samples,
+        bool verbose = true
+    );
+    AdcCaptureView capture_adc_view(
+        uint32_t tile,
+        uint32_t block,
+        size_t num_samples,
+        bool verbose = true
+    );
+    
+    // Simultaneous capture: one trigger for every channel in the mask
+    // (bit n = channel n = tile * 4 + block), then concurrent readout.
+    // Results are ordered by channel index.
+    uint32_t enabled_adc_channel_mask() const;
+    std::vector<ChannelCapture> capture_adc_channels(
+        uint32_t channel_mask,
+        size_t num_samples,
+        MultiCaptureStats* stats = nullptr,
+        bool parallel_readout = true
+    );
+    worker_pool::WorkerPool& workers();
+    
+    // DDR-backed capture, streamed to the consumer in fixed-size chunks
+    int set_adc_mem_type(uint32_t tile, uint32_t block, local_mem::LocalMem::MemType type);
+    // DDR-backed playback (plmem map) for waveforms longer than BRAM
+    int set_dac_mem_type(uint32_t tile, uint32_t block, local_mem::LocalMem::MemType type);
+    int capture_adc_ddr_stream(
+        uint32_t tile,
+        uint32_t block,
+        size_t num_samples,
+        size_t chunk_samples,
+        const StreamConsumer& consumer,
+        StreamStats* stats = nullptr
     );
     // Generate sine wave accounting for DAC interpolation
-    std::vector<int16_t> generate_sine_wave(
+    buffer_pool::SampleVector generate_sine_wave(
             double frequency_hz,
             double dac_pll_rate_hz,
             uint32_t dac_interpolation,
@@ -195,7 +402,7 @@ private:
             bool imr_lowpass_enabled
     );
 
-    std::vector<int16_t> generate_sine_wave_rf(
+    buffer_pool::SampleVector generate_sine_wave_rf(
         double rf_frequency_hz,      // RF-equivalent frequency (what user expects)
         double dac_pll_rate_hz,
         uint32_t dac_interpolation,
@@ -214,7 +421,7 @@ private:
         double noise_dbfs = -60.0
     );
 
-    std::vector<int16_t> generate_dc_offset(int16_t value, size_t num_samples);
+    buffer_pool::SampleVector generate_dc_offset(int16_t value, size_t num_samples);
 
     void update_pll_sample_rate(
         rfdc::TileType type,
@@ -228,6 +435,26 @@ private:
     void calibrate_amplitude();
     void run_simple_pattern_test();
     void run_codec_diagnostic_test();
+    void run_bram_map_benchmark();
+    void run_kernel_diagnostic_test();
+    void run_ddr_stream_capture_test();
+    void run_multi_channel_capture_test();
+    void run_dac_batch_upload_test();
+    void run_buffer_pool_test();
+    void run_device_copy_benchmark();
+    void run_capture_file_test();
+    void run_recording_test();
+    void run_shm_ring_test();
+    void run_capture_server_test();
+    void run_loopback_timing_test();
+    void run_dac_hot_swap_test();
+    void run_mmio_trace_test();
+    void run_config_cache_test();
+    void run_config_apply_test();
+    void run_lock_time_test();
+    void run_rfdc_monitor_test();
+    void run_mts_test();
+    void run_getter_cost_benchmark();
     void run_iq_loopback_test();
     void write_dac_iq_samples(
         uint32_t tile,
@@ -243,4 +470,11 @@ private:
         const std::string& q_filename,
         const std::string& metadata
     );
+    void save_iq_samples_to_csv(
+        const AdcCaptureView& samples,
+        double sample_rate_hz,
+        const std::string& i_filename,
+        const std::string& q_filename,
+        const std::string& metadata
+    );
 };
\ No newline at end of file
@@ -0,0 +1,424 @@
+#include "RfdcMonitor.hpp"
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <poll.h>
+#include <unistd.h>
+
+namespace rfdc_monitor {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t FIFO_MASK = XRFDC_IXR_FIFOUSRDAT_OF_MASK | XRFDC_IXR_FIFOUSRDAT_UF_MASK;
+constexpr uint32_t ADC_MASK = FIFO_MASK | XRFDC_ADC_OVR_RANGE_MASK | XRFDC_ADC_OVR_VOLTAGE_MASK |
+                              XRFDC_ADC_IXR_DMON_STG_MASK | XRFDC_SUBADC_IXR_DCDR_MASK;
+constexpr uint32_t DAC_MASK = FIFO_MASK | XRFDC_DAC_IXR_INTP_STG_MASK;
+
+uint32_t type_index(rfdc::TileType type)
+{
+    return type == rfdc::TileType::ADC ? 0 : 1;
+}
+
+const char* type_name(uint32_t index)
+{
+    return index == 0 ? "ADC" : "DAC";
+}
+
+// Status bits of one block → events
+void decode(rfdc::TileType type, uint32_t status, bool (&seen)[NUM_EVENTS])
+{
+    seen[FIFO_OVERFLOW] = (status & XRFDC_IXR_FIFOUSRDAT_OF_MASK) != 0;
+    seen[FIFO_UNDERFLOW] = (status & XRFDC_IXR_FIFOUSRDAT_UF_MASK) != 0;
+    if (type == rfdc::TileType::ADC) {
+        seen[OVER_RANGE] = (status & XRFDC_ADC_OVR_RANGE_MASK) != 0;
+        seen[OVER_VOLTAGE] = (status & XRFDC_ADC_OVR_VOLTAGE_MASK) != 0;
+        seen[DATAPATH_OVERFLOW] = (status & XRFDC_ADC_IXR_DMON_STG_MASK) != 0;
+        seen[SUBADC_DECODER] = (status & XRFDC_SUBADC_IXR_DCDR_MASK) != 0;
+    } else {
+        seen[OVER_RANGE] = false;
+        seen[OVER_VOLTAGE] = false;
+        seen[DATAPATH_OVERFLOW] = (status & XRFDC_DAC_IXR_INTP_STG_MASK) != 0;
+        seen[SUBADC_DECODER] = false;
+    }
+}
+
+// /dev/uioN whose sysfs name contains `name`, or -1
+int open_uio(const std::string& name)
+{
+    DIR* dir = opendir("/sys/class/uio");
+    if (!dir) {
+        return -1;
+    }
+    int fd = -1;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "uio", 3) != 0) {
+            continue;
+        }
+        std::ifstream file(std::string("/sys/class/uio/") + entry->d_name + "/name");
+        std::string uio_name;
+        if (!std::getline(file, uio_name) || uio_name.find(name) == std::string::npos) {
+            continue;
+        }
+        fd = ::open((std::string("/dev/") + entry->d_name).c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "  ⚠ RFDC monitor: cannot open /dev/" << entry->d_name << ": "
+                      << std::strerror(errno) << "\n";
+        }
+        break;
+    }
+    closedir(dir);
+    return fd;
+}
+
+} // namespace
+
+const char* event_name(Event event)
+{
+    switch (event) {
+    case FIFO_OVERFLOW:     return "fifo_overflow";
+    case FIFO_UNDERFLOW:    return "fifo_underflow";
+    case OVER_RANGE:        return "over_range";
+    case OVER_VOLTAGE:      return "over_voltage";
+    case DATAPATH_OVERFLOW: return "datapath_overflow";
+    case SUBADC_DECODER:    return "subadc_decoder";
+    default:                return "unknown";
+    }
+}
+
+// ===== Snapshot =====
+
+uint64_t Snapshot::block_total(rfdc::TileType type, rfdc::TileId tile, rfdc::BlockId block) const
+{
+    uint64_t sum = 0;
+    for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+        sum += events[type_index(type)][tile][block][e];
+    }
+    return sum;
+}
+
+uint64_t Snapshot::total() const
+{
+    uint64_t sum = 0;
+    for (uint32_t t = 0; t < 2; ++t) {
+        for (uint32_t tile = 0; tile < NUM_TILES; ++tile) {
+            sum += pll_loss[t][tile];
+            for (uint32_t block = 0; block < NUM_BLOCKS; ++block) {
+                for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+                    sum += events[t][tile][block][e];
+                }
+            }
+        }
+    }
+    return sum;
+}
+
+Verdict compare(const Snapshot& before, const Snapshot& after,
+                rfdc::TileType type, uint32_t channel_mask)
+{
+    const uint32_t t = type_index(type);
+    Verdict verdict;
+    std::ostringstream summary;
+    auto add = [&](uint64_t count, const std::string& what) {
+        if (count == 0) {
+            return;
+        }
+        summary << (verdict.events ? ", " : "") << type_name(t) << " " << what;
+        if (count > 1) {
+            summary << " x" << count;
+        }
+        verdict.events += count;
+    };
+
+    uint32_t tile_mask = 0;
+    for (uint32_t channel = 0; channel < NUM_TILES * NUM_BLOCKS; ++channel) {
+        if (!(channel_mask & (1u << channel))) {
+            continue;
+        }
+        const uint32_t tile = channel / NUM_BLOCKS;
+        const uint32_t block = channel % NUM_BLOCKS;
+        tile_mask |= 1u << tile;
+        for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+            add(after.events[t][tile][block][e] - before.events[t][tile][block][e],
+                std::to_string(tile) + "/" + std::to_string(block) + " " +
+                event_name(static_cast<Event>(e)));
+        }
+    }
+    for (uint32_t tile = 0; tile < NUM_TILES; ++tile) {
+        if (tile_mask & (1u << tile)) {
+            add(after.pll_loss[t][tile] - before.pll_loss[t][tile],
+                std::to_string(tile) + " pll_loss");
+        }
+    }
+
+    verdict.clean = (verdict.events == 0);
+    verdict.summary = summary.str();
+    return verdict;
+}
+
+// ===== Monitor =====
+
+Monitor::Monitor(rfdc::RFDC& rfdc)
+    : Monitor(rfdc, Options())
+{
+}
+
+Monitor::Monitor(rfdc::RFDC& rfdc, const Options& options)
+    : rfdc_(rfdc)
+    , options_(options)
+{
+    for (uint32_t t = 0; t < 2; ++t) {
+        for (uint32_t tile = 0; tile < NUM_TILES; ++tile) {
+            pll_loss_[t][tile].store(0);
+            for (uint32_t block = 0; block < NUM_BLOCKS; ++block) {
+                for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+                    events_[t][tile][block][e].store(0);
+                }
+            }
+        }
+    }
+}
+
+Monitor::~Monitor()
+{
+    stop();
+}
+
+bool Monitor::start()
+{
+    if (running()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(service_mutex_);
+    sources_.clear();
+    tiles_.clear();
+    for (rfdc::TileType type : { rfdc::TileType::ADC, rfdc::TileType::DAC }) {
+        const uint32_t mask = (type == rfdc::TileType::ADC) ? ADC_MASK : DAC_MASK;
+        for (rfdc::TileId tile = 0; tile < NUM_TILES; ++tile) {
+            if (!rfdc_.check_tile_enabled(type, tile)) {
+                continue;
+            }
+            tiles_.emplace_back(type, tile);
+            pll_locked_[type_index(type)][tile] = rfdc_.get_pll_lock_status(type, tile);
+            for (rfdc::BlockId block = 0; block < NUM_BLOCKS; ++block) {
+                if (!rfdc_.check_block_enabled(type, tile, block)) {
+                    continue;
+                }
+                // Whatever latched before now belongs to nobody's capture
+                rfdc_.clear_interrupts(type, tile, block, mask);
+                rfdc_.enable_interrupts(type, tile, block, mask);
+                sources_.push_back(Source{ type, tile, block, mask });
+            }
+        }
+    }
+
+    if (!rfdc_.simulated()) {
+        uio_fd_ = open_uio(options_.uio_name);
+    }
+    stop_.store(false);
+    thread_ = std::thread(&Monitor::run, this);
+    return true;
+}
+
+void Monitor::stop()
+{
+    if (!running()) {
+        return;
+    }
+    stop_.store(true);
+    thread_.join();
+
+    std::lock_guard<std::mutex> lock(service_mutex_);
+    for (const Source& source : sources_) {
+        try {
+            rfdc_.disable_interrupts(source.type, source.tile, source.block, source.mask);
+        } catch (const std::exception& e) {
+            std::cerr << "  ⚠ RFDC monitor: " << e.what() << "\n";
+        }
+    }
+    if (uio_fd_ >= 0) {
+        ::close(uio_fd_);
+        uio_fd_ = -1;
+    }
+}
+
+void Monitor::run()
+{
+    const uint32_t unmask = 1;
+    const int timeout_ms = static_cast<int>(options_.poll_interval.count());
+    Clock::time_point last_rearm = Clock::now();
+    if (uio_fd_ >= 0) {
+        ::write(uio_fd_, &unmask, sizeof(unmask));
+    }
+
+    while (!stop_.load()) {
+        bool irq = false;
+        if (uio_fd_ >= 0) {
+            pollfd pfd = { uio_fd_, POLLIN, 0 };
+            if (::poll(&pfd, 1, timeout_ms) > 0 && (pfd.revents & POLLIN)) {
+                uint32_t count = 0;
+                irq = (::read(uio_fd_, &count, sizeof(count)) == sizeof(count));
+            }
+        } else {
+            std::this_thread::sleep_for(options_.poll_interval);
+        }
+        if (stop_.load()) {
+            break;
+        }
+        if (irq) {
+            interrupts_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(service_mutex_);
+            service_all();
+        }
+
+        if (irq) {
+            // A condition that keeps re-latching must not keep this thread spinning
+            const Clock::time_point next = last_rearm + options_.min_rearm;
+            if (Clock::now() < next) {
+                std::this_thread::sleep_until(next);
+            }
+            last_rearm = Clock::now();
+            ::write(uio_fd_, &unmask, sizeof(unmask));
+        }
+    }
+}
+
+void Monitor::service_block(const Source& source)
+{
+    // Every pass reads every block: no exception or message on this path
+    const auto pending = rfdc_.try_get_interrupt_status(source.type, source.tile, source.block);
+    if (!pending.ok()) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const uint32_t status = pending.value & source.mask;
+    if (!status) {
+        return;
+    }
+    try {
+        rfdc_.clear_interrupts(source.type, source.tile, source.block, status);
+    } catch (const std::exception&) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    bool seen[NUM_EVENTS];
+    decode(source.type, status, seen);
+    auto& counters = events_[type_index(source.type)][source.tile][source.block];
+    for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+        if (seen[e]) {
+            counters[e].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Monitor::service_pll(rfdc::TileType type, rfdc::TileId tile)
+{
+    const auto lock = rfdc_.try_get_pll_lock_status(type, tile);
+    if (!lock.ok()) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const bool locked = lock.value;
+    bool& was_locked = pll_locked_[type_index(type)][tile];
+    if (was_locked && !locked) {
+        pll_loss_[type_index(type)][tile].fetch_add(1, std::memory_order_relaxed);
+    }
+    was_locked = locked;
+}
+
+void Monitor::service_all()
+{
+    for (const Source& source : sources_) {
+        service_block(source);
+    }
+    for (const auto& t : tiles_) {
+        service_pll(t.first, t.second);
+    }
+    sweeps_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Monitor::sweep(rfdc::TileType type, uint32_t channel_mask)
+{
+    std::lock_guard<std::mutex> lock(service_mutex_);
+    uint32_t tile_mask = 0;
+    for (const Source& source : sources_) {
+        if (source.type == type && (channel_mask & (1u << (source.tile * NUM_BLOCKS + source.block)))) {
+            service_block(source);
+            tile_mask |= 1u << source.tile;
+        }
+    }
+    for (const auto& t : tiles_) {
+        if (t.first == type && (tile_mask & (1u << t.second))) {
+            service_pll(t.first, t.second);
+        }
+    }
+    sweeps_.fetch_add(1, std::memory_order_relaxed);
+}
+
+Snapshot Monitor::snapshot() const
+{
+    Snapshot s;
+    for (uint32_t t = 0; t < 2; ++t) {
+        for (uint32_t tile = 0; tile < NUM_TILES; ++tile) {
+            s.pll_loss[t][tile] = pll_loss_[t][tile].load(std::memory_order_relaxed);
+            for (uint32_t block = 0; block < NUM_BLOCKS; ++block) {
+                for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+                    s.events[t][tile][block][e] =
+                        events_[t][tile][block][e].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    s.interrupts = interrupts_.load(std::memory_order_relaxed);
+    s.sweeps = sweeps_.load(std::memory_order_relaxed);
+    s.errors = errors_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Monitor::print(std::ostream& os) const
+{
+    const Snapshot s = snapshot();
+    bool any = false;
+    for (uint32_t t = 0; t < 2; ++t) {
+        for (uint32_t tile = 0; tile < NUM_TILES; ++tile) {
+            if (s.pll_loss[t][tile]) {
+                os << "    • " << type_name(t) << " " << tile << "    pll_loss "
+                   << s.pll_loss[t][tile] << "\n";
+                any = true;
+            }
+            for (uint32_t block = 0; block < NUM_BLOCKS; ++block) {
+                std::ostringstream line;
+                for (uint32_t e = 0; e < NUM_EVENTS; ++e) {
+                    if (s.events[t][tile][block][e]) {
+                        line << "  " << event_name(static_cast<Event>(e)) << " "
+                             << s.events[t][tile][block][e];
+                    }
+                }
+                if (!line.str().empty()) {
+                    os << "    • " << type_name(t) << " " << tile << "/" << block << line.str() << "\n";
+                    any = true;
+                }
+            }
+        }
+    }
+    if (!any) {
+        os << "    • No converter events\n";
+    }
+    os << "    " << s.interrupts << " interrupts, " << s.sweeps << " status passes";
+    if (s.errors) {
+        os << ", " << s.errors << " driver errors";
+    }
+    os << (interrupt_driven() ? " (UIO interrupt)" : " (polled)") << "\n";
+}
+
+} // namespace rfdc_monitor
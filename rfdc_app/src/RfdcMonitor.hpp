@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rfdc_wrapper/RfDc.hpp"
+
+namespace rfdc_monitor {
+
+constexpr uint32_t NUM_TILES = 4;
+constexpr uint32_t NUM_BLOCKS = 4;
+
+/**
+ * @brief Converter events counted per block
+ */
+enum Event : uint32_t {
+    FIFO_OVERFLOW = 0,
+    FIFO_UNDERFLOW,
+    OVER_RANGE,             // ADC only
+    OVER_VOLTAGE,           // ADC only
+    DATAPATH_OVERFLOW,      // Decimation / interpolation stage
+    SUBADC_DECODER,         // ADC only
+    NUM_EVENTS
+};
+
+const char* event_name(Event event);
+
+/**
+ * @brief Counter values at one instant
+ *
+ * Indexed [type][tile][block][event] with type 0 = ADC, 1 = DAC. PLL loss
+ * is per tile: a locked → unlocked transition seen by the monitor.
+ */
+struct Snapshot {
+    uint64_t events[2][NUM_TILES][NUM_BLOCKS][NUM_EVENTS] = {};
+    uint64_t pll_loss[2][NUM_TILES] = {};
+    uint64_t interrupts = 0;        // UIO interrupts taken
+    uint64_t sweeps = 0;            // Status passes (interrupt, timer or sweep())
+    uint64_t errors = 0;            // Driver calls that failed in a pass
+
+    uint64_t block_total(rfdc::TileType type, rfdc::TileId tile, rfdc::BlockId block) const;
+    uint64_t total() const;
+};
+
+/**
+ * @brief Whether a capture overlapped any converter event
+ */
+struct Verdict {
+    bool clean = true;
+    uint64_t events = 0;
+    std::string summary;            // e.g. "ADC 0/1 over_range x2, ADC 0 pll_loss"; empty if clean
+};
+
+/**
+ * @brief Events on `channel_mask` (bit n = tile * 4 + block) and their
+ *        tiles' PLLs between two snapshots
+ */
+Verdict compare(const Snapshot& before, const Snapshot& after,
+                rfdc::TileType type, uint32_t channel_mask);
+
+/**
+ * @brief Background RFDC interrupt monitor
+ *
+ * start() enables the FIFO, over-range/voltage, datapath overflow and
+ * sub-ADC decoder interrupts on every enabled block, then a thread waits on
+ * the RFDC UIO device. Each interrupt, and every `poll_interval` whether or
+ * not one came, the thread reads, counts and clears the status of every
+ * block and checks each tile's PLL lock. Without a UIO device (or on the
+ * simulated backend) the timer alone drives it.
+ *
+ * A counter counts passes that found its status bit latched, not samples.
+ * Counters are relaxed atomics written only under the service lock, so
+ * snapshot() is a plain copy with no driver call. A capture takes a
+ * snapshot before its trigger, calls sweep() for its channels once the
+ * data is in (so events not yet serviced are not missed), and compares.
+ *
+ * The thread only touches interrupt and PLL lock status registers. Stop
+ * the monitor around anything that restarts tiles, or the restart counts
+ * as PLL loss.
+ */
+class Monitor {
+public:
+    struct Options {
+        std::string uio_name = "rf_data_converter";     // Matched in /sys/class/uio/uio*/name
+        std::chrono::milliseconds poll_interval{50};    // Fallback pass, also the stop latency
+        std::chrono::microseconds min_rearm{1000};      // Interrupt storm guard
+    };
+
+    explicit Monitor(rfdc::RFDC& rfdc);
+    Monitor(rfdc::RFDC& rfdc, const Options& options);
+    ~Monitor();
+
+    Monitor(const Monitor&) = delete;
+    Monitor& operator=(const Monitor&) = delete;
+
+    /**
+     * @brief Enable interrupts on the enabled blocks, drop stale status,
+     *        start the thread
+     * @return false if already running
+     */
+    bool start();
+
+    /**
+     * @brief Stop the thread and disable the interrupts it enabled
+     */
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+    bool interrupt_driven() const { return uio_fd_ >= 0; }
+
+    /**
+     * @brief Service `channel_mask` blocks of `type` and their tiles' PLLs
+     *        now, on the calling thread
+     */
+    void sweep(rfdc::TileType type, uint32_t channel_mask);
+
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Blocks and tiles with non-zero counters, then pass totals
+     */
+    void print(std::ostream& os) const;
+
+private:
+    struct Source {
+        rfdc::TileType type;
+        rfdc::TileId tile;
+        rfdc::BlockId block;
+        uint32_t mask;
+    };
+
+    rfdc::RFDC& rfdc_;
+    Options options_;
+    std::vector<Source> sources_;
+    std::vector<std::pair<rfdc::TileType, rfdc::TileId>> tiles_;
+    bool pll_locked_[2][NUM_TILES] = {};    // Last seen; guarded by service_mutex_
+
+    std::atomic<uint64_t> events_[2][NUM_TILES][NUM_BLOCKS][NUM_EVENTS];
+    std::atomic<uint64_t> pll_loss_[2][NUM_TILES];
+    std::atomic<uint64_t> interrupts_{0};
+    std::atomic<uint64_t> sweeps_{0};
+    std::atomic<uint64_t> errors_{0};
+
+    std::mutex service_mutex_;              // Thread pass vs sweep()
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+    int uio_fd_ = -1;
+
+    void run();
+    // Caller holds service_mutex_
+    void service_block(const Source& source);
+    void service_pll(rfdc::TileType type, rfdc::TileId tile);
+    void service_all();
+};
+
+} // namespace rfdc_monitor
@@ -0,0 +1,157 @@
+#include "SampleKernels.hpp"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define KERNELS_USE_NEON 1
+#else
+#define KERNELS_USE_NEON 0
+#endif
+
+namespace kernels {
+
+// ===== Scalar Reference Kernels =====
+
+namespace scalar {
+
+void extract_real_low_half(const uint32_t* words, int16_t* out, size_t num_words)
+{
+    for (size_t n = 0; n < num_words; ++n) {
+        out[n] = static_cast<int16_t>(words[n] & 0xFFFF);
+    }
+}
+
+void unpack_pairs(const uint32_t* words, int16_t* out, size_t num_words)
+{
+    for (size_t n = 0; n < num_words; ++n) {
+        uint32_t w = words[n];
+        out[n * 2]     = static_cast<int16_t>(w & 0xFFFF);
+        out[n * 2 + 1] = static_cast<int16_t>((w >> 16) & 0xFFFF);
+    }
+}
+
+void merge_iq(const int16_t* i, const int16_t* q, int16_t* iq_out, size_t num_samples)
+{
+    for (size_t n = 0; n < num_samples; ++n) {
+        iq_out[n * 2]     = i[n];
+        iq_out[n * 2 + 1] = q[n];
+    }
+}
+
+void pack_pairs(const int16_t* samples, size_t num_samples, uint32_t* words)
+{
+    const size_t pairs = num_samples / 2;
+    for (size_t n = 0; n < pairs; ++n) {
+        words[n] = (static_cast<uint16_t>(samples[n * 2])) |
+                   (static_cast<uint32_t>(static_cast<uint16_t>(samples[n * 2 + 1])) << 16);
+    }
+    if (num_samples & 1) {
+        words[pairs] = static_cast<uint16_t>(samples[num_samples - 1]);
+    }
+}
+
+} // namespace scalar
+
+// ===== NEON Kernels =====
+
+#if KERNELS_USE_NEON
+
+void extract_real_low_half(const uint32_t* words, int16_t* out, size_t num_words)
+{
+    const int16_t* src = reinterpret_cast<const int16_t*>(words);
+    size_t n = 0;
+
+    // 8 words per iteration: de-interleave halves, keep the low ones
+    for (; n + 8 <= num_words; n += 8) {
+        int16x8x2_t v = vld2q_s16(src + n * 2);
+        vst1q_s16(out + n, v.val[0]);
+    }
+    scalar::extract_real_low_half(words + n, out + n, num_words - n);
+}
+
+void unpack_pairs(const uint32_t* words, int16_t* out, size_t num_words)
+{
+    // Little-endian words already hold the samples in output order
+    const int16_t* src = reinterpret_cast<const int16_t*>(words);
+    const size_t total = num_words * 2;
+    size_t n = 0;
+
+    for (; n + 32 <= total; n += 32) {
+        int16x8_t a = vld1q_s16(src + n);
+        int16x8_t b = vld1q_s16(src + n + 8);
+        int16x8_t c = vld1q_s16(src + n + 16);
+        int16x8_t d = vld1q_s16(src + n + 24);
+        vst1q_s16(out + n, a);
+        vst1q_s16(out + n + 8, b);
+        vst1q_s16(out + n + 16, c);
+        vst1q_s16(out + n + 24, d);
+    }
+    scalar::unpack_pairs(words + n / 2, out + n, num_words - n / 2);
+}
+
+void merge_iq(const int16_t* i, const int16_t* q, int16_t* iq_out, size_t num_samples)
+{
+    size_t n = 0;
+
+    for (; n + 8 <= num_samples; n += 8) {
+        int16x8x2_t v;
+        v.val[0] = vld1q_s16(i + n);
+        v.val[1] = vld1q_s16(q + n);
+        vst2q_s16(iq_out + n * 2, v);
+    }
+    scalar::merge_iq(i + n, q + n, iq_out + n * 2, num_samples - n);
+}
+
+void pack_pairs(const int16_t* samples, size_t num_samples, uint32_t* words)
+{
+    int16_t* dst = reinterpret_cast<int16_t*>(words);
+    const size_t even = num_samples & ~static_cast<size_t>(1);
+    size_t n = 0;
+
+    for (; n + 32 <= even; n += 32) {
+        int16x8_t a = vld1q_s16(samples + n);
+        int16x8_t b = vld1q_s16(samples + n + 8);
+        int16x8_t c = vld1q_s16(samples + n + 16);
+        int16x8_t d = vld1q_s16(samples + n + 24);
+        vst1q_s16(dst + n, a);
+        vst1q_s16(dst + n + 8, b);
+        vst1q_s16(dst + n + 16, c);
+        vst1q_s16(dst + n + 24, d);
+    }
+    scalar::pack_pairs(samples + n, num_samples - n, words + n / 2);
+}
+
+const char* implementation()
+{
+    return "NEON";
+}
+
+#else
+
+void extract_real_low_half(const uint32_t* words, int16_t* out, size_t num_words)
+{
+    scalar::extract_real_low_half(words, out, num_words);
+}
+
+void unpack_pairs(const uint32_t* words, int16_t* out, size_t num_words)
+{
+    scalar::unpack_pairs(words, out, num_words);
+}
+
+void merge_iq(const int16_t* i, const int16_t* q, int16_t* iq_out, size_t num_samples)
+{
+    scalar::merge_iq(i, q, iq_out, num_samples);
+}
+
+void pack_pairs(const int16_t* samples, size_t num_samples, uint32_t* words)
+{
+    scalar::pack_pairs(samples, num_samples, words);
+}
+
+const char* implementation()
+{
+    return "scalar";
+}
+
+#endif
+
+} // namespace kernels
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace kernels {
+
+/**
+ * @brief Sample (un)packing kernels for the BRAM word formats
+ *
+ * BRAM words are 32 bits wide and little-endian. REAL ADC captures keep one
+ * sample in the low half of each word; IQ lanes and DAC playback pack two
+ * consecutive samples per word (first sample in the low half).
+ *
+ * The top-level functions use AArch64 NEON when the compiler targets it and
+ * fall back to the portable versions in kernels::scalar otherwise. Pointers
+ * to device memory must be at least 4-byte aligned.
+ */
+
+/**
+ * @brief Take the low 16 bits of each word (REAL capture format)
+ * @param words Source words
+ * @param out Destination, num_words samples
+ * @param num_words Number of source words
+ */
+void extract_real_low_half(const uint32_t* words, int16_t* out, size_t num_words);
+
+/**
+ * @brief Split each word into two samples, low half first
+ * @param words Source words
+ * @param out Destination, 2 * num_words samples
+ * @param num_words Number of source words
+ */
+void unpack_pairs(const uint32_t* words, int16_t* out, size_t num_words);
+
+/**
+ * @brief Interleave separate I and Q lanes into I0,Q0,I1,Q1,...
+ * @param i I lane
+ * @param q Q lane
+ * @param iq_out Destination, 2 * num_samples values
+ * @param num_samples Samples per lane
+ */
+void merge_iq(const int16_t* i, const int16_t* q, int16_t* iq_out, size_t num_samples);
+
+/**
+ * @brief Pack consecutive sample pairs into words (DAC playback format)
+ *
+ * An odd trailing sample is written with a zero high half.
+ *
+ * @param samples Source samples
+ * @param num_samples Number of source samples
+ * @param words Destination, (num_samples + 1) / 2 words
+ */
+void pack_pairs(const int16_t* samples, size_t num_samples, uint32_t* words);
+
+/**
+ * @brief Name of the active implementation ("NEON" or "scalar")
+ */
+const char* implementation();
+
+/**
+ * @brief Reference implementations, always available
+ */
+namespace scalar {
+void extract_real_low_half(const uint32_t* words, int16_t* out, size_t num_words);
+void unpack_pairs(const uint32_t* words, int16_t* out, size_t num_words);
+void merge_iq(const int16_t* i, const int16_t* q, int16_t* iq_out, size_t num_samples);
+void pack_pairs(const int16_t* samples, size_t num_samples, uint32_t* words);
+} // namespace scalar
+
+} // namespace kernels
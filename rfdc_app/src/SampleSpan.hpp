@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sample {
+
+/**
+ * @brief Non-owning, read-only view over contiguous int16 samples
+ *
+ * Lets analysis and export code take samples from a std::vector or straight
+ * from a mapped BRAM window without copying. The viewed memory must stay
+ * valid (and, for BRAM, untouched by a new capture) while the span is used.
+ */
+class SampleSpan {
+public:
+    SampleSpan() = default;
+
+    SampleSpan(const int16_t* data, size_t size)
+        : data_(data)
+        , size_(size)
+    {}
+
+    /**
+     * @brief Implicit view over any contiguous container of int16_t
+     */
+    template <typename Container,
+              typename = typename std::enable_if<std::is_convertible<
+                  decltype(std::declval<const Container&>().data()),
+                  const int16_t*>::value>::type>
+    SampleSpan(const Container& c)
+        : data_(c.data())
+        , size_(c.size())
+    {}
+
+    const int16_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    int16_t operator[](size_t i) const { return data_[i]; }
+    const int16_t* begin() const { return data_; }
+    const int16_t* end() const { return data_ + size_; }
+
+    /**
+     * @brief View of [offset, offset + count), clamped to the span
+     */
+    SampleSpan subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const
+    {
+        if (offset > size_) {
+            offset = size_;
+        }
+        if (count > size_ - offset) {
+            count = size_ - offset;
+        }
+        return SampleSpan(data_ + offset, count);
+    }
+
+    /**
+     * @brief Copy the viewed samples into an owning vector
+     */
+    std::vector<int16_t> to_vector() const
+    {
+        return std::vector<int16_t>(begin(), end());
+    }
+
+private:
+    const int16_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace sample
@@ -0,0 +1,305 @@
+#include "ShmRing.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace shm_ring {
+
+namespace {
+
+constexpr size_t PAGE = 4096;
+
+size_t round_page(size_t bytes)
+{
+    return (bytes + PAGE - 1) & ~(PAGE - 1);
+}
+
+// Shared (not PRIVATE) futex ops: waiters live in other processes
+int futex_wait(const std::atomic<uint32_t>* addr, uint32_t expected, const struct timespec* timeout)
+{
+    return static_cast<int>(syscall(SYS_futex, reinterpret_cast<const uint32_t*>(addr),
+                                    FUTEX_WAIT, expected, timeout, nullptr, 0));
+}
+
+void futex_wake_all(std::atomic<uint32_t>* addr)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+// ===== Writer =====
+
+Writer::~Writer()
+{
+    close();
+}
+
+bool Writer::create(const std::string& name, uint32_t slot_count, size_t payload_bytes)
+{
+    close();
+    if (slot_count == 0 || payload_bytes == 0) {
+        std::cerr << "Invalid shared-memory ring geometry\n";
+        return false;
+    }
+
+    const size_t stride = round_page(sizeof(SlotHeader) + payload_bytes);
+    const size_t total = PAGE + stride * slot_count;
+
+    shm_unlink(name.c_str());   // Start clean; old readers keep their mapping
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        perror(("shm_open " + name).c_str());
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        perror("ftruncate shm ring");
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        perror("mmap shm ring");
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // Fresh pages are zeroed; construct the atomics in place
+    ring_ = new (base) RingHeader();
+    ring_->slot_count = slot_count;
+    ring_->slot_stride = stride;
+    ring_->payload_bytes = payload_bytes;
+    ring_->write_seq.store(0);
+    ring_->futex_word.store(0);
+    ring_->waiters.store(0);
+    ring_->readers.store(0);
+    for (uint32_t s = 0; s < slot_count; ++s) {
+        new (static_cast<uint8_t*>(base) + PAGE + s * stride) SlotHeader();
+    }
+    ring_->version = VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    ring_->magic = MAGIC;       // Readers check this last
+
+    name_ = name;
+    map_bytes_ = total;
+    return true;
+}
+
+void Writer::close()
+{
+    if (ring_) {
+        munmap(ring_, map_bytes_);
+        shm_unlink(name_.c_str());
+    }
+    ring_ = nullptr;
+    map_bytes_ = 0;
+    pending_ = nullptr;
+}
+
+int16_t* Writer::begin(uint32_t lanes, uint32_t num_samples)
+{
+    if (!ring_ || lanes == 0 || lanes > 2 ||
+        static_cast<uint64_t>(lanes) * num_samples * sizeof(int16_t) > ring_->payload_bytes) {
+        return nullptr;
+    }
+
+    pending_seq_ = ring_->write_seq.load(std::memory_order_relaxed);
+    pending_ = reinterpret_cast<SlotHeader*>(
+        reinterpret_cast<uint8_t*>(ring_) + PAGE + (pending_seq_ % ring_->slot_count) * ring_->slot_stride);
+    pending_lanes_ = lanes;
+    pending_samples_ = num_samples;
+
+    // Odd stamp: readers of the frame previously in this slot will notice
+    pending_->stamp.store(2 * pending_seq_ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    return reinterpret_cast<int16_t*>(pending_ + 1);
+}
+
+uint64_t Writer::commit(const FrameHeader& frame)
+{
+    if (!pending_) {
+        return 0;
+    }
+
+    pending_->frame = frame;
+    pending_->frame.seq = pending_seq_;
+    pending_->frame.lanes = pending_lanes_;
+    pending_->frame.num_samples = pending_samples_;
+
+    pending_->stamp.store(2 * pending_seq_ + 2, std::memory_order_release);
+    ring_->write_seq.store(pending_seq_ + 1, std::memory_order_release);
+
+    ring_->futex_word.fetch_add(1, std::memory_order_release);
+    if (ring_->waiters.load(std::memory_order_acquire) != 0) {
+        futex_wake_all(&ring_->futex_word);
+    }
+
+    pending_ = nullptr;
+    return pending_seq_;
+}
+
+// ===== Reader =====
+
+Reader::~Reader()
+{
+    close();
+}
+
+bool Reader::open(const std::string& name)
+{
+    close();
+
+    // Read-write so the reader can register itself as a futex waiter
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        perror(("shm_open " + name).c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < PAGE) {
+        std::cerr << "Shared-memory ring " << name << " is not initialized\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* base = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        perror("mmap shm ring");
+        return false;
+    }
+
+    const RingHeader* ring = static_cast<const RingHeader*>(base);
+    if (ring->magic != MAGIC || ring->version != VERSION ||
+        PAGE + ring->slot_stride * ring->slot_count > static_cast<size_t>(st.st_size)) {
+        std::cerr << "Shared-memory ring " << name << " has an unknown layout\n";
+        munmap(base, st.st_size);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    ring_ = ring;
+    map_bytes_ = st.st_size;
+    const_cast<RingHeader*>(ring_)->readers.fetch_add(1, std::memory_order_acq_rel);
+    next_seq_ = ring_->write_seq.load(std::memory_order_acquire);
+    lost_ = 0;
+    return true;
+}
+
+void Reader::close()
+{
+    if (ring_) {
+        const_cast<RingHeader*>(ring_)->readers.fetch_sub(1, std::memory_order_acq_rel);
+        munmap(const_cast<RingHeader*>(ring_), map_bytes_);
+    }
+    ring_ = nullptr;
+    map_bytes_ = 0;
+}
+
+void Reader::seek_oldest()
+{
+    if (!ring_) {
+        return;
+    }
+    uint64_t head = ring_->write_seq.load(std::memory_order_acquire);
+    next_seq_ = head > ring_->slot_count ? head - ring_->slot_count : 0;
+}
+
+const SlotHeader* Reader::slot(uint64_t seq) const
+{
+    return reinterpret_cast<const SlotHeader*>(
+        reinterpret_cast<const uint8_t*>(ring_) + PAGE + (seq % ring_->slot_count) * ring_->slot_stride);
+}
+
+bool Reader::wait_for(uint64_t seq, std::chrono::milliseconds timeout)
+{
+    auto* ring = const_cast<RingHeader*>(ring_);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    for (;;) {
+        uint32_t word = ring->futex_word.load(std::memory_order_acquire);
+        if (ring->write_seq.load(std::memory_order_acquire) > seq) {
+            return true;
+        }
+
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero()) {
+            return false;
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000);
+
+        ring->waiters.fetch_add(1, std::memory_order_acq_rel);
+        futex_wait(&ring->futex_word, word, &ts);
+        ring->waiters.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+Reader::Status Reader::next(FrameHeader& frame,
+                            buffer_pool::SampleVector& I,
+                            buffer_pool::SampleVector& Q,
+                            std::chrono::milliseconds timeout)
+{
+    if (!ring_) {
+        return Status::Closed;
+    }
+
+    for (;;) {
+        if (!wait_for(next_seq_, timeout)) {
+            return Status::Timeout;
+        }
+
+        // Fell behind by more than the ring: skip to the oldest frame left
+        uint64_t head = ring_->write_seq.load(std::memory_order_acquire);
+        if (head - next_seq_ > ring_->slot_count) {
+            uint64_t oldest = head - ring_->slot_count;
+            lost_ += oldest - next_seq_;
+            next_seq_ = oldest;
+        }
+
+        const SlotHeader* s = slot(next_seq_);
+        const uint64_t committed = 2 * next_seq_ + 2;
+        if (s->stamp.load(std::memory_order_acquire) != committed) {
+            lost_++;
+            next_seq_++;
+            continue;
+        }
+
+        frame = s->frame;
+        const int16_t* payload = reinterpret_cast<const int16_t*>(s + 1);
+        const size_t n = frame.num_samples;
+        I.assign(payload, payload + n);
+        if (frame.lanes == 2) {
+            Q.assign(payload + n, payload + 2 * n);
+        } else {
+            Q.clear();
+        }
+
+        // Producer lapped us during the copy: discard
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s->stamp.load(std::memory_order_relaxed) != committed) {
+            lost_++;
+            next_seq_++;
+            continue;
+        }
+
+        next_seq_++;
+        return Status::Ok;
+    }
+}
+
+} // namespace shm_ring
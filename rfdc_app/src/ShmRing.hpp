@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "BufferPool.hpp"
+
+namespace shm_ring {
+
+/**
+ * @brief POSIX shared-memory capture ring (one producer, any number of readers)
+ *
+ * Layout of /dev/shm/<name>:
+ *   [RingHeader, one page][slot 0][slot 1]...[slot N-1]
+ * Each slot is a SlotHeader followed by the payload: num_samples I values,
+ * then num_samples Q values for I/Q captures (planar int16).
+ *
+ * The producer never waits for readers. Frame seq lives in slot seq % N;
+ * each slot carries a stamp (2*seq+1 while being written, 2*seq+2 once
+ * committed) so a reader can tell a frame it copied was not overwritten
+ * mid-read. Readers that fall more than N frames behind lose the oldest
+ * frames and are told how many. Readers block on a futex in the ring
+ * header, so they wake as soon as a frame is committed.
+ *
+ * Attached readers are counted in the header so the producer can skip
+ * filling frames nobody will read (a reader that dies without close()
+ * stays counted until the ring is recreated).
+ */
+
+constexpr uint32_t MAGIC = 0x52464452;     // "RFDR"
+constexpr uint32_t VERSION = 2;
+
+struct FrameHeader {
+    uint64_t seq = 0;
+    uint64_t timestamp_ns = 0;          // Unix time of the capture
+    double sample_rate_hz = 0.0;
+    double nco_freq_mhz = 0.0;
+    uint32_t type = 0;                  // 0 = ADC, 1 = DAC
+    uint32_t tile = 0;
+    uint32_t block = 0;
+    int32_t q_block = -1;
+    uint32_t num_samples = 0;           // Per lane
+    uint32_t lanes = 1;                 // 1 = REAL, 2 = I/Q (planar)
+    char mixer_mode[24] = {};
+};
+
+struct RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t reserved;
+    uint64_t slot_stride;               // Bytes between slot starts
+    uint64_t payload_bytes;             // Payload capacity per slot
+    alignas(64) std::atomic<uint64_t> write_seq;    // Next sequence number
+    alignas(64) std::atomic<uint32_t> futex_word;   // Bumped on every commit
+    std::atomic<uint32_t> waiters;
+    std::atomic<uint32_t> readers;      // Attached Reader objects
+};
+
+struct SlotHeader {
+    alignas(64) std::atomic<uint64_t> stamp;
+    FrameHeader frame;
+};
+
+/**
+ * @brief Producer side (one per ring)
+ */
+class Writer {
+public:
+    Writer() = default;
+    ~Writer();
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /**
+     * @brief Create (or replace) the ring
+     * @param name Shared-memory name, e.g. "/rfdc_capture"
+     * @param slot_count Frames kept in the ring
+     * @param payload_bytes Payload capacity per frame
+     * @return true on success
+     */
+    bool create(const std::string& name, uint32_t slot_count, size_t payload_bytes);
+
+    /**
+     * @brief Unmap and unlink the ring
+     */
+    void close();
+
+    /**
+     * @brief Claim the next slot and return its payload for in-place filling
+     * @param lanes 1 (REAL) or 2 (I/Q)
+     * @param num_samples Samples per lane
+     * @return Payload (I lane first), or nullptr if it doesn't fit
+     */
+    int16_t* begin(uint32_t lanes, uint32_t num_samples);
+
+    /**
+     * @brief Publish the slot claimed by begin()
+     * @param frame Header; seq, lanes and num_samples are filled in here
+     * @return Sequence number of the published frame
+     */
+    uint64_t commit(const FrameHeader& frame);
+
+    bool is_open() const { return ring_ != nullptr; }
+    size_t payload_bytes() const { return ring_ ? ring_->payload_bytes : 0; }
+    uint64_t published() const { return ring_ ? ring_->write_seq.load() : 0; }
+    bool has_readers() const { return ring_ && ring_->readers.load(std::memory_order_acquire) != 0; }
+
+private:
+    std::string name_;
+    RingHeader* ring_ = nullptr;
+    size_t map_bytes_ = 0;
+    SlotHeader* pending_ = nullptr;
+    uint64_t pending_seq_ = 0;
+    uint32_t pending_lanes_ = 0;
+    uint32_t pending_samples_ = 0;
+};
+
+/**
+ * @brief Consumer side (any number, any process)
+ */
+class Reader {
+public:
+    enum class Status {
+        Ok,
+        Timeout,
+        Closed          // Ring not open
+    };
+
+    Reader() = default;
+    ~Reader();
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    /**
+     * @brief Attach to an existing ring, positioned at the next new frame
+     * @return true on success
+     */
+    bool open(const std::string& name);
+    void close();
+
+    /**
+     * @brief Move the cursor to the oldest frame still in the ring
+     */
+    void seek_oldest();
+
+    /**
+     * @brief Copy out the next frame, waiting for it if necessary
+     *
+     * Frames overwritten before they could be read are skipped and counted
+     * in lost(); the next available frame is returned instead.
+     *
+     * @param frame Header of the returned frame
+     * @param I I (or REAL) samples
+     * @param Q Q samples (cleared for REAL frames)
+     * @param timeout Maximum wait for a new frame
+     */
+    Status next(FrameHeader& frame,
+                buffer_pool::SampleVector& I,
+                buffer_pool::SampleVector& Q,
+                std::chrono::milliseconds timeout);
+
+    bool is_open() const { return ring_ != nullptr; }
+    uint64_t position() const { return next_seq_; }
+    uint64_t lost() const { return lost_; }
+
+private:
+    const RingHeader* ring_ = nullptr;
+    size_t map_bytes_ = 0;
+    uint64_t next_seq_ = 0;
+    uint64_t lost_ = 0;
+
+    const SlotHeader* slot(uint64_t seq) const;
+    bool wait_for(uint64_t seq, std::chrono::milliseconds timeout);
+};
+
+} // namespace shm_ring
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ios>
+
+namespace stream_format {
+
+/**
+ * @brief Puts a stream's flags and precision back when it goes out of scope
+ *
+ * Report printers switch std::cout to std::fixed with a short precision;
+ * clearing `fixed` alone would leave the precision behind for every
+ * default-formatted double printed later.
+ */
+class Restore {
+public:
+    explicit Restore(std::ios_base& stream)
+        : stream_(stream), flags_(stream.flags()), precision_(stream.precision())
+    {
+    }
+    ~Restore()
+    {
+        stream_.flags(flags_);
+        stream_.precision(precision_);
+    }
+
+    Restore(const Restore&) = delete;
+    Restore& operator=(const Restore&) = delete;
+
+private:
+    std::ios_base& stream_;
+    std::ios_base::fmtflags flags_;
+    std::streamsize precision_;
+};
+
+} // namespace stream_format
@@ -73,6 +73,16 @@ void StringCodec::encode(const std::string& message,
               << samples_I.size() << " samples\n";
 }
 
+void StringCodec::encode(const std::string& message,
+                        buffer_pool::SampleVector& samples_I,
+                        buffer_pool::SampleVector& samples_Q)
+{
+    // Modulators append to std::vector; scratch keeps its capacity between calls
+    encode(message, scratch_I_, scratch_Q_);
+    samples_I.assign(scratch_I_.begin(), scratch_I_.end());
+    samples_Q.assign(scratch_Q_.begin(), scratch_Q_.end());
+}
+
 std::vector<int16_t> StringCodec::encode_real(const std::string& message)
 {
     if (config_.modulation != ModulationType::BPSK) {
@@ -86,8 +96,8 @@ std::vector<int16_t> StringCodec::encode_real(const std::string& message)
 
 // ===== Public Decoding Functions =====
 
-bool StringCodec::decode(const std::vector<int16_t>& samples_I,
-                        const std::vector<int16_t>& samples_Q,
+bool StringCodec::decode(sample::SampleSpan samples_I,
+                        sample::SampleSpan samples_Q,
                         std::string& decoded)
 {
     decoded.clear();
@@ -97,8 +107,8 @@ bool StringCodec::decode(const std::vector<int16_t>& samples_I,
     }
     
     // Create working copies
-    std::vector<int16_t> work_I = samples_I;
-    std::vector<int16_t> work_Q = samples_Q;
+    std::vector<int16_t> work_I = samples_I.to_vector();
+    std::vector<int16_t> work_Q = samples_Q.to_vector();
     
     // Detect preamble if enabled
     if (config_.use_preamble) {
@@ -168,11 +178,10 @@ bool StringCodec::decode(const std::vector<int16_t>& samples_I,
     return true;
 }
 
-bool StringCodec::decode_real(const std::vector<int16_t>& samples,
+bool StringCodec::decode_real(sample::SampleSpan samples,
                              std::string& decoded)
 {
-    std::vector<int16_t> empty_Q;
-    return decode(samples, empty_Q, decoded);
+    return decode(samples, sample::SampleSpan(), decoded);
 }
 
 // ===== BPSK Encoding/Decoding =====
@@ -852,8 +861,8 @@ uint32_t StringCodec::get_bits_per_symbol() const
     }
 }
 
-void StringCodec::analyze_signal(const std::vector<int16_t>& samples_I,
-                                const std::vector<int16_t>& samples_Q)
+void StringCodec::analyze_signal(sample::SampleSpan samples_I,
+                                sample::SampleSpan samples_Q)
 {
     std::cout << "\n━━━ Signal Analysis ━━━\n";
     if (samples_I.empty()) {
@@ -866,8 +875,8 @@ void StringCodec::analyze_signal(const std::vector<int16_t>& samples_I,
     std::cout << "  P-P: " << (*minmax.second - *minmax.first) << "\n";
 }
 
-void StringCodec::save_constellation(const std::vector<int16_t>& samples_I,
-                                    const std::vector<int16_t>& samples_Q,
+void StringCodec::save_constellation(sample::SampleSpan samples_I,
+                                    sample::SampleSpan samples_Q,
                                     const std::string& filename)
 {
     std::ofstream file(filename);
@@ -908,7 +917,7 @@ void StringCodec::debug_bit_alignment(const std::vector<int16_t>& symbols,
     }
 }
 
-uint32_t StringCodec::find_optimal_phase(const std::vector<int16_t>& samples)
+uint32_t StringCodec::find_optimal_phase(sample::SampleSpan samples)
 {
     if (samples.size() < config_.samples_per_symbol * 4) {
         return config_.samples_per_symbol / 2; // Default to center
@@ -963,7 +972,7 @@ uint32_t StringCodec::find_optimal_phase(const std::vector<int16_t>& samples)
     return best_phase;
 }
 
-std::vector<int16_t> StringCodec::downsample_symbols(const std::vector<int16_t>& samples)
+std::vector<int16_t> StringCodec::downsample_symbols(sample::SampleSpan samples)
 {
     std::vector<int16_t> symbols;
     
@@ -5,6 +5,8 @@
 #include <string>
 #include <cstdint>
 #include <random>
+#include "SampleSpan.hpp"
+#include "BufferPool.hpp"
 
 namespace codec {
 
@@ -64,6 +66,21 @@ public:
                 std::vector<int16_t>& samples_I,
                 std::vector<int16_t>& samples_Q);
     
+    /**
+     * @brief Encode string into pooled sample buffers
+     * 
+     * Same output as encode() above; intended for loops that re-encode
+     * continuously, since neither the codec nor the outputs reallocate
+     * once warmed up.
+     * 
+     * @param message Input string to encode
+     * @param samples_I Output I channel samples
+     * @param samples_Q Output Q channel samples (empty for BPSK)
+     */
+    void encode(const std::string& message,
+                buffer_pool::SampleVector& samples_I,
+                buffer_pool::SampleVector& samples_Q);
+    
     /**
      * @brief Encode string to real samples (BPSK only)
      * @param message Input string to encode
@@ -76,22 +93,22 @@ public:
     
     /**
      * @brief Decode I/Q samples to string
-     * @param samples_I I channel samples
+     * @param samples_I I channel samples (vector or capture view)
      * @param samples_Q Q channel samples (empty for BPSK)
      * @param decoded Output decoded string
      * @return true if decode successful, false otherwise
      */
-    bool decode(const std::vector<int16_t>& samples_I,
-                const std::vector<int16_t>& samples_Q,
+    bool decode(sample::SampleSpan samples_I,
+                sample::SampleSpan samples_Q,
                 std::string& decoded);
     
     /**
      * @brief Decode real samples to string (BPSK only)
-     * @param samples Input real samples
+     * @param samples Input real samples (vector or capture view)
      * @param decoded Output decoded string
      * @return true if decode successful, false otherwise
      */
-    bool decode_real(const std::vector<int16_t>& samples,
+    bool decode_real(sample::SampleSpan samples,
                      std::string& decoded);
     
     // ===== Utility Functions =====
@@ -114,8 +131,8 @@ public:
      * @param samples_I I channel samples
      * @param samples_Q Q channel samples
      */
-    void analyze_signal(const std::vector<int16_t>& samples_I,
-                       const std::vector<int16_t>& samples_Q);
+    void analyze_signal(sample::SampleSpan samples_I,
+                       sample::SampleSpan samples_Q);
     
     /**
      * @brief Save constellation diagram to CSV
@@ -123,8 +140,8 @@ public:
      * @param samples_Q Q channel samples
      * @param filename Output CSV filename
      */
-    void save_constellation(const std::vector<int16_t>& samples_I,
-                           const std::vector<int16_t>& samples_Q,
+    void save_constellation(sample::SampleSpan samples_I,
+                           sample::SampleSpan samples_Q,
                            const std::string& filename);
     
     /**
@@ -139,6 +156,10 @@ private:
     // ===== Configuration =====
     Config config_;
     
+    // Reused modulator output for the pooled encode()
+    std::vector<int16_t> scratch_I_;
+    std::vector<int16_t> scratch_Q_;
+    
     // ===== Modulation-Specific Encoding =====
     void encode_bpsk(const std::vector<uint8_t>& bytes,
                      std::vector<int16_t>& samples);
@@ -219,12 +240,12 @@ private:
      * @brief Downsample oversampled signal to symbol rate
      * Uses timing recovery to find optimal sampling phase
      */
-    std::vector<int16_t> downsample_symbols(const std::vector<int16_t>& samples);
+    std::vector<int16_t> downsample_symbols(sample::SampleSpan samples);
     
     /**
      * @brief Find optimal sampling phase (returns phase offset 0..samples_per_symbol-1)
      */
-    uint32_t find_optimal_phase(const std::vector<int16_t>& samples);
+    uint32_t find_optimal_phase(sample::SampleSpan samples);
 };
 
 } // namespace codec
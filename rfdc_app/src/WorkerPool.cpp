@@ -0,0 +1,98 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+
+namespace worker_pool {
+
+WorkerPool::WorkerPool(size_t num_threads)
+{
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(num_threads);
+    for (size_t n = 0; n < num_threads; ++n) {
+        workers_.emplace_back(&WorkerPool::worker_loop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+
+    for (auto& t : workers_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void WorkerPool::parallel_for(size_t count, const std::function<void(size_t)>& task)
+{
+    if (count == 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_ = 0;
+    finished_ = 0;
+    error_ = nullptr;
+    generation_++;
+    work_cv_.notify_all();
+
+    done_cv_.wait(lock, [this] { return finished_ == count_; });
+
+    task_ = nullptr;
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    lock.unlock();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::worker_loop()
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+        work_cv_.wait(lock, [this, seen] {
+            return stop_ || (task_ && generation_ != seen && next_ < count_);
+        });
+        if (stop_) {
+            return;
+        }
+
+        // Drain indices of the current job
+        while (task_ && next_ < count_) {
+            size_t index = next_++;
+            const auto* task = task_;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try {
+                (*task)(index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (error && !error_) {
+                error_ = error;
+            }
+            if (++finished_ == count_) {
+                done_cv_.notify_one();
+            }
+        }
+        seen = generation_;
+    }
+}
+
+} // namespace worker_pool
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace worker_pool {
+
+/**
+ * @brief Fixed set of worker threads for fan-out/fan-in jobs
+ *
+ * Threads are started once and parked between jobs, so per-channel work
+ * (BRAM readout, waveform upload) can be spread over cores without paying
+ * thread creation on every capture. Only one job runs at a time.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Start the workers
+     * @param num_threads Worker count (0 = hardware concurrency)
+     */
+    explicit WorkerPool(size_t num_threads = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Run task(0) .. task(count - 1) on the workers and wait for all
+     *
+     * Indices are handed out dynamically, so uneven tasks balance out.
+     * Exceptions thrown by a task are caught; the first one is rethrown
+     * here once every index has finished.
+     *
+     * @param count Number of task indices
+     * @param task Callable invoked once per index
+     */
+    void parallel_for(size_t count, const std::function<void(size_t)>& task);
+
+    size_t size() const { return workers_.size(); }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+
+    // Current job (guarded by mutex_)
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t count_ = 0;
+    size_t next_ = 0;
+    size_t finished_ = 0;
+    uint64_t generation_ = 0;
+    std::exception_ptr error_;
+    bool stop_ = false;
+
+    void worker_loop();
+};
+
+} // namespace worker_pool
@@ -1,4 +1,5 @@
 #include "gpio.hpp"
+#include "HwBackend.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -90,27 +91,11 @@ std::string Gpio::get_gpio_path(const std::string& attribute) const {
 }
 
 bool Gpio::write_to_sysfs(const std::string& path, const std::string& value) {
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    file << value;
-    file.close();
-    
-    return !file.fail();
+    return hw_backend::active().write_attr(path, value);
 }
 
 bool Gpio::read_from_sysfs(const std::string& path, std::string& value) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    std::getline(file, value);
-    file.close();
-    
-    return !file.fail();
+    return hw_backend::active().read_attr(path, value);
 }
 
 } // namespace gpio
\ No newline at end of file
@@ -8,25 +8,94 @@
  * - DAC configuration
  * - ADC configuration
  * - Loopback testing
+ *
+ * Usage:
+ *   rfdc_app.elf [app name]            Bring-up and tests
+ *   rfdc_app.elf --serve [socket]      Bring-up, then serve captures on a
+ *                                      Unix socket (default /tmp/rfdc_capture.sock)
+ *   rfdc_app.elf --sim [...]           Any of the above on the simulated
+ *                                      backend (same as RFDC_BACKEND=sim)
+ *                                      A host build (cmake -DRFDC_HOST_SIM=ON)
+ *                                      uses the simulated backend by default
+ *   rfdc_app.elf [--sim] --config <file> [...]
+ *                                      Converter setup from a config file
+ *                                      (see ConverterConfig.hpp)
+ *   rfdc_app.elf [--sim] --csv [...]   Also write a CSV next to every binary
+ *                                      capture (same as RFDC_CSV_EXPORT=1)
+ *   rfdc_app.elf [--sim] [--config <file>] --mts <file> [...]
+ *                                      Multi-tile sync at bring-up; the first
+ *                                      run saves the latencies to <file>,
+ *                                      later runs target and verify them
  */
 
 #include "RfdcApp.hpp"
+#include "HwBackend.hpp"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 
 int main(int argc, char* argv[]) 
 {
     // Parse command line arguments (if any)
     std::string app_name = "RF Data Converter Application";
-    if (argc > 1) {
+    bool serve = false;
+    std::string socket_path = "/tmp/rfdc_capture.sock";
+    bool sim = false;
+    if (argc > 1 && std::strcmp(argv[1], "--sim") == 0) {
+        sim = true;
+        --argc;
+        ++argv;
+    }
+    bool csv = false;
+    if (argc > 1 && std::strcmp(argv[1], "--csv") == 0) {
+        csv = true;
+        --argc;
+        ++argv;
+    }
+    std::string config_path;
+    if (argc > 2 && std::strcmp(argv[1], "--config") == 0) {
+        config_path = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    std::string mts_path;
+    if (argc > 2 && std::strcmp(argv[1], "--mts") == 0) {
+        mts_path = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--serve") == 0) {
+        serve = true;
+        if (argc > 2) {
+            socket_path = argv[2];
+        }
+    } else if (argc > 1) {
         app_name = argv[1];
     }
     
     try 
     {
+        // Backend must be chosen before anything touches the hardware
+        if (sim) {
+            hw_backend::select(hw_backend::Kind::Simulated);
+        }
+
         // Create and run the application
         RfDcApp app(app_name);
-        app.run();
+        if (csv) {
+            app.enable_csv_export();
+        }
+        if (!config_path.empty() && !app.load_config(config_path)) {
+            return EXIT_FAILURE;
+        }
+        if (!mts_path.empty()) {
+            app.enable_mts(mts_path);
+        }
+        if (serve) {
+            app.serve(socket_path);
+        } else {
+            app.run();
+        }
         
         return EXIT_SUCCESS;
         
@@ -5,6 +5,7 @@
 ******************************************************************************/
 
 #include "RfClock.hpp"
+#include "HwBackend.hpp"
 #include <sstream>
 #include <iostream>
 namespace rfdc 
@@ -20,9 +21,21 @@ namespace rfdc
         return oss.str();
     }
 
+    template<typename... Args>
+    void RFClock::throw_status(uint32_t status, const Args&... operation)
+    {
+        throw RFClockException(format_string(operation..., " failed with status: ", status),
+                               status);
+    }
+
     // Constructor implementations based on platform
     RFClock::RFClock(int gpio_id) : initialized_(false) 
     {
+        if (hw_backend::active().simulated()) {
+            simulated_ = true;
+            std::cout << "RFCLK Init Done (simulated)\n" << std::flush;
+            return;
+        }
         auto status = XRFClk_Init(gpio_id);
         check_status(status, "XRFClk_Init");
         initialized_ = true;
@@ -47,54 +60,75 @@ namespace rfdc
     }
 
     void RFClock::write_reg(RFClockChip chip, uint32_t data) {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_WriteReg(to_underlying(chip), data);
-        check_status(status, format_string("WriteReg to chip ", to_underlying(chip)));
+        check_status(status, "WriteReg to chip ", to_underlying(chip));
     }
 
     uint32_t RFClock::read_reg(RFClockChip chip) {
+        if (simulated_) {
+            return 0;
+        }
         uint32_t data = 0;
         auto status = XRFClk_ReadReg(to_underlying(chip), &data);
-        check_status(status, format_string("ReadReg from chip ", to_underlying(chip)));
+        check_status(status, "ReadReg from chip ", to_underlying(chip));
         return data;
     }
 
     void RFClock::reset_chip(RFClockChip chip) 
     {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_ResetChip(to_underlying(chip));
-        check_status(status, format_string("ResetChip ", to_underlying(chip)));
+        check_status(status, "ResetChip ", to_underlying(chip));
     }
 
     void RFClock::set_config(RFClockChip chip, uint32_t config_id) 
     {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_SetConfigOnOneChipFromConfigId(
             to_underlying(chip),
             config_id
         );
-        check_status(status, format_string("SetConfig chip ", to_underlying(chip),
-                                        " config ", config_id));
+        check_status(status, "SetConfig chip ", to_underlying(chip),
+                          " config ", config_id);
     }
 
     void RFClock::set_config_custom(RFClockChip chip, const uint32_t* config_data, 
                                     uint32_t length) {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_SetConfigOnOneChip(
             to_underlying(chip),
             const_cast<uint32_t*>(config_data),
             length
         );
-        check_status(status, format_string("SetConfigCustom chip ", to_underlying(chip)));
+        check_status(status, "SetConfigCustom chip ", to_underlying(chip));
     }
 
     void RFClock::get_config(RFClockChip chip, uint32_t* config_data) {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_GetConfigFromOneChip(
             to_underlying(chip),
             config_data
         );
-        check_status(status, format_string("GetConfig chip ", to_underlying(chip)));
+        check_status(status, "GetConfig chip ", to_underlying(chip));
     }
 
     void RFClock::set_all_configs(uint32_t lmk_config_id, uint32_t lmx1_config_id,
                                 uint32_t lmx2_config_id) 
     {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_SetConfigOnAllChipsFromConfigId(
             lmk_config_id,
             lmx1_config_id,
@@ -105,15 +139,21 @@ namespace rfdc
 
     void RFClock::control_lmk_port(LMKPort port, PortState state) 
     {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_ControlOutputPortLMK(
             to_underlying(port),
             to_underlying(state)
         );
-        check_status(status, format_string("ControlLMKPort ", to_underlying(port)));
+        check_status(status, "ControlLMKPort ", to_underlying(port));
     }
 
     void RFClock::config_lmk_output(LMKPort port, uint32_t dclk_div, uint32_t dclk_mux,
                                     uint32_t sdclk_mux, uint32_t sysref_div) {
+        if (simulated_) {
+            return;
+        }
         auto status = XRFClk_ConfigOutputDividerAndMUXOnLMK(
             to_underlying(port),
             dclk_div,
@@ -121,7 +161,7 @@ namespace rfdc
             sdclk_mux,
             sysref_div
         );
-        check_status(status, format_string("ConfigLMKOutput port ", to_underlying(port)));
+        check_status(status, "ConfigLMKOutput port ", to_underlying(port));
     }
 
     std::string RFClock::get_version() 
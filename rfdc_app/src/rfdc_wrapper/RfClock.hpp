@@ -208,17 +208,19 @@ public:
 
 private:
     bool initialized_;
+    bool simulated_ = false;    // Simulated backend: no clock chips, always stable
     
     // Helper to check status and throw on error
-    void check_status(uint32_t status, const std::string& operation) const 
+    // The message is only built on failure
+    template<typename... Args>
+    void check_status(uint32_t status, const Args&... operation) const 
     {
         if (status != XST_SUCCESS) {
-            throw RFClockException(
-                operation + " failed with status: " + std::to_string(status),
-                status
-            );
+            throw_status(status, operation...);
         }
     }
+    template<typename... Args>
+    [[noreturn]] static void throw_status(uint32_t status, const Args&... operation);
     
     // Convert enum to underlying type
     static constexpr uint32_t to_underlying(RFClockChip chip) {
@@ -5,10 +5,14 @@
 ******************************************************************************/
 
 #include "RfDc.hpp"
+#include "SimRfdc.hpp"
+#include "HwBackend.hpp"
+#include "Mmio.hpp"
+#include "LockWait.hpp"
+#include <iostream>
 #include <sstream>
-#include <fcntl.h>      // For open()
-#include <sys/mman.h>   // For mmap()
-#include <unistd.h>     // For close()
+#include <sys/mman.h>   // For MAP_FAILED
+#include <unistd.h>     // For usleep()
 #include <cstring>      // For memset()
 
 namespace rfdc {
@@ -16,11 +20,12 @@ namespace rfdc {
 // Constants for memory mapping
 constexpr size_t MAP_SIZE = 4096UL;
 constexpr size_t MAP_MASK = (MAP_SIZE - 1);
-constexpr uint32_t LMEM_INFO = 0x0;  // Offset for memory info register
-
-// Helper function to read from local memory
-static inline uint32_t lmem_rd32(void* addr) {
-    return *static_cast<volatile uint32_t*>(addr);
+// Memory channel spacing from a LocalMem INFO register
+static uint32_t lmem_channel_size(void* lmem_base, const char* name) {
+    uint32_t mem_info = mmio::Block(lmem_base, name).read(mmio::lmem::INFO);
+    uint32_t mem_size = mmio::lmem::INFO_MEM_SIZE.decode(mem_info);
+    uint32_t num_mem = mmio::lmem::INFO_NUM_MEM.decode(mem_info);
+    return 2 * mem_size / (num_mem + 1) / 16;
 }
 
 // Helper function to format strings (replaces std::format for C++14)
@@ -32,9 +37,23 @@ std::string format_string(Args&&... args) {
     return oss.str();
 }
 
+template<typename... Args>
+void RFDC::throw_status(uint32_t status, const Args&... operation)
+{
+    throw RFDCException(format_string(operation..., " failed with status: ", status), status);
+}
+
 // Constructor
 RFDC::RFDC(uint16_t device_id) 
 {
+    // On the simulated backend a converter model stands in for libmetal
+    // and the driver
+    if (hw_backend::active().simulated()) {
+        sim_ = std::make_unique<SimRfdc>();
+        sim_->fill_instance(instance_);
+        return;
+    }
+    
     // Initialize libmetal first - C++14 compatible way
     struct metal_init_params init_param;
     init_param.log_handler = nullptr;
@@ -84,35 +103,55 @@ RFDC::~RFDC() {
     // Cleanup memory mapping first
     cleanup_memory_mapping();
     // Cleanup libmetal
-    metal_finish();
+    if (!sim_) {
+        metal_finish();
+    }
 }
 
 // ===== Startup/Shutdown Operations =====
 
 void RFDC::startup(TileType type, TileId tile_id) 
 {
+    invalidate_tile(type, tile_id);
+    if (sim_) {
+        sim_->startup(type, tile_id);
+        return;
+    }
     auto status = XRFdc_StartUp(&instance_, to_underlying(type), tile_id);
-    check_status(status, format_string("StartUp tile ", tile_id, " type ", 
-                                       to_underlying(type)));
+    check_status(status, "StartUp tile ", tile_id, " type ", 
+                         to_underlying(type));
 }
 
 void RFDC::shutdown(TileType type, TileId tile_id) 
 {
+    invalidate_tile(type, tile_id);
+    if (sim_) {
+        sim_->shutdown(type, tile_id);
+        return;
+    }
     auto status = XRFdc_Shutdown(&instance_, to_underlying(type), tile_id);
-    check_status(status, format_string("Shutdown tile ", tile_id, " type ", 
-                                       to_underlying(type)));
+    check_status(status, "Shutdown tile ", tile_id, " type ", 
+                         to_underlying(type));
 }
 
 void RFDC::reset(TileType type, TileId tile_id) 
 {
+    invalidate_tile(type, tile_id);
+    if (sim_) {
+        sim_->reset(type, tile_id);
+        return;
+    }
     auto status = XRFdc_Reset(&instance_, to_underlying(type), tile_id);
-    check_status(status, format_string("Reset tile ", tile_id, " type ", 
-                                       to_underlying(type)));
+    check_status(status, "Reset tile ", tile_id, " type ", 
+                         to_underlying(type));
 }
 
 // ===== Status Operations =====
 
 IPStatus RFDC::get_ip_status() const {
+    if (sim_) {
+        return sim_->get_ip_status();
+    }
     XRFdc_IPStatus st{};
     auto ret = XRFdc_GetIPStatus(
         const_cast<XRFdc*>(&instance_),
@@ -123,6 +162,9 @@ IPStatus RFDC::get_ip_status() const {
 }
 
 BlockStatus RFDC::get_block_status(TileType type, TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_block_status(type, tile_id, block_id);
+    }
     BlockStatus status;
     auto result = XRFdc_GetBlockStatus(
         const_cast<XRFdc*>(&instance_),
@@ -131,8 +173,8 @@ BlockStatus RFDC::get_block_status(TileType type, TileId tile_id, BlockId block_
         block_id,
         status.get()
     );
-    check_status(result, format_string("GetBlockStatus tile ", tile_id, 
-                                       " block ", block_id));
+    check_status(result, "GetBlockStatus tile ", tile_id, 
+                         " block ", block_id);
     return status;
 }
 
@@ -142,6 +184,9 @@ DataPathMode RFDC::get_datapath_mode(
     BlockId block_id
 ) const
 {
+    if (sim_) {
+        return static_cast<DataPathMode>(sim_->get_datapath_mode(tile_id, block_id));
+    }
     uint32_t mode = 0;
 
     auto result = XRFdc_GetDataPathMode(
@@ -153,8 +198,8 @@ DataPathMode RFDC::get_datapath_mode(
 
     check_status(
         result,
-        format_string("GetDataPathMode tile ", tile_id,
-                      " block ", block_id)
+        "GetDataPathMode tile ", tile_id,
+        " block ", block_id
     );
 
     return static_cast<DataPathMode>(mode);
@@ -166,6 +211,11 @@ void RFDC::set_datapath_mode(
     DataPathMode mode
 )
 {
+    invalidate_block(TileType::DAC, tile_id, block_id);
+    if (sim_) {
+        sim_->set_datapath_mode(tile_id, block_id, static_cast<uint32_t>(mode));
+        return;
+    }
     auto result = XRFdc_SetDataPathMode(
         const_cast<XRFdc*>(&instance_),
         tile_id,
@@ -175,12 +225,15 @@ void RFDC::set_datapath_mode(
 
     check_status(
         result,
-        format_string("SetDataPathMode tile ", tile_id,
-                      " block ", block_id)
+        "SetDataPathMode tile ", tile_id,
+        " block ", block_id
     );
 }
 
 bool RFDC::check_tile_enabled(TileType type, TileId tile_id) const {
+    if (sim_) {
+        return sim_->check_tile_enabled(type, tile_id);
+    }
     auto status = XRFdc_CheckTileEnabled(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
@@ -190,6 +243,9 @@ bool RFDC::check_tile_enabled(TileType type, TileId tile_id) const {
 }
 
 bool RFDC::check_block_enabled(TileType type, TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->check_block_enabled(type, tile_id, block_id);
+    }
     auto status = XRFdc_CheckBlockEnabled(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
@@ -204,6 +260,12 @@ bool RFDC::check_block_enabled(TileType type, TileId tile_id, BlockId block_id)
 void RFDC::set_pll_config(TileType type, TileId tile_id, 
                           rfdc::ClockSource source,double ref_clk_freq, double sample_rate) 
 {
+    // The driver re-applies the mixers for the new rate: drop the whole tile
+    invalidate_tile(type, tile_id);
+    if (sim_) {
+        sim_->set_pll_config(type, tile_id, source, ref_clk_freq, sample_rate);
+        return;
+    }
     const u8 src = static_cast<u8>(source);
     auto status = XRFdc_DynamicPLLConfig(
         &instance_,
@@ -213,39 +275,80 @@ void RFDC::set_pll_config(TileType type, TileId tile_id,
         ref_clk_freq,
         sample_rate
     );
-    check_status(status, format_string("SetPLLConfig tile ", tile_id));
+    check_status(status, "SetPLLConfig tile ", tile_id);
 }
 
 PLLSettings RFDC::get_pll_config(TileType type, TileId tile_id) const 
 {
+    ShadowTile* shadow = shadow_tile(type, tile_id);
+    if (shadow && shadow->pll_valid) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return shadow->pll;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
     PLLSettings settings;
-    auto status = XRFdc_GetPLLConfig(
-        const_cast<XRFdc*>(&instance_),
-        to_underlying(type),
-        tile_id,
-        settings.get()
-    );
-    check_status(status, format_string("GetPLLConfig tile ", tile_id));
+    if (sim_) {
+        settings = sim_->get_pll_config(type, tile_id);
+    } else {
+        auto status = XRFdc_GetPLLConfig(
+            const_cast<XRFdc*>(&instance_),
+            to_underlying(type),
+            tile_id,
+            settings.get()
+        );
+        check_status(status, "GetPLLConfig tile ", tile_id);
+    }
+    if (shadow) {
+        shadow->pll = settings;
+        shadow->pll_valid = true;
+    }
     return settings;
 }
 
 bool RFDC::get_pll_lock_status(TileType type, TileId tile_id) const 
 {
+    const Result<bool> locked = try_get_pll_lock_status(type, tile_id);
+    check_status(locked.status, "GetPLLLockStatus tile ", tile_id);
+    return locked.value;
+}
+
+Result<bool> RFDC::try_get_pll_lock_status(TileType type, TileId tile_id) const noexcept
+{
+    Result<bool> result;
+    if (sim_) {
+        // The model throws on bad ids; the driver would return a failure
+        if (tile_id < SimRfdc::NUM_TILES) {
+            result.value = sim_->get_pll_lock_status(type, tile_id);
+            result.status = XRFDC_SUCCESS;
+        }
+        return result;
+    }
     uint32_t lock_status = 0;
-    auto status = XRFdc_GetPLLLockStatus(
+    result.status = XRFdc_GetPLLLockStatus(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
         tile_id,
         &lock_status
     );
-    check_status(status, format_string("GetPLLLockStatus tile ", tile_id));
-    return lock_status != 0;
+    // XRFDC_PLL_UNLOCKED is 1, not 0
+    result.value = lock_status == XRFDC_PLL_LOCKED;
+    return result;
 }
 
 // ===== Mixer Operations =====
 
 void RFDC::set_mixer_settings(TileType type, TileId tile_id, BlockId block_id,
                               const MixerSettings& settings) {
+    ++config_generation_;
+    // Dropped rather than written through: the driver may adjust the
+    // requested settings (NCO frequency quantisation, coarse mixer mode)
+    if (ShadowBlock* shadow = shadow_block(type, tile_id, block_id)) {
+        shadow->mixer_valid = false;
+    }
+    if (sim_) {
+        sim_->set_mixer_settings(type, tile_id, block_id, settings);
+        return;
+    }
     auto status = XRFdc_SetMixerSettings(
         &instance_,
         to_underlying(type),
@@ -253,36 +356,58 @@ void RFDC::set_mixer_settings(TileType type, TileId tile_id, BlockId block_id,
         block_id,
         const_cast<XRFdc_Mixer_Settings*>(settings.get())
     );
-    check_status(status, format_string("SetMixerSettings tile ", tile_id, " block ", block_id));
+    check_status(status, "SetMixerSettings tile ", tile_id, " block ", block_id);
 }
 
 MixerSettings RFDC::get_mixer_settings(TileType type, TileId tile_id, BlockId block_id) const {
+    ShadowBlock* shadow = shadow_block(type, tile_id, block_id);
+    if (shadow && shadow->mixer_valid) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return shadow->mixer;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
     MixerSettings settings;
-    auto status = XRFdc_GetMixerSettings(
-        const_cast<XRFdc*>(&instance_),
-        to_underlying(type),
-        tile_id,
-        block_id,
-        settings.get()
-    );
-    check_status(status, format_string("GetMixerSettings tile ", tile_id, " block ", block_id));
+    if (sim_) {
+        settings = sim_->get_mixer_settings(type, tile_id, block_id);
+    } else {
+        auto status = XRFdc_GetMixerSettings(
+            const_cast<XRFdc*>(&instance_),
+            to_underlying(type),
+            tile_id,
+            block_id,
+            settings.get()
+        );
+        check_status(status, "GetMixerSettings tile ", tile_id, " block ", block_id);
+    }
+    if (shadow) {
+        shadow->mixer = settings;
+        shadow->mixer_valid = true;
+    }
     return settings;
 }
 
 void RFDC::reset_nco_phase(TileType type, TileId tile_id, BlockId block_id) {
+    if (sim_) {
+        sim_->reset_nco_phase(type, tile_id, block_id);
+        return;
+    }
     auto status = XRFdc_ResetNCOPhase(
         &instance_,
         to_underlying(type),
         tile_id,
         block_id
     );
-    check_status(status, format_string("ResetNCOPhase tile ", tile_id, " block ", block_id));
+    check_status(status, "ResetNCOPhase tile ", tile_id, " block ", block_id);
 }
 
 // ===== QMC Operations =====
 
 void RFDC::set_qmc_settings(TileType type, TileId tile_id, BlockId block_id,
                             const QMCSettings& settings) {
+    if (sim_) {
+        sim_->set_qmc_settings(type, tile_id, block_id, settings);
+        return;
+    }
     auto status = XRFdc_SetQMCSettings(
         &instance_,
         to_underlying(type),
@@ -290,10 +415,13 @@ void RFDC::set_qmc_settings(TileType type, TileId tile_id, BlockId block_id,
         block_id,
         const_cast<XRFdc_QMC_Settings*>(settings.get())
     );
-    check_status(status, format_string("SetQMCSettings tile ", tile_id, " block ", block_id));
+    check_status(status, "SetQMCSettings tile ", tile_id, " block ", block_id);
 }
 
 QMCSettings RFDC::get_qmc_settings(TileType type, TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_qmc_settings(type, tile_id, block_id);
+    }
     QMCSettings settings;
     auto status = XRFdc_GetQMCSettings(
         const_cast<XRFdc*>(&instance_),
@@ -302,13 +430,17 @@ QMCSettings RFDC::get_qmc_settings(TileType type, TileId tile_id, BlockId block_
         block_id,
         settings.get()
     );
-    check_status(status, format_string("GetQMCSettings tile ", tile_id, " block ", block_id));
+    check_status(status, "GetQMCSettings tile ", tile_id, " block ", block_id);
     return settings;
 }
 
 // ===== Nyquist Zone Operations =====
 
 void RFDC::set_nyquist_zone(TileType type, TileId tile_id, BlockId block_id, NyquistZone zone) {
+    if (sim_) {
+        sim_->set_nyquist_zone(type, tile_id, block_id, zone);
+        return;
+    }
     auto status = XRFdc_SetNyquistZone(
         &instance_,
         to_underlying(type),
@@ -316,10 +448,13 @@ void RFDC::set_nyquist_zone(TileType type, TileId tile_id, BlockId block_id, Nyq
         block_id,
         static_cast<uint32_t>(zone)
     );
-    check_status(status, format_string("SetNyquistZone tile ", tile_id, " block ", block_id));
+    check_status(status, "SetNyquistZone tile ", tile_id, " block ", block_id);
 }
 
 NyquistZone RFDC::get_nyquist_zone(TileType type, TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_nyquist_zone(type, tile_id, block_id);
+    }
     uint32_t zone = 0;
     auto status = XRFdc_GetNyquistZone(
         const_cast<XRFdc*>(&instance_),
@@ -328,60 +463,165 @@ NyquistZone RFDC::get_nyquist_zone(TileType type, TileId tile_id, BlockId block_
         block_id,
         &zone
     );
-    check_status(status, format_string("GetNyquistZone tile ", tile_id, " block ", block_id));
+    check_status(status, "GetNyquistZone tile ", tile_id, " block ", block_id);
     return static_cast<NyquistZone>(zone);
 }
 
 // ===== Interpolation/Decimation Operations =====
 
 void RFDC::set_interpolation_factor(TileId tile_id, BlockId block_id, uint32_t factor) {
+    if (ShadowBlock* shadow = shadow_block(TileType::DAC, tile_id, block_id)) {
+        shadow->factor_valid = false;
+    }
+    if (sim_) {
+        sim_->set_interpolation_factor(tile_id, block_id, factor);
+        return;
+    }
     auto status = XRFdc_SetInterpolationFactor(
         &instance_,
         tile_id,
         block_id,
         factor
     );
-    check_status(status, format_string("SetInterpolationFactor tile ", tile_id, " block ", block_id));
+    check_status(status, "SetInterpolationFactor tile ", tile_id, " block ", block_id);
 }
 
 uint32_t RFDC::get_interpolation_factor(TileId tile_id, BlockId block_id) const {
+    ShadowBlock* shadow = shadow_block(TileType::DAC, tile_id, block_id);
+    if (shadow && shadow->factor_valid) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return shadow->factor;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
     uint32_t factor = 0;
-    auto status = XRFdc_GetInterpolationFactor(
-        const_cast<XRFdc*>(&instance_),
-        tile_id,
-        block_id,
-        &factor
-    );
-    check_status(status, format_string("GetInterpolationFactor tile ", tile_id, " block ", block_id));
+    if (sim_) {
+        factor = sim_->get_interpolation_factor(tile_id, block_id);
+    } else {
+        auto status = XRFdc_GetInterpolationFactor(
+            const_cast<XRFdc*>(&instance_),
+            tile_id,
+            block_id,
+            &factor
+        );
+        check_status(status, "GetInterpolationFactor tile ", tile_id, " block ", block_id);
+    }
+    if (shadow) {
+        shadow->factor = factor;
+        shadow->factor_valid = true;
+    }
     return factor;
 }
 
 void RFDC::set_decimation_factor(TileId tile_id, BlockId block_id, uint32_t factor) {
+    if (ShadowBlock* shadow = shadow_block(TileType::ADC, tile_id, block_id)) {
+        shadow->factor_valid = false;
+    }
+    if (sim_) {
+        sim_->set_decimation_factor(tile_id, block_id, factor);
+        return;
+    }
     auto status = XRFdc_SetDecimationFactor(
         &instance_,
         tile_id,
         block_id,
         factor
     );
-    check_status(status, format_string("SetDecimationFactor tile ", tile_id, " block ", block_id));
+    check_status(status, "SetDecimationFactor tile ", tile_id, " block ", block_id);
 }
 
 uint32_t RFDC::get_decimation_factor(TileId tile_id, BlockId block_id) const {
+    ShadowBlock* shadow = shadow_block(TileType::ADC, tile_id, block_id);
+    if (shadow && shadow->factor_valid) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return shadow->factor;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
     uint32_t factor = 0;
-    auto status = XRFdc_GetDecimationFactor(
-        const_cast<XRFdc*>(&instance_),
-        tile_id,
-        block_id,
-        &factor
-    );
-    check_status(status, format_string("GetDecimationFactor tile ", tile_id, " block ", block_id));
+    if (sim_) {
+        factor = sim_->get_decimation_factor(tile_id, block_id);
+    } else {
+        auto status = XRFdc_GetDecimationFactor(
+            const_cast<XRFdc*>(&instance_),
+            tile_id,
+            block_id,
+            &factor
+        );
+        check_status(status, "GetDecimationFactor tile ", tile_id, " block ", block_id);
+    }
+    if (shadow) {
+        shadow->factor = factor;
+        shadow->factor_valid = true;
+    }
     return factor;
 }
 
 
+// ===== Configuration Cache =====
+
+RFDC::ShadowTile* RFDC::shadow_tile(TileType type, TileId tile_id) const {
+    if (tile_id >= 4) {
+        return nullptr;
+    }
+    return type == TileType::ADC ? &adc_shadow_[tile_id] : &dac_shadow_[tile_id];
+}
+
+RFDC::ShadowBlock* RFDC::shadow_block(TileType type, TileId tile_id, BlockId block_id) const {
+    ShadowTile* shadow = shadow_tile(type, tile_id);
+    if (!shadow || block_id >= 4) {
+        return nullptr;
+    }
+    return &shadow->blocks[block_id];
+}
+
+void RFDC::invalidate_tile(TileType type, TileId tile_id) {
+    if (ShadowTile* shadow = shadow_tile(type, tile_id)) {
+        *shadow = ShadowTile();
+    }
+}
+
+void RFDC::invalidate_block(TileType type, TileId tile_id, BlockId block_id) {
+    if (ShadowBlock* shadow = shadow_block(type, tile_id, block_id)) {
+        *shadow = ShadowBlock();
+    }
+}
+
+void RFDC::resync_config(TileType type, TileId tile_id) {
+    invalidate_tile(type, tile_id);
+    // Anything derived from the mixer setup must be rebuilt as well
+    ++config_generation_;
+    if (!check_tile_enabled(type, tile_id)) {
+        return;
+    }
+    get_pll_config(type, tile_id);
+    if (type == TileType::ADC) {
+        check_high_speed_adc(tile_id);
+    }
+    for (BlockId block = 0; block < 4; ++block) {
+        if (!check_block_enabled(type, tile_id, block)) {
+            continue;
+        }
+        get_mixer_settings(type, tile_id, block);
+        if (type == TileType::ADC) {
+            get_decimation_factor(tile_id, block);
+        } else {
+            get_interpolation_factor(tile_id, block);
+        }
+    }
+}
+
+void RFDC::resync_config() {
+    for (TileId tile = 0; tile < 4; ++tile) {
+        resync_config(TileType::ADC, tile);
+        resync_config(TileType::DAC, tile);
+    }
+}
+
 // ===== DAC-Specific Operations =====
 
 uint32_t RFDC::get_data_path_mode(TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_datapath_mode(tile_id, block_id);
+    }
     uint32_t mode = 0;
     uint32_t status = XRFdc_GetDataPathMode(
         const_cast<XRFdc*>(&instance_),
@@ -396,18 +636,28 @@ uint32_t RFDC::get_data_path_mode(TileId tile_id, BlockId block_id) const {
 // ===== FIFO Operations =====
 
 void RFDC::setup_fifo(TileType type, TileId tile_id, bool enable) {
+    mmio::Operation op("rfdc.setup_fifo");
+    if (sim_) {
+        sim_->setup_fifo(type, tile_id, enable);
+        return;
+    }
     auto status = XRFdc_SetupFIFO(
         &instance_,
         to_underlying(type),
         tile_id,
         enable ? 1 : 0
     );
-    check_status(status, format_string("SetupFIFO tile ", tile_id));
+    check_status(status, "SetupFIFO tile ", tile_id);
 }
 
 // ===== IMR Pass Mode (Gen3+ DAC only) =====
 
 void RFDC::set_imr_pass_mode(TileId tile_id, BlockId block_id, uint32_t mode) {
+    invalidate_block(TileType::DAC, tile_id, block_id);
+    if (sim_) {
+        sim_->set_imr_pass_mode(tile_id, block_id, mode);
+        return;
+    }
     uint32_t status = XRFdc_SetIMRPassMode(
         const_cast<XRFdc*>(&instance_),
         tile_id,
@@ -418,6 +668,9 @@ void RFDC::set_imr_pass_mode(TileId tile_id, BlockId block_id, uint32_t mode) {
 }
 
 uint32_t RFDC::get_imr_pass_mode(TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_imr_pass_mode(tile_id, block_id);
+    }
     uint32_t mode = 0;
     uint32_t status = XRFdc_GetIMRPassMode(
         const_cast<XRFdc*>(&instance_),
@@ -430,30 +683,51 @@ uint32_t RFDC::get_imr_pass_mode(TileId tile_id, BlockId block_id) const {
 }
 
 bool RFDC::get_fifo_status(TileType type, TileId tile_id) const {
+    const Result<bool> enabled = try_get_fifo_status(type, tile_id);
+    check_status(enabled.status, "GetFIFOStatus tile ", tile_id);
+    return enabled.value;
+}
+
+Result<bool> RFDC::try_get_fifo_status(TileType type, TileId tile_id) const noexcept {
+    Result<bool> result;
+    if (sim_) {
+        if (tile_id < SimRfdc::NUM_TILES) {
+            result.value = sim_->get_fifo_status(type, tile_id);
+            result.status = XRFDC_SUCCESS;
+        }
+        return result;
+    }
     uint8_t enabled = 0;
-    auto status = XRFdc_GetFIFOStatus(
+    result.status = XRFdc_GetFIFOStatus(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
         tile_id,
         &enabled
     );
-    check_status(status, format_string("GetFIFOStatus tile ", tile_id));
-    return enabled != 0;
+    result.value = enabled != 0;
+    return result;
 }
 
 // ===== Fabric Clock Operations =====
 
 void RFDC::set_fabric_clk_out_div(TileType type, TileId tile_id, uint16_t div) {
+    if (sim_) {
+        sim_->set_fabric_clk_out_div(type, tile_id, div);
+        return;
+    }
     auto status = XRFdc_SetFabClkOutDiv(
         &instance_,
         to_underlying(type),
         tile_id,
         div
     );
-    check_status(status, format_string("SetFabClkOutDiv tile ", tile_id));
+    check_status(status, "SetFabClkOutDiv tile ", tile_id);
 }
 
 uint16_t RFDC::get_fabric_clk_out_div(TileType type, TileId tile_id) const {
+    if (sim_) {
+        return sim_->get_fabric_clk_out_div(type, tile_id);
+    }
     uint16_t div = 0;
     auto status = XRFdc_GetFabClkOutDiv(
         const_cast<XRFdc*>(&instance_),
@@ -461,11 +735,14 @@ uint16_t RFDC::get_fabric_clk_out_div(TileType type, TileId tile_id) const {
         tile_id,
         &div
     );
-    check_status(status, format_string("GetFabClkOutDiv tile ", tile_id));
+    check_status(status, "GetFabClkOutDiv tile ", tile_id);
     return div;
 }
 
 double RFDC::get_fabric_clk_freq(TileType type, TileId tile_id) const {
+    if (sim_) {
+        return sim_->get_fabric_clk_freq(type, tile_id);
+    }
     return XRFdc_GetFabClkFreq(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
@@ -477,16 +754,23 @@ double RFDC::get_fabric_clk_freq(TileType type, TileId tile_id) const {
 
 void RFDC::set_threshold_settings(TileId tile_id, BlockId block_id,
                                   const ThresholdSettings& settings) {
+    if (sim_) {
+        sim_->set_threshold_settings(tile_id, block_id, settings);
+        return;
+    }
     auto status = XRFdc_SetThresholdSettings(
         &instance_,
         tile_id,
         block_id,
         const_cast<XRFdc_Threshold_Settings*>(settings.get())
     );
-    check_status(status, format_string("SetThresholdSettings tile ", tile_id, " block ", block_id));
+    check_status(status, "SetThresholdSettings tile ", tile_id, " block ", block_id);
 }
 
 ThresholdSettings RFDC::get_threshold_settings(TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_threshold_settings(tile_id, block_id);
+    }
     ThresholdSettings settings;
     auto status = XRFdc_GetThresholdSettings(
         const_cast<XRFdc*>(&instance_),
@@ -494,21 +778,28 @@ ThresholdSettings RFDC::get_threshold_settings(TileId tile_id, BlockId block_id)
         block_id,
         settings.get()
     );
-    check_status(status, format_string("GetThresholdSettings tile ", tile_id, " block ", block_id));
+    check_status(status, "GetThresholdSettings tile ", tile_id, " block ", block_id);
     return settings;
 }
 
 void RFDC::set_calibration_mode(TileId tile_id, BlockId block_id, CalibrationMode mode) {
+    if (sim_) {
+        sim_->set_calibration_mode(tile_id, block_id, mode);
+        return;
+    }
     auto status = XRFdc_SetCalibrationMode(
         &instance_,
         tile_id,
         block_id,
         static_cast<uint8_t>(mode)
     );
-    check_status(status, format_string("SetCalibrationMode tile ", tile_id, " block ", block_id));
+    check_status(status, "SetCalibrationMode tile ", tile_id, " block ", block_id);
 }
 
 CalibrationMode RFDC::get_calibration_mode(TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_calibration_mode(tile_id, block_id);
+    }
     uint8_t mode = 0;
     auto status = XRFdc_GetCalibrationMode(
         const_cast<XRFdc*>(&instance_),
@@ -516,23 +807,30 @@ CalibrationMode RFDC::get_calibration_mode(TileId tile_id, BlockId block_id) con
         block_id,
         &mode
     );
-    check_status(status, format_string("GetCalibrationMode tile ", tile_id, " block ", block_id));
+    check_status(status, "GetCalibrationMode tile ", tile_id, " block ", block_id);
     return static_cast<CalibrationMode>(mode);
 }
 
 // ===== DAC-Specific Operations =====
 
 void RFDC::set_decoder_mode(TileId tile_id, BlockId block_id, uint32_t mode) {
+    if (sim_) {
+        sim_->set_decoder_mode(tile_id, block_id, mode);
+        return;
+    }
     auto status = XRFdc_SetDecoderMode(
         &instance_,
         tile_id,
         block_id,
         mode
     );
-    check_status(status, format_string("SetDecoderMode tile ", tile_id, " block ", block_id));
+    check_status(status, "SetDecoderMode tile ", tile_id, " block ", block_id);
 }
 
 uint32_t RFDC::get_decoder_mode(TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_decoder_mode(tile_id, block_id);
+    }
     uint32_t mode = 0;
     auto status = XRFdc_GetDecoderMode(
         const_cast<XRFdc*>(&instance_),
@@ -540,21 +838,28 @@ uint32_t RFDC::get_decoder_mode(TileId tile_id, BlockId block_id) const {
         block_id,
         &mode
     );
-    check_status(status, format_string("GetDecoderMode tile ", tile_id, " block ", block_id));
+    check_status(status, "GetDecoderMode tile ", tile_id, " block ", block_id);
     return mode;
 }
 
 void RFDC::set_inverse_sinc_filter(TileId tile_id, BlockId block_id, uint16_t mode) {
+    if (sim_) {
+        sim_->set_inverse_sinc_filter(tile_id, block_id, mode);
+        return;
+    }
     auto status = XRFdc_SetInvSincFIR(
         &instance_,
         tile_id,
         block_id,
         mode
     );
-    check_status(status, format_string("SetInvSincFIR tile ", tile_id, " block ", block_id));
+    check_status(status, "SetInvSincFIR tile ", tile_id, " block ", block_id);
 }
 
 uint16_t RFDC::get_inverse_sinc_filter(TileId tile_id, BlockId block_id) const {
+    if (sim_) {
+        return sim_->get_inverse_sinc_filter(tile_id, block_id);
+    }
     uint16_t mode = 0;
     auto status = XRFdc_GetInvSincFIR(
         const_cast<XRFdc*>(&instance_),
@@ -562,13 +867,17 @@ uint16_t RFDC::get_inverse_sinc_filter(TileId tile_id, BlockId block_id) const {
         block_id,
         &mode
     );
-    check_status(status, format_string("GetInvSincFIR tile ", tile_id, " block ", block_id));
+    check_status(status, "GetInvSincFIR tile ", tile_id, " block ", block_id);
     return mode;
 }
 
 // ===== Interrupt Operations =====
 
 void RFDC::enable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask) {
+    if (sim_) {
+        sim_->enable_interrupts(type, tile_id, block_id, mask);
+        return;
+    }
     auto status = XRFdc_IntrEnable(
         &instance_,
         to_underlying(type),
@@ -576,10 +885,14 @@ void RFDC::enable_interrupts(TileType type, TileId tile_id, BlockId block_id, ui
         block_id,
         mask
     );
-    check_status(status, format_string("IntrEnable tile ", tile_id, " block ", block_id));
+    check_status(status, "IntrEnable tile ", tile_id, " block ", block_id);
 }
 
 void RFDC::disable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask) {
+    if (sim_) {
+        sim_->disable_interrupts(type, tile_id, block_id, mask);
+        return;
+    }
     auto status = XRFdc_IntrDisable(
         &instance_,
         to_underlying(type),
@@ -587,10 +900,14 @@ void RFDC::disable_interrupts(TileType type, TileId tile_id, BlockId block_id, u
         block_id,
         mask
     );
-    check_status(status, format_string("IntrDisable tile ", tile_id, " block ", block_id));
+    check_status(status, "IntrDisable tile ", tile_id, " block ", block_id);
 }
 
 void RFDC::clear_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask) {
+    if (sim_) {
+        sim_->clear_interrupts(type, tile_id, block_id, mask);
+        return;
+    }
     auto status = XRFdc_IntrClr(
         &instance_,
         to_underlying(type),
@@ -598,25 +915,49 @@ void RFDC::clear_interrupts(TileType type, TileId tile_id, BlockId block_id, uin
         block_id,
         mask
     );
-    check_status(status, format_string("IntrClr tile ", tile_id, " block ", block_id));
+    check_status(status, "IntrClr tile ", tile_id, " block ", block_id);
 }
 
 uint32_t RFDC::get_interrupt_status(TileType type, TileId tile_id, BlockId block_id) const {
-    uint32_t status_mask = 0;
-    auto status = XRFdc_GetIntrStatus(
+    const Result<uint32_t> mask = try_get_interrupt_status(type, tile_id, block_id);
+    check_status(mask.status, "GetIntrStatus tile ", tile_id, " block ", block_id);
+    return mask.value;
+}
+
+Result<uint32_t> RFDC::try_get_interrupt_status(TileType type, TileId tile_id,
+                                                BlockId block_id) const noexcept {
+    Result<uint32_t> result;
+    if (sim_) {
+        if (tile_id < SimRfdc::NUM_TILES && block_id < SimRfdc::NUM_BLOCKS) {
+            result.value = sim_->get_interrupt_status(type, tile_id, block_id);
+            result.status = XRFDC_SUCCESS;
+        }
+        return result;
+    }
+    result.status = XRFdc_GetIntrStatus(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
         tile_id,
         block_id,
-        &status_mask
+        &result.value
     );
-    check_status(status, format_string("GetIntrStatus tile ", tile_id, " block ", block_id));
-    return status_mask;
+    return result;
 }
 
 // ===== Multi-Tile Sync Operations =====
 
+void RFDC::multi_converter_init(XRFdc_MultiConverter_Sync_Config* config, TileId ref_tile) {
+    if (sim_) {
+        sim_->multi_converter_init(config, ref_tile);
+        return;
+    }
+    XRFdc_MultiConverter_Init(config, nullptr, nullptr, ref_tile);
+}
+
 uint32_t RFDC::multi_converter_sync(TileType type, XRFdc_MultiConverter_Sync_Config* config) {
+    if (sim_) {
+        return sim_->multi_converter_sync(type, config);
+    }
     return XRFdc_MultiConverter_Sync(
         &instance_,
         to_underlying(type),
@@ -624,9 +965,22 @@ uint32_t RFDC::multi_converter_sync(TileType type, XRFdc_MultiConverter_Sync_Con
     );
 }
 
+void RFDC::mts_sysref_config(XRFdc_MultiConverter_Sync_Config* dac_config,
+                             XRFdc_MultiConverter_Sync_Config* adc_config, bool enable) {
+    if (sim_) {
+        return;
+    }
+    auto status = XRFdc_MTS_Sysref_Config(&instance_, dac_config, adc_config, enable ? 1 : 0);
+    check_status(status, "MTS_Sysref_Config ", enable ? "enable" : "disable");
+}
+
 // ===== Update Event =====
 
 void RFDC::update_event(TileType type, TileId tile_id, BlockId block_id, uint32_t event) {
+    if (sim_) {
+        sim_->update_event(type, tile_id, block_id, event);
+        return;
+    }
     auto status = XRFdc_UpdateEvent(
         &instance_,
         to_underlying(type),
@@ -634,12 +988,16 @@ void RFDC::update_event(TileType type, TileId tile_id, BlockId block_id, uint32_
         block_id,
         event
     );
-    check_status(status, format_string("UpdateEvent tile ", tile_id, " block ", block_id));
+    check_status(status, "UpdateEvent tile ", tile_id, " block ", block_id);
 }
 
 // ===== Utility Functions =====
 
 void RFDC::dump_registers(TileType type, int tile_id) const {
+    if (sim_) {
+        std::cout << "(simulated RFDC: no registers to dump)\n";
+        return;
+    }
     XRFdc_DumpRegs(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
@@ -660,32 +1018,31 @@ void RFDC::initialize_memory_mapping(
     const std::array<uint32_t, 4>& adc_clk_wiz_addrs,
     const std::array<uint32_t, 4>& dac_clk_wiz_addrs)
 {
-    // Open /dev/mem for memory-mapped I/O
-    mem_info_.fd = open("/dev/mem", O_RDWR | O_NDELAY);
-    if (mem_info_.fd < 0) 
-    {
-        throw RFDCException("Failed to open /dev/mem - check permissions");
+    hw_backend::Backend& backend = hw_backend::active();
+    
+    // The simulator needs to know where the data movers and clock wizards live
+    if (hw_backend::Simulated* sim = hw_backend::simulator()) {
+        sim->add_local_mem(true, adc_base_addr);
+        sim->add_local_mem(false, dac_base_addr);
+        for (int i = 0; i < 4; ++i) {
+            sim->add_clock_wizard(adc_clk_wiz_addrs[i]);
+            sim->add_clock_wizard(dac_clk_wiz_addrs[i]);
+        }
     }
     
     // Map ADC base address
-    mem_info_.base_adc = mmap(nullptr, MAP_SIZE * 2, 
-                              PROT_READ | PROT_WRITE, MAP_SHARED,
-                              mem_info_.fd, adc_base_addr & ~MAP_MASK);
+    mem_info_.base_adc = backend.map_physical(adc_base_addr & ~MAP_MASK, MAP_SIZE * 2);
     if (mem_info_.base_adc == MAP_FAILED) {
-        close(mem_info_.fd);
-        throw RFDCException("Failed to mmap ADC base address");
+        throw RFDCException("Failed to mmap ADC base address - check /dev/mem permissions");
     }
     mem_info_.vaddr_adc = static_cast<char*>(mem_info_.base_adc) + 
                           (adc_base_addr & MAP_MASK);
     mem_info_.paddr_adc = adc_base_addr;
     
     // Map DAC base address
-    mem_info_.base_dac = mmap(nullptr, MAP_SIZE * 2,
-                              PROT_READ | PROT_WRITE, MAP_SHARED,
-                              mem_info_.fd, dac_base_addr & ~MAP_MASK);
+    mem_info_.base_dac = backend.map_physical(dac_base_addr & ~MAP_MASK, MAP_SIZE * 2);
     if (mem_info_.base_dac == MAP_FAILED) {
-        munmap(mem_info_.base_adc, MAP_SIZE * 2);
-        close(mem_info_.fd);
+        cleanup_memory_mapping();
         throw RFDCException("Failed to mmap DAC base address");
     }
     mem_info_.vaddr_dac = static_cast<char*>(mem_info_.base_dac) + 
@@ -695,10 +1052,8 @@ void RFDC::initialize_memory_mapping(
     // Map clock wizards for ADC tiles
     for (int i = 0; i < 4; ++i) 
     {
-        mem_info_.clk_wiz_adc[i] = mmap(nullptr, MAP_SIZE * 2,
-                                        PROT_READ | PROT_WRITE, MAP_SHARED,
-                                        mem_info_.fd, 
-                                        adc_clk_wiz_addrs[i] & ~MAP_MASK);
+        mem_info_.clk_wiz_adc[i] = backend.map_physical(adc_clk_wiz_addrs[i] & ~MAP_MASK,
+                                                        MAP_SIZE * 2);
         if (mem_info_.clk_wiz_adc[i] == MAP_FAILED) {
             cleanup_memory_mapping();
             throw RFDCException(
@@ -709,10 +1064,8 @@ void RFDC::initialize_memory_mapping(
     
     // Map clock wizards for DAC tiles
     for (int i = 0; i < 4; ++i) {
-        mem_info_.clk_wiz_dac[i] = mmap(nullptr, MAP_SIZE * 2,
-                                        PROT_READ | PROT_WRITE, MAP_SHARED,
-                                        mem_info_.fd,
-                                        dac_clk_wiz_addrs[i] & ~MAP_MASK);
+        mem_info_.clk_wiz_dac[i] = backend.map_physical(dac_clk_wiz_addrs[i] & ~MAP_MASK,
+                                                        MAP_SIZE * 2);
         if (mem_info_.clk_wiz_dac[i] == MAP_FAILED) {
             cleanup_memory_mapping();
             throw RFDCException(
@@ -726,32 +1079,33 @@ void RFDC::initialize_memory_mapping(
 }
 
 void RFDC::cleanup_memory_mapping() {
+    hw_backend::Backend& backend = hw_backend::active();
+    
     // Unmap all memory regions
     if (mem_info_.base_adc && mem_info_.base_adc != MAP_FAILED) {
-        munmap(mem_info_.base_adc, MAP_SIZE * 2);
+        backend.unmap_physical(mem_info_.base_adc, MAP_SIZE * 2);
     }
     if (mem_info_.base_dac && mem_info_.base_dac != MAP_FAILED) {
-        munmap(mem_info_.base_dac, MAP_SIZE * 2);
+        backend.unmap_physical(mem_info_.base_dac, MAP_SIZE * 2);
     }
+    mem_info_.base_adc = nullptr;
+    mem_info_.base_dac = nullptr;
     
     // Unmap clock wizards
     for (int i = 0; i < 4; ++i) {
         if (mem_info_.clk_wiz_adc[i] && mem_info_.clk_wiz_adc[i] != MAP_FAILED) {
-            munmap(mem_info_.clk_wiz_adc[i], MAP_SIZE * 2);
+            backend.unmap_physical(mem_info_.clk_wiz_adc[i], MAP_SIZE * 2);
         }
         if (mem_info_.clk_wiz_dac[i] && mem_info_.clk_wiz_dac[i] != MAP_FAILED) {
-            munmap(mem_info_.clk_wiz_dac[i], MAP_SIZE * 2);
+            backend.unmap_physical(mem_info_.clk_wiz_dac[i], MAP_SIZE * 2);
         }
-    }
-    
-    // Close /dev/mem
-    if (mem_info_.fd >= 0) {
-        close(mem_info_.fd);
-        mem_info_.fd = -1;
+        mem_info_.clk_wiz_adc[i] = nullptr;
+        mem_info_.clk_wiz_dac[i] = nullptr;
     }
 }
 
 void RFDC::build_channel_maps() {
+    ++config_generation_;
     // Initialize all maps to invalid
     for (size_t i = 0; i < 16; ++i) {
         adc_map_[i] = ChannelMap();  // Uses default constructor (all 0xFFFFFFFF)
@@ -762,12 +1116,7 @@ void RFDC::build_channel_maps() {
     }
     
     // Read ADC memory info
-    uint32_t mem_info = lmem_rd32(
-        static_cast<char*>(mem_info_.vaddr_adc) + LMEM_INFO
-    );
-    uint32_t mem_size = mem_info & 0x00FFFFFF;        // bits [23:0]
-    uint32_t num_mem = (mem_info >> 24) & 0x0000007F; // bits [30:24]
-    mem_size = 2 * mem_size / (num_mem + 1) / 16;
+    uint32_t mem_size = lmem_channel_size(mem_info_.vaddr_adc, "lmem_adc");
     
     uint32_t cur_addr = mem_info_.paddr_adc + mem_size;
     uint16_t channel = 0;
@@ -777,7 +1126,9 @@ void RFDC::build_channel_maps() {
         uint32_t num_blocks = instance_.RFdc_Config.ADCTile_Config[tile].NumSlices;
         
         for (uint32_t block = 0; block < num_blocks; ++block) {
-            if (XRFdc_IsADCDigitalPathEnabled(&instance_, tile, block)) {
+            bool path_enabled = sim_ ? sim_->check_block_enabled(TileType::ADC, tile, block)
+                                     : XRFdc_IsADCDigitalPathEnabled(&instance_, tile, block);
+            if (path_enabled) {
                 uint32_t idx = tile * num_blocks + block;
                 
                 // Set I channel address
@@ -788,9 +1139,10 @@ void RFDC::build_channel_maps() {
                 channel++;
                 
                 // Check for IQ mode (complex data)
-                bool is_high_speed = XRFdc_IsHighSpeedADC(&instance_, tile);
-                bool is_iq_mode = XRFdc_GetDataType(&instance_, static_cast<u32>(TileType::ADC), tile, 
-                                                     block << instance_.ADC4GSPS);
+                bool is_high_speed = check_high_speed_adc(tile);
+                bool is_iq_mode = sim_ ? sim_->is_iq_data(TileType::ADC, tile, block)
+                                       : XRFdc_GetDataType(&instance_, static_cast<u32>(TileType::ADC), tile, 
+                                                           block << instance_.ADC4GSPS);
                 
                 if (is_high_speed && is_iq_mode) {
                     // Separate Q channel
@@ -812,10 +1164,7 @@ void RFDC::build_channel_maps() {
     
     // Build DAC channel map
     channel = 0;
-    mem_info = lmem_rd32(static_cast<char*>(mem_info_.vaddr_dac) + LMEM_INFO);
-    mem_size = mem_info & 0x00FFFFFF;
-    num_mem = (mem_info >> 24) & 0x0000007F;
-    mem_size = 2 * mem_size / (num_mem + 1) / 16;
+    mem_size = lmem_channel_size(mem_info_.vaddr_dac, "lmem_dac");
     cur_addr = mem_info_.paddr_dac + mem_size;
     
     // Calculate number of DAC tiles based on IP type
@@ -826,7 +1175,9 @@ void RFDC::build_channel_maps() {
     
     for (uint32_t tile = 0; tile < num_dac_tiles; ++tile) {
         for (uint32_t block = 0; block < 4; ++block) {
-            if (XRFdc_IsDACDigitalPathEnabled(&instance_, tile, block)) {
+            bool path_enabled = sim_ ? sim_->check_block_enabled(TileType::DAC, tile, block)
+                                     : XRFdc_IsDACDigitalPathEnabled(&instance_, tile, block);
+            if (path_enabled) {
                 uint32_t idx = tile * 4 + block;
                 
                 // DACs typically share I and Q addresses
@@ -844,9 +1195,13 @@ void RFDC::build_channel_maps() {
 
 void RFDC::initialize_mmcm_adc() 
 {
+    if (sim_) {
+        throw RFDCException("initialize_mmcm_adc is not modelled on the simulated backend; "
+                            "use clock_wizard::ClockWizard");
+    }
     // Clock wizard register offsets
-    constexpr uint32_t CLKREG_OFFSET = 0x200;
-    constexpr uint32_t CLKOUT_OFFSET = 0x208;
+    constexpr uint32_t CLKREG_OFFSET = mmio::clk_wiz::CLK_CONFIG0;
+    constexpr uint32_t CLKOUT_OFFSET = mmio::clk_wiz::CLKOUT0;
     
     uint32_t mts_enable = 0;  // Multi-tile sync (typically 0)
     
@@ -872,15 +1227,16 @@ void RFDC::initialize_mmcm_adc()
         }
         
         // Read clock configuration registers
-        uint32_t clk_config_reg = lmem_rd32(static_cast<char*>(clk_base_addr) + CLKREG_OFFSET);
-        uint32_t mult = (clk_config_reg & 0x0000FF00) >> 8;
-        uint32_t div = (clk_config_reg & 0x000000FF);
-        uint32_t frac_mult = (clk_config_reg & 0x03FF0000) >> 16;
+        const mmio::Block clk(clk_base_addr, "clk_wiz");
+        uint32_t clk_config_reg = clk.read(CLKREG_OFFSET);
+        uint32_t mult = mmio::clk_wiz::CONFIG0_MULT.decode(clk_config_reg);
+        uint32_t div = mmio::clk_wiz::CONFIG0_DIVCLK.decode(clk_config_reg);
+        uint32_t frac_mult = mmio::clk_wiz::CONFIG0_MULT_FRAC.decode(clk_config_reg);
         mult = (1000 * mult) + frac_mult;
         
-        clk_config_reg = lmem_rd32(static_cast<char*>(clk_base_addr) + CLKOUT_OFFSET);
-        uint32_t clkout_div = (clk_config_reg & 0x000000FF);
-        uint32_t clkout_frac = (clk_config_reg & 0x0003FF00) >> 8;
+        clk_config_reg = clk.read(CLKOUT_OFFSET);
+        uint32_t clkout_div = mmio::clk_wiz::CLKOUT0_DIV.decode(clk_config_reg);
+        uint32_t clkout_frac = mmio::clk_wiz::CLKOUT0_FRAC.decode(clk_config_reg);
         clkout_div = (1000 * clkout_div) + clkout_frac;
         
         // Get PLL settings to obtain sample rate
@@ -939,9 +1295,13 @@ void RFDC::initialize_mmcm_adc()
 }
 
 void RFDC::initialize_mmcm_dac() {
+    if (sim_) {
+        throw RFDCException("initialize_mmcm_dac is not modelled on the simulated backend; "
+                            "use clock_wizard::ClockWizard");
+    }
     // Clock wizard register offsets
-    constexpr uint32_t CLKREG_OFFSET = 0x200;
-    constexpr uint32_t CLKOUT_OFFSET = 0x208;
+    constexpr uint32_t CLKREG_OFFSET = mmio::clk_wiz::CLK_CONFIG0;
+    constexpr uint32_t CLKOUT_OFFSET = mmio::clk_wiz::CLKOUT0;
     
     uint32_t mts_enable = 0;  // Multi-tile sync (typically 0)
     
@@ -975,15 +1335,16 @@ void RFDC::initialize_mmcm_dac() {
         }
         
         // Read clock configuration registers
-        uint32_t clk_config_reg = lmem_rd32(static_cast<char*>(clk_base_addr) + CLKREG_OFFSET);
-        uint32_t mult = (clk_config_reg & 0x0000FF00) >> 8;
-        uint32_t div = (clk_config_reg & 0x000000FF);
-        uint32_t frac_mult = (clk_config_reg & 0x03FF0000) >> 16;
+        const mmio::Block clk(clk_base_addr, "clk_wiz");
+        uint32_t clk_config_reg = clk.read(CLKREG_OFFSET);
+        uint32_t mult = mmio::clk_wiz::CONFIG0_MULT.decode(clk_config_reg);
+        uint32_t div = mmio::clk_wiz::CONFIG0_DIVCLK.decode(clk_config_reg);
+        uint32_t frac_mult = mmio::clk_wiz::CONFIG0_MULT_FRAC.decode(clk_config_reg);
         mult = (1000 * mult) + frac_mult;
         
-        clk_config_reg = lmem_rd32(static_cast<char*>(clk_base_addr) + CLKOUT_OFFSET);
-        uint32_t clkout_div = (clk_config_reg & 0x000000FF);
-        uint32_t clkout_frac = (clk_config_reg & 0x0003FF00) >> 8;
+        clk_config_reg = clk.read(CLKOUT_OFFSET);
+        uint32_t clkout_div = mmio::clk_wiz::CLKOUT0_DIV.decode(clk_config_reg);
+        uint32_t clkout_frac = mmio::clk_wiz::CLKOUT0_FRAC.decode(clk_config_reg);
         clkout_div = (1000 * clkout_div) + clkout_frac;
         
         // Get PLL settings to obtain sample rate
@@ -1061,7 +1422,19 @@ void RFDC::initialize_mmcm_dac() {
 // ===== MMCM Management Operations =====
 
 bool RFDC::check_high_speed_adc(TileId tile_id) const {
-    return XRFdc_IsHighSpeedADC(const_cast<XRFdc*>(&instance_), tile_id) != 0;
+    ShadowTile* shadow = shadow_tile(TileType::ADC, tile_id);
+    if (shadow && shadow->high_speed_valid) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return shadow->high_speed;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    bool high_speed = sim_ ? sim_->check_high_speed_adc(tile_id)
+                           : XRFdc_IsHighSpeedADC(const_cast<XRFdc*>(&instance_), tile_id) != 0;
+    if (shadow) {
+        shadow->high_speed = high_speed;
+        shadow->high_speed_valid = true;
+    }
+    return high_speed;
 }
 
 void* RFDC::get_clk_wiz_base(TileType type, TileId tile_id) {
@@ -1084,7 +1457,7 @@ void RFDC::set_mmcm(TileType type, TileId tile_id)
     XRFdc_PLL_Settings pll_settings;
     auto status = XRFdc_GetPLLConfig(&instance_, to_underlying(type), 
                                      tile_id, &pll_settings);
-    check_status(status, format_string("GetPLLConfig for MMCM setup"));
+    check_status(status, "GetPLLConfig for MMCM setup");
     
     double sample_rate = pll_settings.SampleRate * 1000.0;  // Convert GSPS to MHz
     
@@ -1092,7 +1465,7 @@ void RFDC::set_mmcm(TileType type, TileId tile_id)
     uint16_t fab_clk_div = 0;
     status = XRFdc_GetFabClkOutDiv(&instance_, to_underlying(type), 
                                    tile_id, &fab_clk_div);
-    check_status(status, format_string("GetFabClkOutDiv"));
+    check_status(status, "GetFabClkOutDiv");
     
     // Find first enabled block
     uint32_t block_id = 0;
@@ -1117,18 +1490,18 @@ void RFDC::set_mmcm(TileType type, TileId tile_id)
         // Get fabric write words
         status = XRFdc_GetFabWrVldWords(&instance_, to_underlying(type),
                                        tile_id, block_id, &fabric_words);
-        check_status(status, format_string("GetFabWrVldWords"));
+        check_status(status, "GetFabWrVldWords");
         
         // Get interpolation factor
         status = XRFdc_GetInterpolationFactor(&instance_, tile_id, 
                                              block_id, &inter_decim);
-        check_status(status, format_string("GetInterpolationFactor"));
+        check_status(status, "GetInterpolationFactor");
         
         // Get mixer settings to determine Real vs IQ
         XRFdc_Mixer_Settings mixer;
         status = XRFdc_GetMixerSettings(&instance_, to_underlying(type),
                                        tile_id, block_id, &mixer);
-        check_status(status, format_string("GetMixerSettings"));
+        check_status(status, "GetMixerSettings");
         
         // Determine data type
         if (mixer.MixerMode == XRFDC_MIXER_MODE_R2R ||
@@ -1160,18 +1533,18 @@ void RFDC::set_mmcm(TileType type, TileId tile_id)
         // Get fabric read words
         status = XRFdc_GetFabRdVldWords(&instance_, to_underlying(type),
                                        tile_id, block_id, &fabric_words);
-        check_status(status, format_string("GetFabRdVldWords"));
+        check_status(status, "GetFabRdVldWords");
         
         // Get decimation factor
         status = XRFdc_GetDecimationFactor(&instance_, tile_id, 
                                           block_id, &inter_decim);
-        check_status(status, format_string("GetDecimationFactor"));
+        check_status(status, "GetDecimationFactor");
         
         // Get mixer settings
         XRFdc_Mixer_Settings mixer;
         status = XRFdc_GetMixerSettings(&instance_, to_underlying(type),
                                        tile_id, block_id, &mixer);
-        check_status(status, format_string("GetMixerSettings"));
+        check_status(status, "GetMixerSettings");
         
         // Determine data type
         if (mixer.MixerMode == XRFDC_MIXER_MODE_R2R ||
@@ -1308,6 +1681,11 @@ void RFDC::set_mmcm(TileType type, TileId tile_id)
 #endif
 void RFDC::set_mmcm(TileType type, TileId tile_id)
 {
+    if (sim_) {
+        throw RFDCException("set_mmcm is not modelled on the simulated backend; "
+                            "use clock_wizard::ClockWizard");
+    }
+
     const u32 Type    = to_underlying(type);   // must match XRFDC_ADC_TILE / XRFDC_DAC_TILE
     const u32 Tile_Id = tile_id;
 
@@ -1528,71 +1906,56 @@ int RFDC::mmcm_reprogram(TileType type, TileId tile_id,
                         uint32_t div, uint32_t clkout_div,
                         uint32_t clk0_div_frac)
 {
-    void* clk_base = get_clk_wiz_base(type, tile_id);
-    if (!clk_base) {
+    using namespace mmio::clk_wiz;
+    mmio::Operation op("rfdc.mmcm_reprogram");
+    const mmio::Block clk(get_clk_wiz_base(type, tile_id), "clk_wiz");
+    if (!clk.valid()) {
         return -1;
     }
     
-    // Clock Wizard register offsets
-    constexpr uint32_t CLKREG_OFFSET = 0x200;   // Clock config register
-    constexpr uint32_t CLKOUT_OFFSET = 0x208;   // Clock output config
-    
-    // Prepare clock config: [25:16]=frac_mult, [15:8]=mult, [7:0]=div
-    uint32_t clk_config = (frac_mult << 16) | (mult << 8) | div;
-    
-    // Prepare clkout config: [17:8]=frac, [7:0]=div
-    uint32_t clkout_config = (clk0_div_frac << 8) | clkout_div;
-    
-    // Write registers using reinterpret_cast
-    volatile uint32_t* clk_reg = reinterpret_cast<volatile uint32_t*>(
-        static_cast<char*>(clk_base) + CLKREG_OFFSET
-    );
-    volatile uint32_t* clkout_reg = reinterpret_cast<volatile uint32_t*>(
-        static_cast<char*>(clk_base) + CLKOUT_OFFSET
-    );
-    
-    *clk_reg = clk_config;
-    *clkout_reg = clkout_config;
+    // Clock config: [25:16]=frac_mult, [15:8]=mult, [7:0]=div
+    // Clkout config: [17:8]=frac, [7:0]=div
+    mmio::Batch batch;
+    batch.set(clk, CONFIG0_DIVCLK, div)
+         .set(clk, CONFIG0_MULT, mult)
+         .set(clk, CONFIG0_MULT_FRAC, frac_mult)
+         .set(clk, CLKOUT0_DIV, clkout_div)
+         .set(clk, CLKOUT0_FRAC, clk0_div_frac)
+         .apply();
     
     return 0;
 }
 
 uint16_t RFDC::mmcm_reset(TileType type, TileId tile_id)
 {
-    void* clk_base = get_clk_wiz_base(type, tile_id);
-    if (!clk_base) {
+    using namespace mmio::clk_wiz;
+    mmio::Operation op("rfdc.mmcm_reset");
+    const mmio::Block clk(get_clk_wiz_base(type, tile_id), "clk_wiz");
+    if (!clk.valid()) {
         return 0;
     }
     
-    // MMCM control register offsets
-    constexpr uint32_t MMCM_RESET_OFFSET = 0x25C;
-    constexpr uint32_t MMCM_LOCK_OFFSET = 0x004;
-    
-    // Use reinterpret_cast for pointer conversions
-    volatile uint32_t* reset_reg = reinterpret_cast<volatile uint32_t*>(
-        static_cast<char*>(clk_base) + MMCM_RESET_OFFSET
-    );
-    volatile uint32_t* lock_reg = reinterpret_cast<volatile uint32_t*>(
-        static_cast<char*>(clk_base) + MMCM_LOCK_OFFSET
-    );
-    
-    // Assert reset
-    *reset_reg = 0xA;
+    // Assert reset (RFTool drives it through the LOAD register)
+    clk.write(LOAD, RESET_KEY);
     usleep(10);
     
     // Deassert reset
-    *reset_reg = 0x0;
-    usleep(1000);  // Wait for lock
-    
-    // Read lock status
-    uint32_t lock_status = *lock_reg;
+    clk.write(LOAD, 0x0);
     
-    return (lock_status & 0x1) ? 1 : 0;
+    const auto lock = lock_wait::wait(
+        format_string("MMCM ", type == TileType::DAC ? "DAC " : "ADC ", tile_id),
+        [&] { return clk.read(STATUS_LOCKED) != 0; },
+        lock_wait::mmcm_policy());
+    return lock.locked ? 1 : 0;
 }
 
 // ===== Fabric Interface Operations =====
 
 void RFDC::get_fab_rd_vld_words(TileType type, TileId tile_id, BlockId block_id, uint32_t& words) const {
+    if (sim_) {
+        words = sim_->get_fab_rd_vld_words(type, tile_id, block_id);
+        return;
+    }
     uint32_t status = XRFdc_GetFabRdVldWords(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
@@ -1604,6 +1967,10 @@ void RFDC::get_fab_rd_vld_words(TileType type, TileId tile_id, BlockId block_id,
 }
 
 void RFDC::get_fab_wr_vld_words(TileType type, TileId tile_id, BlockId block_id, uint32_t& words) const {
+    if (sim_) {
+        words = sim_->get_fab_wr_vld_words(type, tile_id, block_id);
+        return;
+    }
     uint32_t status = XRFdc_GetFabWrVldWords(
         const_cast<XRFdc*>(&instance_),
         to_underlying(type),
@@ -17,6 +17,7 @@
 #include <string>
 #include <memory>
 #include <array>
+#include <atomic>
 #include <cmath>
 namespace rfdc {
 
@@ -281,11 +282,35 @@ public:
         return status_.ADCTileStatus[tile].IsEnabled != 0;
     }
 
+    // Power-up sequence state; TILE_STATE_STARTED once startup completed
+    static constexpr uint32_t TILE_STATE_STARTED = 15;
+
+    uint32_t tile_state(TileType type, TileId tile) const {
+        if (tile > 3) throw RFDCException("Invalid tile ID");
+        return type == TileType::ADC ? status_.ADCTileStatus[tile].TileState
+                                     : status_.DACTileStatus[tile].TileState;
+    }
+
+    bool tile_started(TileType type, TileId tile) const {
+        return tile_state(type, tile) == TILE_STATE_STARTED;
+    }
+
 private:
     XRFdc_IPStatus status_{};
 };
 
 
+class SimRfdc;
+
+// Value from a non-throwing getter; `value` is only meaningful when ok()
+template<typename T>
+struct Result {
+    uint32_t status = XRFDC_FAILURE;
+    T value{};
+    
+    bool ok() const { return status == XRFDC_SUCCESS; }
+};
+
 // Main RFDC wrapper class
 class RFDC {
 public:
@@ -299,9 +324,9 @@ public:
     RFDC(const RFDC&) = delete;
     RFDC& operator=(const RFDC&) = delete;
     
-    // Enable move
-    RFDC(RFDC&&) noexcept = default;
-    RFDC& operator=(RFDC&&) noexcept = default;
+    // Disable move: the atomic cache counters are not movable (hold it by unique_ptr)
+    RFDC(RFDC&&) = delete;
+    RFDC& operator=(RFDC&&) = delete;
     
     // ===== Startup/Shutdown Operations =====
     void startup(TileType type, TileId tile_id);
@@ -318,6 +343,8 @@ public:
     void set_pll_config(TileType type, TileId tile_id, rfdc::ClockSource source, double ref_clk_freq, double sample_rate);
     PLLSettings get_pll_config(TileType type, TileId tile_id) const;
     bool get_pll_lock_status(TileType type, TileId tile_id) const;
+    // Non-throwing, for polling loops: failures come back as the driver status
+    Result<bool> try_get_pll_lock_status(TileType type, TileId tile_id) const noexcept;
     
     // ===== Mixer Operations =====
     void set_mixer_settings(TileType type, TileId tile_id, BlockId block_id, 
@@ -343,6 +370,7 @@ public:
     // ===== FIFO Operations =====
     void setup_fifo(TileType type, TileId tile_id, bool enable);
     bool get_fifo_status(TileType type, TileId tile_id) const;
+    Result<bool> try_get_fifo_status(TileType type, TileId tile_id) const noexcept;
     
     // ===== Fabric Clock Operations =====
     void set_fabric_clk_out_div(TileType type, TileId tile_id, uint16_t div);
@@ -367,9 +395,17 @@ public:
     void disable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask);
     void clear_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask);
     uint32_t get_interrupt_status(TileType type, TileId tile_id, BlockId block_id) const;
+    Result<uint32_t> try_get_interrupt_status(TileType type, TileId tile_id,
+                                              BlockId block_id) const noexcept;
     
     // ===== Multi-Tile Sync Operations =====
+    // Driver defaults (all tiles, no target latency) with `ref_tile` as reference
+    void multi_converter_init(XRFdc_MultiConverter_Sync_Config* config, TileId ref_tile);
+    // Returns the XRFDC_MTS_* status mask; Latency/Offset are filled in on success
     uint32_t multi_converter_sync(TileType type, XRFdc_MultiConverter_Sync_Config* config);
+    // Gate SYSREF on or off for the tiles of both configs
+    void mts_sysref_config(XRFdc_MultiConverter_Sync_Config* dac_config,
+                           XRFdc_MultiConverter_Sync_Config* adc_config, bool enable);
     
     // ===== Update Event =====
     void update_event(TileType type, TileId tile_id, BlockId block_id, uint32_t event);
@@ -381,6 +417,34 @@ public:
     XRFdc* get_instance() { return &instance_; }
     const XRFdc* get_instance() const { return &instance_; }
     uint32_t get_ip_type() const { return instance_.RFdc_Config.IPType; }
+    // True when running on the simulated backend (no driver underneath)
+    bool simulated() const { return sim_ != nullptr; }
+    // Converter model (fault injection); nullptr on hardware
+    SimRfdc* simulator() { return sim_.get(); }
+    // Bumped whenever the mixer setup or channel maps change; lets callers
+    // cache data that is derived from them
+    uint64_t config_generation() const { return config_generation_; }
+
+    // ===== Configuration Cache =====
+    // get_mixer_settings, get_pll_config, get_decimation_factor,
+    // get_interpolation_factor and check_high_speed_adc answer from a
+    // per-tile/per-block shadow filled on first read. The matching setters
+    // drop their entries; startup, shutdown, reset and set_pll_config drop
+    // the whole tile. Changes made behind the wrapper (get_instance(),
+    // another process) are only seen after a resync.
+    struct CacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    // Drop the shadow and re-read every enabled block from the hardware
+    void resync_config();
+    void resync_config(TileType type, TileId tile_id);
+    CacheStats config_cache_stats() const {
+        CacheStats stats;
+        stats.hits = cache_hits_.load(std::memory_order_relaxed);
+        stats.misses = cache_misses_.load(std::memory_order_relaxed);
+        return stats;
+    }
     // ===== Memory Mapping Operations =====
     // Initialize memory mapping for ADC/DAC data buffers and clock wizards
     void initialize_memory_mapping(
@@ -464,10 +528,11 @@ private:
     XRFdc instance_{};
     std::unique_ptr<XRFdc_Config> config_;
     struct metal_device* metal_device_{nullptr};
+    // Converter model used instead of the driver on the simulated backend
+    std::unique_ptr<SimRfdc> sim_;
     
     // Memory mapping for ADC/DAC data and clock wizards
     struct MemoryInfo {
-        int fd;                    // /dev/mem file descriptor
         void* base_adc;           // ADC mmap base
         void* base_dac;           // DAC mmap base
         void* vaddr_adc;          // ADC virtual address
@@ -479,7 +544,7 @@ private:
         void* clk_wiz_adc[4];     // ADC clock wizards
         void* clk_wiz_dac[4];     // DAC clock wizards
         
-        MemoryInfo() : fd(-1), base_adc(nullptr), base_dac(nullptr),
+        MemoryInfo() : base_adc(nullptr), base_dac(nullptr),
                        vaddr_adc(nullptr), vaddr_dac(nullptr),
                        paddr_adc(0), paddr_dac(0) {
             for (int i = 0; i < 4; ++i) {
@@ -495,18 +560,39 @@ private:
     std::array<uint32_t, 16> adc_mem_map_;
     std::array<uint32_t, 16> dac_mem_map_;
     std::array<uint32_t, 16> adc_init_datatype_;
+    uint64_t config_generation_ = 0;
+    // Configuration shadow, filled by the const getters
+    struct ShadowBlock {
+        bool mixer_valid = false;
+        bool factor_valid = false;      // Decimation (ADC) or interpolation (DAC)
+        MixerSettings mixer;
+        uint32_t factor = 0;
+    };
+    struct ShadowTile {
+        bool pll_valid = false;
+        bool high_speed_valid = false;  // ADC only
+        bool high_speed = false;
+        PLLSettings pll;
+        std::array<ShadowBlock, 4> blocks;
+    };
+    mutable std::array<ShadowTile, 4> adc_shadow_;
+    mutable std::array<ShadowTile, 4> dac_shadow_;
+    // Counted from any thread (tiles are brought up concurrently)
+    mutable std::atomic<uint64_t> cache_hits_{0};
+    mutable std::atomic<uint64_t> cache_misses_{0};
     // MMCM input frequencies [0-3: ADC tiles, 4-7: DAC tiles]
     std::array<uint32_t, 8> mmcm_fin_;
     // Helper functions
-    void check_status(uint32_t status, const std::string& operation) const {
+    // `operation` is streamed into the message only on failure: a check on
+    // a successful call is a single compare, with no string built
+    template<typename... Args>
+    void check_status(uint32_t status, const Args&... operation) const {
         if (status != XRFDC_SUCCESS) {
-            throw RFDCException(
-                operation + " failed with status: " + 
-                std::to_string(status), 
-                status
-            );
+            throw_status(status, operation...);
         }
     }
+    template<typename... Args>
+    [[noreturn]] static void throw_status(uint32_t status, const Args&... operation);
     
     static constexpr uint32_t to_underlying(TileType type) {
         return static_cast<uint32_t>(type);
@@ -515,6 +601,11 @@ private:
     // Memory mapping helpers
     void cleanup_memory_mapping();
     void build_channel_maps();
+    // Configuration shadow helpers (nullptr for out-of-range ids)
+    ShadowTile* shadow_tile(TileType type, TileId tile_id) const;
+    ShadowBlock* shadow_block(TileType type, TileId tile_id, BlockId block_id) const;
+    void invalidate_tile(TileType type, TileId tile_id);
+    void invalidate_block(TileType type, TileId tile_id, BlockId block_id);
     // MMCM programming helpers
     int mmcm_reprogram(TileType type, TileId tile_id,
                       uint32_t mult, uint32_t frac_mult, uint32_t div,
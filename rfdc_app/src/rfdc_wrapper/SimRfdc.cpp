@@ -0,0 +1,478 @@
+/******************************************************************************
+* Copyright (C) 2024 Charlie
+* In-memory RF Data Converter model for the simulated hardware backend
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+#include "SimRfdc.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace rfdc {
+
+constexpr uint32_t SimRfdc::NUM_TILES;
+constexpr uint32_t SimRfdc::NUM_BLOCKS;
+constexpr std::chrono::milliseconds SimRfdc::PLL_LOCK_TIME;
+constexpr int SimRfdc::MTS_BASE_LATENCY;
+
+namespace {
+
+constexpr double SIM_REF_CLK_MHZ = 245.76;
+constexpr double SIM_ADC_RATE_GSPS = 2.4576;
+constexpr double SIM_DAC_RATE_GSPS = 6.5536;
+constexpr uint32_t SIM_OUTPUT_DIV = 2;
+
+void set_rate(XRFdc_PLL_Settings& pll, double ref_clk_mhz, double rate_gsps)
+{
+    pll.RefClkFreq = ref_clk_mhz;
+    pll.SampleRate = rate_gsps;
+    pll.RefClkDivider = 1;
+    pll.OutputDivider = SIM_OUTPUT_DIV;
+    pll.FeedbackDivider = static_cast<uint32_t>(
+        std::lround(1000.0 * rate_gsps * SIM_OUTPUT_DIV / ref_clk_mhz));
+}
+
+} // namespace
+
+SimRfdc::SimRfdc()
+{
+    for (uint32_t t = 0; t < NUM_TILES; ++t) {
+        adc_[t].pll.Enabled = 1;
+        set_rate(adc_[t].pll, SIM_REF_CLK_MHZ, SIM_ADC_RATE_GSPS);
+        dac_[t].pll.Enabled = 1;
+        set_rate(dac_[t].pll, SIM_REF_CLK_MHZ, SIM_DAC_RATE_GSPS);
+
+        for (uint32_t b = 0; b < NUM_BLOCKS; ++b) {
+            adc_[t].blocks[b].factor = 8;
+            adc_[t].blocks[b].mixer.MixerType = XRFDC_MIXER_TYPE_COARSE;
+            adc_[t].blocks[b].mixer.MixerMode = XRFDC_MIXER_MODE_R2C;
+
+            dac_[t].blocks[b].factor = 8;
+            dac_[t].blocks[b].datapath_mode = XRFDC_DATAPATH_MODE_DUC_0_FSDIVTWO;
+            dac_[t].blocks[b].mixer.MixerType = XRFDC_MIXER_TYPE_COARSE;
+            dac_[t].blocks[b].mixer.MixerMode = XRFDC_MIXER_MODE_C2R;
+        }
+    }
+}
+
+void SimRfdc::fill_instance(XRFdc& instance) const
+{
+    instance.RFdc_Config.IPType = XRFDC_GEN3;
+    instance.ADC4GSPS = 0;
+    for (uint32_t t = 0; t < NUM_TILES; ++t) {
+        instance.RFdc_Config.ADCTile_Config[t].NumSlices = NUM_BLOCKS;
+        for (uint32_t b = 0; b < NUM_BLOCKS; ++b) {
+            instance.RFdc_Config.ADCTile_Config[t].ADCBlock_Digital_Config[b].DecimationMode =
+                adc_[t].blocks[b].factor;
+        }
+    }
+}
+
+SimRfdc::Tile& SimRfdc::tile(TileType type, TileId tile_id)
+{
+    return const_cast<Tile&>(static_cast<const SimRfdc*>(this)->tile(type, tile_id));
+}
+
+const SimRfdc::Tile& SimRfdc::tile(TileType type, TileId tile_id) const
+{
+    if (tile_id >= NUM_TILES) {
+        throw RFDCException("Simulated RFDC: invalid tile " + std::to_string(tile_id));
+    }
+    return type == TileType::ADC ? adc_[tile_id] : dac_[tile_id];
+}
+
+SimRfdc::Block& SimRfdc::block(TileType type, TileId tile_id, BlockId block_id)
+{
+    return const_cast<Block&>(static_cast<const SimRfdc*>(this)->block(type, tile_id, block_id));
+}
+
+const SimRfdc::Block& SimRfdc::block(TileType type, TileId tile_id, BlockId block_id) const
+{
+    if (block_id >= NUM_BLOCKS) {
+        throw RFDCException("Simulated RFDC: invalid block " + std::to_string(block_id) +
+                            " on tile " + std::to_string(tile_id));
+    }
+    return tile(type, tile_id).blocks[block_id];
+}
+
+// ===== Startup/Shutdown Operations =====
+
+void SimRfdc::startup(TileType type, TileId tile_id)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    Tile& t = tile(type, tile_id);
+    t.started = true;
+    t.pll_lock_at = std::chrono::steady_clock::now() + PLL_LOCK_TIME;
+}
+
+void SimRfdc::shutdown(TileType type, TileId tile_id)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    tile(type, tile_id).started = false;
+}
+
+void SimRfdc::reset(TileType type, TileId tile_id)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    // Reset restarts the tile with its current settings
+    Tile& t = tile(type, tile_id);
+    t.started = true;
+    t.pll_lock_at = std::chrono::steady_clock::now() + PLL_LOCK_TIME;
+}
+
+// ===== Status Operations =====
+
+IPStatus SimRfdc::get_ip_status() const
+{
+    XRFdc_IPStatus st{};
+    for (uint32_t t = 0; t < NUM_TILES; ++t) {
+        const Tile* tiles[2] = { &adc_[t], &dac_[t] };
+        XRFdc_TileStatus* out[2] = { &st.ADCTileStatus[t], &st.DACTileStatus[t] };
+        for (int i = 0; i < 2; ++i) {
+            out[i]->IsEnabled = tiles[i]->enabled ? 1 : 0;
+            out[i]->TileState = tiles[i]->started ? 15 : 0;
+            out[i]->BlockStatusMask = 0xF;
+            out[i]->PowerUpState = tiles[i]->started ? 1 : 0;
+            out[i]->PLLState = tiles[i]->started ? 1 : 0;
+        }
+    }
+    st.State = 1;
+    return IPStatus{st};
+}
+
+BlockStatus SimRfdc::get_block_status(TileType type, TileId tile_id, BlockId block_id) const
+{
+    const Tile& t = tile(type, tile_id);
+    const Block& b = block(type, tile_id, block_id);
+
+    BlockStatus status;
+    XRFdc_BlockStatus* st = status.get();
+    st->SamplingFreq = t.pll.SampleRate;
+    st->AnalogDataPathStatus = (t.started && b.enabled) ? 1 : 0;
+    st->DigitalDataPathStatus = (t.started && b.enabled) ? 1 : 0;
+    st->DataPathClocksStatus = t.started ? 1 : 0;
+    st->IsFIFOFlagsEnabled = t.fifo ? 1 : 0;
+    st->IsFIFOFlagsAsserted = 0;
+    return status;
+}
+
+bool SimRfdc::check_tile_enabled(TileType type, TileId tile_id) const
+{
+    return tile_id < NUM_TILES && tile(type, tile_id).enabled;
+}
+
+bool SimRfdc::check_block_enabled(TileType type, TileId tile_id, BlockId block_id) const
+{
+    return tile_id < NUM_TILES && block_id < NUM_BLOCKS &&
+           block(type, tile_id, block_id).enabled;
+}
+
+bool SimRfdc::check_high_speed_adc(TileId) const
+{
+    return false;
+}
+
+bool SimRfdc::is_iq_data(TileType type, TileId tile_id, BlockId block_id) const
+{
+    const uint32_t mode = block(type, tile_id, block_id).mixer.MixerMode;
+    if (type == TileType::ADC) {
+        return mode == XRFDC_MIXER_MODE_R2C || mode == XRFDC_MIXER_MODE_C2C;
+    }
+    return mode == XRFDC_MIXER_MODE_C2R || mode == XRFDC_MIXER_MODE_C2C;
+}
+
+// ===== PLL Operations =====
+
+void SimRfdc::set_pll_config(TileType type, TileId tile_id, ClockSource source,
+                             double ref_clk_freq, double sample_rate)
+{
+    if (ref_clk_freq <= 0.0 || sample_rate <= 0.0) {
+        throw RFDCException("Simulated RFDC: invalid PLL frequencies");
+    }
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    Tile& t = tile(type, tile_id);
+    t.pll.Enabled = (source == ClockSource::Internal) ? 1 : 0;
+    set_rate(t.pll, ref_clk_freq, sample_rate / 1000.0);   // MHz in, GSPS stored
+    t.pll_lock_at = std::chrono::steady_clock::now() + PLL_LOCK_TIME;
+}
+
+PLLSettings SimRfdc::get_pll_config(TileType type, TileId tile_id) const
+{
+    PLLSettings settings;
+    *settings.get() = tile(type, tile_id).pll;
+    return settings;
+}
+
+bool SimRfdc::get_pll_lock_status(TileType type, TileId tile_id) const
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    const Tile& t = tile(type, tile_id);
+    return t.started && std::chrono::steady_clock::now() >= t.pll_lock_at;
+}
+
+// ===== Mixer / QMC / Nyquist =====
+
+void SimRfdc::set_mixer_settings(TileType type, TileId tile_id, BlockId block_id,
+                                 const MixerSettings& settings)
+{
+    block(type, tile_id, block_id).mixer = *settings.get();
+}
+
+MixerSettings SimRfdc::get_mixer_settings(TileType type, TileId tile_id, BlockId block_id) const
+{
+    MixerSettings settings;
+    *settings.get() = block(type, tile_id, block_id).mixer;
+    return settings;
+}
+
+void SimRfdc::reset_nco_phase(TileType type, TileId tile_id, BlockId block_id)
+{
+    block(type, tile_id, block_id);
+}
+
+void SimRfdc::set_qmc_settings(TileType type, TileId tile_id, BlockId block_id,
+                               const QMCSettings& settings)
+{
+    block(type, tile_id, block_id).qmc = *settings.get();
+}
+
+QMCSettings SimRfdc::get_qmc_settings(TileType type, TileId tile_id, BlockId block_id) const
+{
+    QMCSettings settings;
+    *settings.get() = block(type, tile_id, block_id).qmc;
+    return settings;
+}
+
+void SimRfdc::set_nyquist_zone(TileType type, TileId tile_id, BlockId block_id, NyquistZone zone)
+{
+    block(type, tile_id, block_id).nyquist_zone = static_cast<uint32_t>(zone);
+}
+
+NyquistZone SimRfdc::get_nyquist_zone(TileType type, TileId tile_id, BlockId block_id) const
+{
+    return static_cast<NyquistZone>(block(type, tile_id, block_id).nyquist_zone);
+}
+
+// ===== Interpolation/Decimation Operations =====
+
+void SimRfdc::set_interpolation_factor(TileId tile_id, BlockId block_id, uint32_t factor)
+{
+    if (factor == 0) {
+        throw RFDCException("Simulated RFDC: invalid interpolation factor");
+    }
+    block(TileType::DAC, tile_id, block_id).factor = factor;
+}
+
+uint32_t SimRfdc::get_interpolation_factor(TileId tile_id, BlockId block_id) const
+{
+    return block(TileType::DAC, tile_id, block_id).factor;
+}
+
+void SimRfdc::set_decimation_factor(TileId tile_id, BlockId block_id, uint32_t factor)
+{
+    if (factor == 0) {
+        throw RFDCException("Simulated RFDC: invalid decimation factor");
+    }
+    block(TileType::ADC, tile_id, block_id).factor = factor;
+}
+
+uint32_t SimRfdc::get_decimation_factor(TileId tile_id, BlockId block_id) const
+{
+    return block(TileType::ADC, tile_id, block_id).factor;
+}
+
+// ===== Datapath / IMR (DAC) =====
+
+void SimRfdc::set_datapath_mode(TileId tile_id, BlockId block_id, uint32_t mode)
+{
+    block(TileType::DAC, tile_id, block_id).datapath_mode = mode;
+}
+
+uint32_t SimRfdc::get_datapath_mode(TileId tile_id, BlockId block_id) const
+{
+    return block(TileType::DAC, tile_id, block_id).datapath_mode;
+}
+
+void SimRfdc::set_imr_pass_mode(TileId tile_id, BlockId block_id, uint32_t mode)
+{
+    block(TileType::DAC, tile_id, block_id).imr_mode = mode;
+}
+
+uint32_t SimRfdc::get_imr_pass_mode(TileId tile_id, BlockId block_id) const
+{
+    return block(TileType::DAC, tile_id, block_id).imr_mode;
+}
+
+// ===== FIFO and Fabric Clock Operations =====
+
+void SimRfdc::setup_fifo(TileType type, TileId tile_id, bool enable)
+{
+    tile(type, tile_id).fifo = enable;
+}
+
+bool SimRfdc::get_fifo_status(TileType type, TileId tile_id) const
+{
+    return tile(type, tile_id).fifo;
+}
+
+void SimRfdc::set_fabric_clk_out_div(TileType type, TileId tile_id, uint16_t div)
+{
+    if (div < 1 || div > 5) {
+        throw RFDCException("Simulated RFDC: invalid fabric clock divider");
+    }
+    tile(type, tile_id).fab_clk_div = div;
+}
+
+uint16_t SimRfdc::get_fabric_clk_out_div(TileType type, TileId tile_id) const
+{
+    return tile(type, tile_id).fab_clk_div;
+}
+
+double SimRfdc::get_fabric_clk_freq(TileType type, TileId tile_id) const
+{
+    // Clock that moves fab_words samples (I/Q pairs count twice) per cycle
+    const Tile& t = tile(type, tile_id);
+    const uint32_t lanes = is_iq_data(type, tile_id, 0) ? 2 : 1;
+    return 1000.0 * t.pll.SampleRate * lanes / (t.blocks[0].factor * t.fab_words);
+}
+
+uint32_t SimRfdc::get_fab_rd_vld_words(TileType type, TileId tile_id, BlockId block_id) const
+{
+    block(type, tile_id, block_id);
+    return tile(type, tile_id).fab_words;
+}
+
+uint32_t SimRfdc::get_fab_wr_vld_words(TileType type, TileId tile_id, BlockId block_id) const
+{
+    block(type, tile_id, block_id);
+    return tile(type, tile_id).fab_words;
+}
+
+// ===== ADC-Specific Operations =====
+
+void SimRfdc::set_threshold_settings(TileId tile_id, BlockId block_id,
+                                     const ThresholdSettings& settings)
+{
+    block(TileType::ADC, tile_id, block_id).threshold = *settings.get();
+}
+
+ThresholdSettings SimRfdc::get_threshold_settings(TileId tile_id, BlockId block_id) const
+{
+    ThresholdSettings settings;
+    *settings.get() = block(TileType::ADC, tile_id, block_id).threshold;
+    return settings;
+}
+
+void SimRfdc::set_calibration_mode(TileId tile_id, BlockId block_id, CalibrationMode mode)
+{
+    block(TileType::ADC, tile_id, block_id).calibration_mode = static_cast<uint8_t>(mode);
+}
+
+CalibrationMode SimRfdc::get_calibration_mode(TileId tile_id, BlockId block_id) const
+{
+    return static_cast<CalibrationMode>(block(TileType::ADC, tile_id, block_id).calibration_mode);
+}
+
+// ===== DAC-Specific Operations =====
+
+void SimRfdc::set_decoder_mode(TileId tile_id, BlockId block_id, uint32_t mode)
+{
+    block(TileType::DAC, tile_id, block_id).decoder_mode = mode;
+}
+
+uint32_t SimRfdc::get_decoder_mode(TileId tile_id, BlockId block_id) const
+{
+    return block(TileType::DAC, tile_id, block_id).decoder_mode;
+}
+
+void SimRfdc::set_inverse_sinc_filter(TileId tile_id, BlockId block_id, uint16_t mode)
+{
+    block(TileType::DAC, tile_id, block_id).inv_sinc = mode;
+}
+
+uint16_t SimRfdc::get_inverse_sinc_filter(TileId tile_id, BlockId block_id) const
+{
+    return block(TileType::DAC, tile_id, block_id).inv_sinc;
+}
+
+// ===== Interrupt Operations =====
+
+void SimRfdc::enable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    block(type, tile_id, block_id).intr_mask |= mask;
+}
+
+void SimRfdc::disable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    block(type, tile_id, block_id).intr_mask &= ~mask;
+}
+
+void SimRfdc::clear_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    block(type, tile_id, block_id).intr_status &= ~mask;
+}
+
+uint32_t SimRfdc::get_interrupt_status(TileType type, TileId tile_id, BlockId block_id) const
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return block(type, tile_id, block_id).intr_status;
+}
+
+void SimRfdc::raise_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    block(type, tile_id, block_id).intr_status |= mask;
+}
+
+// ===== Multi-Tile Sync =====
+
+void SimRfdc::multi_converter_init(XRFdc_MultiConverter_Sync_Config* config, TileId ref_tile) const
+{
+    *config = XRFdc_MultiConverter_Sync_Config{};
+    config->RefTile = ref_tile;
+    config->Target_Latency = -1;
+    config->Marker_Delay = 15;
+    config->SysRef_Enable = 1;
+}
+
+uint32_t SimRfdc::multi_converter_sync(TileType type, XRFdc_MultiConverter_Sync_Config* config) const
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (config->RefTile >= NUM_TILES || !(config->Tiles & (1u << config->RefTile))) {
+        return XRFDC_MTS_BAD_REF_TILE;
+    }
+    const int step = (type == TileType::ADC) ? 3 : 5;
+    int slowest = 0;
+    for (uint32_t i = 0; i < NUM_TILES; ++i) {
+        if (!(config->Tiles & (1u << i))) {
+            continue;
+        }
+        if (!tile(type, i).started) {
+            return XRFDC_MTS_IP_NOT_READY;
+        }
+        slowest = std::max(slowest, MTS_BASE_LATENCY + step * static_cast<int>(i));
+    }
+    const int target = (config->Target_Latency >= 0) ? config->Target_Latency : slowest;
+    if (target < slowest) {
+        return XRFDC_MTS_TARGET_LOW;
+    }
+    for (uint32_t i = 0; i < NUM_TILES; ++i) {
+        if (config->Tiles & (1u << i)) {
+            config->Latency[i] = target;
+            config->Offset[i] = target - (MTS_BASE_LATENCY + step * static_cast<int>(i));
+        }
+    }
+    return XRFDC_MTS_OK;
+}
+
+// ===== Events =====
+
+void SimRfdc::update_event(TileType type, TileId tile_id, BlockId block_id, uint32_t)
+{
+    block(type, tile_id, block_id);
+}
+
+} // namespace rfdc
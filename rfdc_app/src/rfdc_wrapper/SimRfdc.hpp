@@ -0,0 +1,176 @@
+/******************************************************************************
+* Copyright (C) 2024 Charlie
+* In-memory RF Data Converter model for the simulated hardware backend
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+#pragma once
+
+#include "RfDc.hpp"
+#include <array>
+#include <chrono>
+#include <mutex>
+
+namespace rfdc {
+
+/**
+ * @brief Converter model behind RFDC when the simulated backend is active
+ *
+ * Mirrors the RFDC operations with plain per-tile/per-block state: every
+ * setter is remembered and read back by the matching getter, tiles start
+ * at once and lock their PLL PLL_LOCK_TIME after a startup or PLL change,
+ * and status queries report a healthy device.
+ * The topology is a ZCU216: 4 ADC tiles of 4 (non high-speed) blocks and
+ * 4 DAC tiles of 4 blocks, Gen3 IP, every block enabled.
+ *
+ * Nothing here touches the XRFdc driver; its structs are only used as the
+ * settings containers the wrapper already hands around.
+ */
+class SimRfdc {
+public:
+    static constexpr uint32_t NUM_TILES = 4;
+    static constexpr uint32_t NUM_BLOCKS = 4;
+    // Roughly what a ZCU216 tile PLL takes to lock
+    static constexpr std::chrono::milliseconds PLL_LOCK_TIME{20};
+    static constexpr int MTS_BASE_LATENCY = 64;     // Tile 0; tile n adds 3n (ADC) or 5n (DAC)
+
+    SimRfdc();
+
+    /**
+     * @brief Fill the driver instance with the simulated configuration
+     *
+     * RFDC code that reads instance fields (IP type, slices per tile,
+     * decimation mode) then sees the same topology as the model.
+     */
+    void fill_instance(XRFdc& instance) const;
+
+    // ===== Startup/Shutdown Operations =====
+    void startup(TileType type, TileId tile_id);
+    void shutdown(TileType type, TileId tile_id);
+    void reset(TileType type, TileId tile_id);
+
+    // ===== Status Operations =====
+    IPStatus get_ip_status() const;
+    BlockStatus get_block_status(TileType type, TileId tile_id, BlockId block_id) const;
+    bool check_tile_enabled(TileType type, TileId tile_id) const;
+    bool check_block_enabled(TileType type, TileId tile_id, BlockId block_id) const;
+    bool check_high_speed_adc(TileId tile_id) const;
+    bool is_iq_data(TileType type, TileId tile_id, BlockId block_id) const;
+
+    // ===== PLL Operations =====
+    void set_pll_config(TileType type, TileId tile_id, ClockSource source,
+                        double ref_clk_freq, double sample_rate);
+    PLLSettings get_pll_config(TileType type, TileId tile_id) const;
+    bool get_pll_lock_status(TileType type, TileId tile_id) const;
+
+    // ===== Mixer / QMC / Nyquist =====
+    void set_mixer_settings(TileType type, TileId tile_id, BlockId block_id,
+                            const MixerSettings& settings);
+    MixerSettings get_mixer_settings(TileType type, TileId tile_id, BlockId block_id) const;
+    void reset_nco_phase(TileType type, TileId tile_id, BlockId block_id);
+    void set_qmc_settings(TileType type, TileId tile_id, BlockId block_id,
+                          const QMCSettings& settings);
+    QMCSettings get_qmc_settings(TileType type, TileId tile_id, BlockId block_id) const;
+    void set_nyquist_zone(TileType type, TileId tile_id, BlockId block_id, NyquistZone zone);
+    NyquistZone get_nyquist_zone(TileType type, TileId tile_id, BlockId block_id) const;
+
+    // ===== Interpolation/Decimation Operations =====
+    void set_interpolation_factor(TileId tile_id, BlockId block_id, uint32_t factor);
+    uint32_t get_interpolation_factor(TileId tile_id, BlockId block_id) const;
+    void set_decimation_factor(TileId tile_id, BlockId block_id, uint32_t factor);
+    uint32_t get_decimation_factor(TileId tile_id, BlockId block_id) const;
+
+    // ===== Datapath / IMR (DAC) =====
+    void set_datapath_mode(TileId tile_id, BlockId block_id, uint32_t mode);
+    uint32_t get_datapath_mode(TileId tile_id, BlockId block_id) const;
+    void set_imr_pass_mode(TileId tile_id, BlockId block_id, uint32_t mode);
+    uint32_t get_imr_pass_mode(TileId tile_id, BlockId block_id) const;
+
+    // ===== FIFO and Fabric Clock Operations =====
+    void setup_fifo(TileType type, TileId tile_id, bool enable);
+    bool get_fifo_status(TileType type, TileId tile_id) const;
+    void set_fabric_clk_out_div(TileType type, TileId tile_id, uint16_t div);
+    uint16_t get_fabric_clk_out_div(TileType type, TileId tile_id) const;
+    double get_fabric_clk_freq(TileType type, TileId tile_id) const;
+    uint32_t get_fab_rd_vld_words(TileType type, TileId tile_id, BlockId block_id) const;
+    uint32_t get_fab_wr_vld_words(TileType type, TileId tile_id, BlockId block_id) const;
+
+    // ===== ADC-Specific Operations =====
+    void set_threshold_settings(TileId tile_id, BlockId block_id,
+                                const ThresholdSettings& settings);
+    ThresholdSettings get_threshold_settings(TileId tile_id, BlockId block_id) const;
+    void set_calibration_mode(TileId tile_id, BlockId block_id, CalibrationMode mode);
+    CalibrationMode get_calibration_mode(TileId tile_id, BlockId block_id) const;
+
+    // ===== DAC-Specific Operations =====
+    void set_decoder_mode(TileId tile_id, BlockId block_id, uint32_t mode);
+    uint32_t get_decoder_mode(TileId tile_id, BlockId block_id) const;
+    void set_inverse_sinc_filter(TileId tile_id, BlockId block_id, uint16_t mode);
+    uint16_t get_inverse_sinc_filter(TileId tile_id, BlockId block_id) const;
+
+    // ===== Interrupt Operations =====
+    void enable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask);
+    void disable_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask);
+    void clear_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask);
+    uint32_t get_interrupt_status(TileType type, TileId tile_id, BlockId block_id) const;
+
+    /**
+     * @brief Latch interrupt status bits (fault injection)
+     */
+    void raise_interrupts(TileType type, TileId tile_id, BlockId block_id, uint32_t mask);
+
+    // ===== Multi-Tile Sync =====
+    void multi_converter_init(XRFdc_MultiConverter_Sync_Config* config, TileId ref_tile) const;
+
+    /**
+     * @brief Align the selected started tiles
+     *
+     * Each tile has a fixed raw latency (see MTS_BASE_LATENCY); every tile
+     * is delayed to the target, or to the slowest tile when no target is
+     * set, and the added delay is reported as its offset.
+     */
+    uint32_t multi_converter_sync(TileType type, XRFdc_MultiConverter_Sync_Config* config) const;
+
+    // ===== Events =====
+    void update_event(TileType type, TileId tile_id, BlockId block_id, uint32_t event);
+
+private:
+    struct Block {
+        bool enabled = true;
+        XRFdc_Mixer_Settings mixer{};
+        XRFdc_QMC_Settings qmc{};
+        XRFdc_Threshold_Settings threshold{};
+        uint32_t nyquist_zone = 1;
+        uint32_t factor = 1;            // Decimation (ADC) or interpolation (DAC)
+        uint32_t datapath_mode = 1;
+        uint32_t imr_mode = 0;
+        uint8_t calibration_mode = 2;
+        uint32_t decoder_mode = 0;
+        uint16_t inv_sinc = 0;
+        uint32_t intr_mask = 0;
+        uint32_t intr_status = 0;
+    };
+
+    struct Tile {
+        bool enabled = true;
+        bool started = false;
+        std::chrono::steady_clock::time_point pll_lock_at{};
+        bool fifo = false;
+        XRFdc_PLL_Settings pll{};
+        uint16_t fab_clk_div = 2;
+        uint32_t fab_words = 8;         // Fabric words per clock
+        std::array<Block, NUM_BLOCKS> blocks;
+    };
+
+    std::array<Tile, NUM_TILES> adc_;
+    std::array<Tile, NUM_TILES> dac_;
+    // Tile start/PLL state and interrupt bits: read by the RFDC monitor thread
+    mutable std::mutex state_mutex_;
+
+    Tile& tile(TileType type, TileId tile_id);
+    const Tile& tile(TileType type, TileId tile_id) const;
+    Block& block(TileType type, TileId tile_id, BlockId block_id);
+    const Block& block(TileType type, TileId tile_id, BlockId block_id) const;
+};
+
+} // namespace rfdc